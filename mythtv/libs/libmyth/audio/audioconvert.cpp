@@ -31,9 +31,20 @@
 
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 #include "libswresample/swresample.h"
 }
 
+#if ARCH_X86 && HAVE_AVX2 && defined(__GNUC__)
+#define AVX2_KERNELS 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+#if HAVE_INTRINSICS_NEON
+#include <arm_neon.h>
+#endif
+
 #define LOC QString("AudioConvert: ")
 
 #define ISALIGN(x) (((unsigned long)(x) & 0xf) == 0)
@@ -69,6 +80,22 @@ static inline bool sse_check()
 }
 #endif //ARCH_x86
 
+#if AVX2_KERNELS
+static inline bool avx2_check()
+{
+    static const bool s_avx2 = (av_get_cpu_flags() & AV_CPU_FLAG_AVX2) != 0;
+    return s_avx2;
+}
+#endif
+
+#if HAVE_INTRINSICS_NEON
+static inline bool neon_check()
+{
+    static const bool s_neon = (av_get_cpu_flags() & AV_CPU_FLAG_NEON) != 0;
+    return s_neon;
+}
+#endif
+
 #if !HAVE_LRINTF
 static av_always_inline av_const long int lrintf(float x)
 {
@@ -83,6 +110,180 @@ static inline float clipcheck(float f)
     return f;
 }
 
+/*
+ The AVX2 and NEON kernels below convert 16 samples at a time and return the
+ number of samples converted, leaving the remainder for the SSE or C code.
+ They give the same results as the SSE code.
+ */
+
+#if AVX2_KERNELS
+AVX2_TARGET static int toFloat16AVX2(float* out, const short* in, int len)
+{
+    const __m256 f = _mm256_set1_ps(1.0F / (1<<15));
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(s));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(s, 1));
+        _mm256_storeu_ps(out + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(lo), f));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), f));
+    }
+    return i;
+}
+
+AVX2_TARGET static int fromFloat16AVX2(short* out, const float* in, int len)
+{
+    const __m256 f = _mm256_set1_ps(1<<15);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256i lo = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i), f));
+        __m256i hi = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), f));
+        // packs works within 128 bit lanes, put the quadwords back in order
+        __m256i s = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256((__m256i*)(out + i), s);
+    }
+    return i;
+}
+
+AVX2_TARGET static int toFloat32AVX2(float* out, const int* in, int len,
+                                     float f, int shift)
+{
+    const __m256  vf = _mm256_set1_ps(f);
+    const __m128i vs = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256i a = _mm256_sra_epi32(_mm256_loadu_si256((const __m256i*)(in + i)), vs);
+        __m256i b = _mm256_sra_epi32(_mm256_loadu_si256((const __m256i*)(in + i + 8)), vs);
+        _mm256_storeu_ps(out + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(a), vf));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), vf));
+    }
+    return i;
+}
+
+AVX2_TARGET static int fromFloat32AVX2(int* out, const float* in, int len,
+                                       float f, int shift)
+{
+    const __m256  vf  = _mm256_set1_ps(f);
+    const __m256  max = _mm256_set1_ps(0.99999995F);
+    const __m256  min = _mm256_set1_ps(-1.0F);
+    const __m128i vs  = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256 a = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(in + i), max), min);
+        __m256 b = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(in + i + 8), max), min);
+        __m256i ia = _mm256_sll_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(a, vf)), vs);
+        __m256i ib = _mm256_sll_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(b, vf)), vs);
+        _mm256_storeu_si256((__m256i*)(out + i),     ia);
+        _mm256_storeu_si256((__m256i*)(out + i + 8), ib);
+    }
+    return i;
+}
+
+AVX2_TARGET static int fromFloatFLTAVX2(float* out, const float* in, int len)
+{
+    const __m256 max = _mm256_set1_ps(1.0F);
+    const __m256 min = _mm256_set1_ps(-1.0F);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256 a = _mm256_loadu_ps(in + i);
+        __m256 b = _mm256_loadu_ps(in + i + 8);
+        _mm256_storeu_ps(out + i,     _mm256_max_ps(_mm256_min_ps(a, max), min));
+        _mm256_storeu_ps(out + i + 8, _mm256_max_ps(_mm256_min_ps(b, max), min));
+    }
+    return i;
+}
+#endif // AVX2_KERNELS
+
+#if HAVE_INTRINSICS_NEON
+static int toFloat16NEON(float* out, const short* in, int len)
+{
+    const float f = 1.0F / (1<<15);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        int16x8_t a = vld1q_s16(in + i);
+        int16x8_t b = vld1q_s16(in + i + 8);
+        vst1q_f32(out + i,      vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(a))), f));
+        vst1q_f32(out + i + 4,  vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(a))), f));
+        vst1q_f32(out + i + 8,  vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(b))), f));
+        vst1q_f32(out + i + 12, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(b))), f));
+    }
+    return i;
+}
+
+static int toFloat32NEON(float* out, const int* in, int len, float f, int shift)
+{
+    const int32x4_t vs = vdupq_n_s32(-shift);   // negative shift is a right shift
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        for (int j = 0; j < 16; j += 4)
+        {
+            int32x4_t v = vshlq_s32(vld1q_s32(in + i + j), vs);
+            vst1q_f32(out + i + j, vmulq_n_f32(vcvtq_f32_s32(v), f));
+        }
+    }
+    return i;
+}
+
+static int fromFloatFLTNEON(float* out, const float* in, int len)
+{
+    const float32x4_t max = vdupq_n_f32(1.0F);
+    const float32x4_t min = vdupq_n_f32(-1.0F);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        for (int j = 0; j < 16; j += 4)
+        {
+            float32x4_t v = vld1q_f32(in + i + j);
+            vst1q_f32(out + i + j, vmaxq_f32(vminq_f32(v, max), min));
+        }
+    }
+    return i;
+}
+
+#if ARCH_AARCH64
+// ARMv7 NEON has no round to nearest conversion, leave those to the C code
+static int fromFloat16NEON(short* out, const float* in, int len)
+{
+    const float f = 1<<15;
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        for (int j = 0; j < 16; j += 8)
+        {
+            int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i + j), f));
+            int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i + j + 4), f));
+            vst1q_s16(out + i + j, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+        }
+    }
+    return i;
+}
+
+static int fromFloat32NEON(int* out, const float* in, int len, float f, int shift)
+{
+    const float32x4_t max = vdupq_n_f32(0.99999995F);
+    const float32x4_t min = vdupq_n_f32(-1.0F);
+    const int32x4_t   vs  = vdupq_n_s32(shift);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        for (int j = 0; j < 16; j += 4)
+        {
+            float32x4_t v = vmaxq_f32(vminq_f32(vld1q_f32(in + i + j), max), min);
+            vst1q_s32(out + i + j, vshlq_s32(vcvtnq_s32_f32(vmulq_n_f32(v, f)), vs));
+        }
+    }
+    return i;
+}
+#endif // ARCH_AARCH64
+#endif // HAVE_INTRINSICS_NEON
+
 /*
  The SSE code processes 16 bytes at a time and leaves any remainder for the C
  */
@@ -219,8 +420,24 @@ static int toFloat16(float* out, const short* in, int len)
     int i = 0;
     float f = 1.0F / ((1<<15));
 
+#if AVX2_KERNELS
+    if (avx2_check() && len >= 16)
+    {
+        i = toFloat16AVX2(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (neon_check() && len >= 16)
+    {
+        i = toFloat16NEON(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && len >= 16)
+    if (!i && sse_check() && len >= 16)
     {
         int loops = len >> 4;
         i = loops << 4;
@@ -281,8 +498,24 @@ static int fromFloat16(short* out, const float* in, int len)
     int i = 0;
     float f = (1<<15);
 
+#if AVX2_KERNELS
+    if (avx2_check() && len >= 16)
+    {
+        i = fromFloat16AVX2(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (neon_check() && len >= 16)
+    {
+        i = fromFloat16NEON(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && len >= 16)
+    if (!i && sse_check() && len >= 16)
     {
         int loops = len >> 4;
         i = loops << 4;
@@ -333,8 +566,24 @@ static int toFloat32(AudioFormat format, float* out, const int* in, int len)
     if (format == FORMAT_S24LSB)
         shift = 0;
 
+#if AVX2_KERNELS
+    if (avx2_check() && len >= 16)
+    {
+        i = toFloat32AVX2(out, in, len, f, shift);
+        out += i;
+        in += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (neon_check() && len >= 16)
+    {
+        i = toFloat32NEON(out, in, len, f, shift);
+        out += i;
+        in += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && len >= 16)
+    if (!i && sse_check() && len >= 16)
     {
         int loops = len >> 4;
         i = loops << 4;
@@ -390,8 +639,24 @@ static int fromFloat32(AudioFormat format, int* out, const float* in, int len)
     if (format == FORMAT_S24LSB)
         shift = 0;
 
+#if AVX2_KERNELS
+    if (avx2_check() && len >= 16)
+    {
+        i = fromFloat32AVX2(out, in, len, f, shift);
+        out += i;
+        in += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (neon_check() && len >= 16)
+    {
+        i = fromFloat32NEON(out, in, len, f, shift);
+        out += i;
+        in += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && len >= 16)
+    if (!i && sse_check() && len >= 16)
     {
         float o = 0.99999995;
         float mo = -1;
@@ -472,8 +737,24 @@ static int fromFloatFLT(float* out, const float* in, int len)
 {
     int i = 0;
 
+#if AVX2_KERNELS
+    if (avx2_check() && len >= 16)
+    {
+        i = fromFloatFLTAVX2(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (neon_check() && len >= 16)
+    {
+        i = fromFloatFLTNEON(out, in, len);
+        out += i;
+        in += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && len >= 16)
+    if (!i && sse_check() && len >= 16)
     {
         int loops = len >> 4;
         float o = 1;
@@ -147,6 +147,8 @@ class MPUBLIC AudioOutput : public VolumeBase, public OutputListeners
 
     virtual void GetBufferStatus(uint &fill, uint &total)
         { fill = total = 0; }
+    /// report how often playback ran out of audio
+    virtual uint GetUnderruns(void) const { return 0; }
 
     //  Only really used by the AudioOutputNULL object
     virtual void bufferOutputData(bool y) = 0;
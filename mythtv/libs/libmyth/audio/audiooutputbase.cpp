@@ -302,6 +302,7 @@ void AudioOutputBase::SetStretchFactorLocked(float lstretchfactor)
             m_bytesPerFrame = m_previousBpf;
             m_waud = m_raud = 0;
             m_resetActive.Ref();
+            m_underrunArmed = false;
         }
         else
         {
@@ -338,6 +339,7 @@ void AudioOutputBase::SetStretchFactorLocked(float lstretchfactor)
             m_audbufTimecode = m_audioTime = m_framesBuffered = 0;
             m_waud = m_raud = 0;
             m_resetActive.Ref();
+            m_underrunArmed = false;
             m_wasPaused = m_pauseAudio;
             m_pauseAudio = true;
             m_actuallyPaused = false;
@@ -599,6 +601,7 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
 
     m_waud = m_raud = 0;
     m_resetActive.Clear();
+    m_underrunArmed = false;
     m_actuallyPaused = m_processing = m_forcedProcessing = false;
 
     m_channels               = settings.m_channels;
@@ -808,9 +811,14 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
     {
         m_surroundMode = gCoreContext->GetNumSetting("AudioUpmixType", QUALITY_HIGH);
         m_upmixer = new FreeSurround(m_sampleRate, m_source == AUDIOOUTPUT_VIDEO,
-                                   (FreeSurround::SurroundMode)m_surroundMode);
-        VBAUDIO(QString("Create %1 quality upmixer done")
-                .arg(quality_string(m_surroundMode)));
+                                   (FreeSurround::SurroundMode)m_surroundMode,
+                                   gCoreContext->GetNumSetting("AudioUpmixBlockSize",
+                                                               SURROUND_BUFSIZE),
+                                   gCoreContext->GetBoolSetting("AudioUpmixThreaded",
+                                                                false));
+        VBAUDIO(QString("Create %1 quality upmixer done, %2 frame blocks")
+                .arg(quality_string(m_surroundMode))
+                .arg(m_upmixer->framesPerBlock()));
     }
 
     VBAUDIO(QString("Audio Stretch Factor: %1").arg(m_stretchFactor));
@@ -930,9 +938,10 @@ void AudioOutputBase::Reset()
     }
     else
     {
-        m_waud = m_raud;        // empty ring buffer
+        m_waud = m_raud.load(); // empty ring buffer
     }
     m_resetActive.Ref();
+    m_underrunArmed = false;
     m_currentSeconds = -1;
     m_wasPaused = !m_pauseAudio;
     m_unpauseWhenReady = false;
@@ -977,9 +986,11 @@ void AudioOutputBase::SetEffDsp(int dsprate)
  */
 inline int AudioOutputBase::audiolen() const
 {
-    if (m_waud >= m_raud)
-        return m_waud - m_raud;
-    return kAudioRingBufferSize - (m_raud - m_waud);
+    uint waud = m_waud.load(std::memory_order_acquire);
+    uint raud = m_raud.load(std::memory_order_acquire);
+    if (waud >= raud)
+        return waud - raud;
+    return kAudioRingBufferSize - (raud - waud);
 }
 
 /**
@@ -1584,7 +1595,9 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
             org_waud = (org_waud + to_get) % kAudioRingBufferSize;
         }
 
-        m_waud = org_waud;
+        // publish the new samples to the output thread
+        m_waud.store(org_waud, std::memory_order_release);
+        m_draining = false;
     }
 
     SetAudiotime(frames_final, timecode);
@@ -1675,6 +1688,13 @@ void AudioOutputBase::OutputAudioLoop(void)
         // wait for the buffer to fill with enough to play
         if (m_fragmentSize > ready)
         {
+            if (m_underrunArmed.exchange(false) && !m_draining)
+            {
+                m_underruns++;
+                VBAUDIO(QString("Audio buffer underrun (%1 so far), "
+                                "have %2 want %3")
+                        .arg(m_underruns.load()).arg(ready).arg(m_fragmentSize));
+            }
             if (ready > 0)  // only log if we're sending some audio
             {
                 VBAUDIOTS(QString("audio waiting for buffer to fill: "
@@ -1694,14 +1714,18 @@ void AudioOutputBase::OutputAudioLoop(void)
         // delay setting raud until after phys buffer is filled
         // so GetAudiotime will be accurate without locking
         m_resetActive.TestAndDeref();
-        volatile uint next_raud = m_raud;
+        uint next_raud = m_raud.load(std::memory_order_relaxed);
         if (GetAudioData(fragment, m_fragmentSize, true, &next_raud))
         {
             if (!m_resetActive.TestAndDeref())
             {
                 WriteAudio(fragment, m_fragmentSize);
                 if (!m_resetActive.TestAndDeref())
-                    m_raud = next_raud;
+                {
+                    // hand the space back to AddData()
+                    m_raud.store(next_raud, std::memory_order_release);
+                    m_underrunArmed = true;
+                }
             }
         }
 #ifdef AUDIOTSTESTING
@@ -1726,18 +1750,19 @@ void AudioOutputBase::OutputAudioLoop(void)
  * available. Returns the number of bytes copied.
  */
 int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
-                                  volatile uint *local_raud)
+                                  uint *local_raud)
 {
 
-#define LRPOS (m_audioBuffer + *local_raud)
+#define LRPOS (m_audioBuffer + raud)
     // re-check audioready() in case things changed.
     // for example, ClearAfterSeek() might have run
     int avail_size   = audioready();
     int frag_size    = size;
     int written_size = size;
 
-    if (local_raud == nullptr)
-        local_raud = &m_raud;
+    // only this thread moves the read position, work on a copy of it
+    uint raud = local_raud ? *local_raud
+                           : m_raud.load(std::memory_order_relaxed);
 
     if (!full_buffer && (size > avail_size))
     {
@@ -1749,7 +1774,7 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
     if (!avail_size || (frag_size > avail_size))
         return 0;
 
-    int bdiff = kAudioRingBufferSize - m_raud;
+    int bdiff = kAudioRingBufferSize - raud;
 
     int obytes = AudioOutputSettings::SampleSize(m_outputFormat);
 
@@ -1778,7 +1803,7 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
         }
 
         frag_size -= bdiff;
-        *local_raud = 0;
+        raud = 0;
     }
     if (frag_size > 0)
     {
@@ -1793,7 +1818,11 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
         }
     }
 
-    *local_raud += frag_size;
+    raud += frag_size;
+    if (local_raud)
+        *local_raud = raud;
+    else
+        m_raud.store(raud, std::memory_order_release);
 
     // Mute individual channels through mono->stereo duplication
     MuteState mute_state = GetMuteState();
@@ -1814,6 +1843,8 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
  */
 void AudioOutputBase::Drain()
 {
+    // running out of audio is expected from here until more is added
+    m_draining = true;
     while (!m_pauseAudio && audioready() > m_fragmentSize)
         usleep(1000);
     if (m_pauseAudio)
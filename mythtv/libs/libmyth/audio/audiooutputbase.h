@@ -1,6 +1,9 @@
 #ifndef AUDIOOUTPUTBASE
 #define AUDIOOUTPUTBASE
 
+// C++ headers
+#include <atomic>
+
 // POSIX headers
 #include <sys/time.h> // for struct timeval
 
@@ -39,8 +42,8 @@ public:
     void Ref() { m_head++; }
     bool TestAndDeref() { bool r = false; if ((r=(m_head != m_tail))) m_tail++; return r; }
 private:
-    int m_head {0};
-    int m_tail {0};
+    std::atomic<int> m_head {0};  // only incremented by the resetting thread
+    std::atomic<int> m_tail {0};  // only incremented by the output thread
 };
 
 // Forward declaration of SPDIF encoder
@@ -111,6 +114,7 @@ class AudioOutputBase : public AudioOutput, public MThread
     void SetSourceBitrate(int rate) override; // AudioOutput
 
     void GetBufferStatus(uint &fill, uint &total) override; // AudioOutput
+    uint GetUnderruns(void) const override { return m_underruns; } // AudioOutput
 
     //  Only really used by the AudioOutputNULL object
     void bufferOutputData(bool y) override // AudioOutput
@@ -147,7 +151,7 @@ class AudioOutputBase : public AudioOutput, public MThread
     virtual void StopOutputThread(void);
 
     int GetAudioData(uchar *buffer, int buf_size, bool full_buffer,
-                     volatile uint *local_raud = nullptr);
+                     uint *local_raud = nullptr);
 
     void OutputAudioLoop(void);
 
@@ -263,10 +267,12 @@ class AudioOutputBase : public AudioOutput, public MThread
     int64_t           m_audioTime                         {0};
 
     /**
-     * Audio circular buffer
+     * Audio circular buffer, a single producer single consumer ring.
+     * Only AddData() advances m_waud and only the output thread advances
+     * m_raud, each publishing its position after the data is in place.
      */
-    volatile uint     m_raud                              {0}; // read position
-    volatile uint     m_waud                              {0}; // write position
+    std::atomic<uint> m_raud                              {0}; // read position
+    std::atomic<uint> m_waud                              {0}; // write position
     /**
      * timecode of audio most recently placed into buffer
      */
@@ -277,6 +283,13 @@ class AudioOutputBase : public AudioOutput, public MThread
 
     long              m_currentSeconds                    {-1};
 
+    /// Times the output thread ran out of audio while playing
+    std::atomic<uint> m_underruns                         {0};
+    /// Set once audio was written, cleared when the buffer is emptied
+    std::atomic<bool> m_underrunArmed                     {false};
+    /// Drain() is waiting for the buffer to empty
+    std::atomic<bool> m_draining                          {false};
+
     float            *m_srcIn;
 
     // All actual buffers
@@ -164,6 +164,27 @@ static const float s51_matrix[3][8][6] =
     }
 };
 
+/*
+ The channel counts are template parameters so that the compiler can unroll
+ the inner loops and vectorise the matrix multiplication for each layout.
+ */
+template <int CHANNELS_IN, int CHANNELS_OUT>
+void _DownmixFrames(float *dst, const float *src,
+                    const float matrix[8][CHANNELS_OUT], int frames)
+{
+    for (int n=0; n < frames; n++)
+    {
+        for (int i=0; i < CHANNELS_OUT; i++)
+        {
+            float tmp = 0.0F;
+            for (int j=0; j < CHANNELS_IN; j++)
+                tmp += src[j] * matrix[j][i];
+            *dst++ = tmp;
+        }
+        src += CHANNELS_IN;
+    }
+}
+
 int AudioOutputDownmix::DownmixFrames(int channels_in, int  channels_out,
                                       float *dst, const float *src, int frames)
 {
@@ -174,32 +195,30 @@ int AudioOutputDownmix::DownmixFrames(int channels_in, int  channels_out,
     //    .arg(frames).arg(channels_in).arg(channels_out));
     if (channels_out == 2)
     {
-        int index = channels_in - 1;
-        for (int n=0; n < frames; n++)
+        const float (*matrix)[2] = stereo_matrix[channels_in - 1];
+        switch (channels_in)
         {
-            for (int i=0; i < channels_out; i++)
-            {
-                float tmp = 0.0F;
-                for (int j=0; j < channels_in; j++)
-                    tmp += src[j] * stereo_matrix[index][j][i];
-                *dst++ = tmp;
-            }
-            src += channels_in;
+            case 2: _DownmixFrames<2,2>(dst, src, matrix, frames); break;
+            case 3: _DownmixFrames<3,2>(dst, src, matrix, frames); break;
+            case 4: _DownmixFrames<4,2>(dst, src, matrix, frames); break;
+            case 5: _DownmixFrames<5,2>(dst, src, matrix, frames); break;
+            case 6: _DownmixFrames<6,2>(dst, src, matrix, frames); break;
+            case 7: _DownmixFrames<7,2>(dst, src, matrix, frames); break;
+            case 8: _DownmixFrames<8,2>(dst, src, matrix, frames); break;
+            default:
+                return -1;
         }
     }
     else if (channels_out == 6)
     {
-        int index = channels_in - 6;
-        for (int n=0; n < frames; n++)
+        const float (*matrix)[6] = s51_matrix[channels_in - 6];
+        switch (channels_in)
         {
-            for (int i=0; i < channels_out; i++)
-            {
-                float tmp = 0.0F;
-                for (int j=0; j < channels_in; j++)
-                    tmp += src[j] * s51_matrix[index][j][i];
-                *dst++ = tmp;
-            }
-            src += channels_in;
+            case 6: _DownmixFrames<6,6>(dst, src, matrix, frames); break;
+            case 7: _DownmixFrames<7,6>(dst, src, matrix, frames); break;
+            case 8: _DownmixFrames<8,6>(dst, src, matrix, frames); break;
+            default:
+                return -1;
         }
     }
     else
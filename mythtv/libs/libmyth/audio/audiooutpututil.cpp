@@ -11,9 +11,19 @@
 
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 #include "pink.h"
 }
 
+#if ARCH_X86 && HAVE_AVX2 && defined(__GNUC__)
+#define AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if HAVE_INTRINSICS_NEON
+#include <arm_neon.h>
+#endif
+
 #define LOC QString("AOUtil: ")
 
 #define ISALIGN(x) (((unsigned long)(x) & 0xf) == 0)
@@ -49,6 +59,46 @@ static inline bool sse_check()
 }
 #endif //ARCH_x86
 
+#if AVX2_KERNELS
+static inline bool avx2_check()
+{
+    static const bool s_avx2 = (av_get_cpu_flags() & AV_CPU_FLAG_AVX2) != 0;
+    return s_avx2;
+}
+
+__attribute__((target("avx2")))
+static int AdjustVolumeAVX2(float *buf, int samples, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 16 <= samples; i += 16)
+    {
+        _mm256_storeu_ps(buf + i,     _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+        _mm256_storeu_ps(buf + i + 8, _mm256_mul_ps(_mm256_loadu_ps(buf + i + 8), g));
+    }
+    return i;
+}
+#endif
+
+#if HAVE_INTRINSICS_NEON
+static inline bool neon_check()
+{
+    static const bool s_neon = (av_get_cpu_flags() & AV_CPU_FLAG_NEON) != 0;
+    return s_neon;
+}
+
+static int AdjustVolumeNEON(float *buf, int samples, float gain)
+{
+    int i = 0;
+    for (; i + 16 <= samples; i += 16)
+    {
+        for (int j = 0; j < 16; j += 4)
+            vst1q_f32(buf + i + j, vmulq_n_f32(vld1q_f32(buf + i + j), gain));
+    }
+    return i;
+}
+#endif
+
 /**
  * Returns true if platform has an FPU.
  * for the time being, this test is limited to testing if SSE2 is supported
@@ -120,8 +170,22 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
     if (g == 1.0F)
         return;
 
+#if AVX2_KERNELS
+    if (avx2_check() && samples >= 16)
+    {
+        i = AdjustVolumeAVX2(fptr, samples, g);
+        fptr += i;
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (neon_check() && samples >= 16)
+    {
+        i = AdjustVolumeNEON(fptr, samples, g);
+        fptr += i;
+    }
+#endif
 #if ARCH_X86
-    if (sse_check() && samples >= 16)
+    if (!i && sse_check() && samples >= 16)
     {
         int loops = samples >> 4;
         i = loops << 4;
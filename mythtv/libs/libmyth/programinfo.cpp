@@ -5241,16 +5241,22 @@ void ProgramInfo::SubstituteMatches(QString &str)
     str.replace(QString("%RECORDEDID%"), QString::number(m_recordedId));
 }
 
-QMap<QString,uint32_t> ProgramInfo::QueryInUseMap(void)
+static QMap<QString,uint32_t> query_in_use_map(
+    const QString &sql, const MSqlBindings &bindings)
 {
     QMap<QString, uint32_t> inUseMap;
     QDateTime oneHourAgo = MythDate::current().addSecs(-61 * 60);
 
     MSqlQuery query(MSqlQuery::InitCon());
 
-    query.prepare("SELECT DISTINCT chanid, starttime, recusage "
-                  "FROM inuseprograms WHERE lastupdatetime >= :ONEHOURAGO");
+    QString querystr = "SELECT DISTINCT chanid, starttime, recusage "
+                       "FROM inuseprograms WHERE lastupdatetime >= :ONEHOURAGO";
+    if (!sql.isEmpty())
+        querystr += QString(" AND (%1)").arg(sql);
+
+    query.prepare(querystr);
     query.bindValue(":ONEHOURAGO", oneHourAgo);
+    query.bindValues(bindings);
 
     if (!query.exec())
         return inUseMap;
@@ -5277,14 +5283,25 @@ QMap<QString,uint32_t> ProgramInfo::QueryInUseMap(void)
     return inUseMap;
 }
 
-QMap<QString,bool> ProgramInfo::QueryJobsRunning(int type)
+QMap<QString,uint32_t> ProgramInfo::QueryInUseMap(void)
+{
+    return query_in_use_map(QString(), MSqlBindings());
+}
+
+static QMap<QString,bool> query_jobs_running(
+    int type, const QString &sql, const MSqlBindings &bindings)
 {
     QMap<QString,bool> is_job_running;
 
     MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare("SELECT chanid, starttime, status FROM jobqueue "
-                  "WHERE type = :TYPE");
+    QString querystr = "SELECT chanid, starttime, status FROM jobqueue "
+                       "WHERE type = :TYPE";
+    if (!sql.isEmpty())
+        querystr += QString(" AND (%1)").arg(sql);
+
+    query.prepare(querystr);
     query.bindValue(":TYPE", type);
+    query.bindValues(bindings);
     if (!query.exec())
         return is_job_running;
 
@@ -5305,6 +5322,11 @@ QMap<QString,bool> ProgramInfo::QueryJobsRunning(int type)
     return is_job_running;
 }
 
+QMap<QString,bool> ProgramInfo::QueryJobsRunning(int type)
+{
+    return query_jobs_running(type, QString(), MSqlBindings());
+}
+
 QStringList ProgramInfo::LoadFromScheduler(
     const QString &tmptable, int recordid)
 {
@@ -5776,32 +5798,89 @@ bool LoadFromOldRecorded(ProgramList &destination, const QString &sql,
     return true;
 }
 
-/** \fn ProgramInfo::LoadFromRecorded(void)
- *  \brief Load a ProgramList from the recorded table.
- *  \param destination     ProgramList to fill
- *  \param possiblyInProgressRecordingsOnly  return only in-progress
- *                                           recordings or empty list
- *  \param inUseMap        in-use programs map
- *  \param isJobRunning    job map
- *  \param recMap          recording map
- *  \param sort            sort order, negative for descending, 0 for
- *                         unsorted, positive for ascending
- *  \param sortBy          comma separated list of fields to sort by
- *  \return true if it succeeds, false if it fails.
- *  \sa QueryInUseMap(void)
- *      QueryJobsRunning(int)
- *      Scheduler::GetRecording()
+/** \brief Looks up the in-use, job and recording state of the recordings
+ *         selected by a recorded query.
+ *
+ *  \param sql      WHERE, ORDER BY and LIMIT of the query, which may only
+ *                  reference recorded (as 'r') and channel (as 'c')
+ *  \param bindings bindings for sql
  */
-bool LoadFromRecorded(
+static void query_recorded_state(
+    const QString &sql,
+    const MSqlBindings &bindings,
+    const QDateTime &rectime,
+    QMap<QString,uint32_t> &inUseMap,
+    QMap<QString,bool> &isJobRunning,
+    QMap<QString, ProgramInfo*> &recMap)
+{
+    QString keystr = "SELECT r.chanid, r.starttime, r.endtime "
+                     "FROM recorded AS r "
+                     "LEFT JOIN channel AS c "
+                     "ON (r.chanid    = c.chanid) " + sql;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(keystr);
+    MSqlBindings::const_iterator it;
+    for (it = bindings.begin(); it != bindings.end(); ++it)
+    {
+        if (keystr.contains(it.key()))
+            query.bindValue(it.key(), it.value());
+    }
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramList::FromRecorded state", query);
+        return;
+    }
+
+    QStringList  match;
+    MSqlBindings keys;
+    bool maybeRecording = false;
+
+    while (query.next())
+    {
+        int n = match.size();
+        match << QString("(chanid = :CHANID%1 AND starttime = :STARTTIME%1)")
+            .arg(n);
+        keys[QString(":CHANID%1").arg(n)] = query.value(0).toUInt();
+        keys[QString(":STARTTIME%1").arg(n)] = query.value(1);
+        if (MythDate::as_utc(query.value(2).toDateTime()) > rectime)
+            maybeRecording = true;
+    }
+
+    if (match.isEmpty())
+        return;
+
+    QString keysql = match.join(" OR ");
+    inUseMap     = query_in_use_map(keysql, keys);
+    isJobRunning = query_jobs_running(/*JOB_COMMFLAG*/ 0x0002, keysql, keys);
+
+    // Only recordings that ended recently can still be recording
+    if (maybeRecording && gCoreContext->GetScheduler())
+        recMap = gCoreContext->GetScheduler()->GetRecording();
+}
+
+/** \brief Shared implementation of the LoadFromRecorded() overloads.
+ *
+ *  When the state maps are null they are looked up here, for just the
+ *  loaded rows when loading a page.
+ */
+static bool load_from_recorded(
     ProgramList &destination,
     bool possiblyInProgressRecordingsOnly,
-    const QMap<QString,uint32_t> &inUseMap,
-    const QMap<QString,bool> &isJobRunning,
-    const QMap<QString, ProgramInfo*> &recMap,
+    const QMap<QString,uint32_t> *inUseMap,
+    const QMap<QString,bool> *isJobRunning,
+    const QMap<QString, ProgramInfo*> *recMap,
     int sort,
-    const QString &sortBy)
+    const QString &sortBy,
+    const QString &sql,
+    const MSqlBindings &bindings,
+    uint start,
+    uint limit,
+    uint &count)
 {
     destination.clear();
+    count = 0;
 
     QString     fs_db_name = "";
     QDateTime   rectime    = MythDate::current().addSecs(
@@ -5809,16 +5888,54 @@ bool LoadFromRecorded(
 
     // ----------------------------------------------------------------------
 
-    QString thequery = ProgramInfo::kFromRecordedQuery;
+    QStringList conditions;
     if (possiblyInProgressRecordingsOnly)
-        thequery += "WHERE r.endtime >= NOW() AND r.starttime <= NOW() ";
+        conditions << "r.endtime >= NOW() AND r.starttime <= NOW()";
+    if (!sql.isEmpty())
+        conditions << QString("(%1)").arg(sql);
+
+    QString where;
+    if (!conditions.isEmpty())
+        where = "WHERE " + conditions.join(" AND ") + " ";
+
+    bool paged = (start > 0) || (limit > 0);
+    MSqlQuery query(MSqlQuery::InitCon());
+    MSqlBindings::const_iterator it;
+
+    // The count doesn't need any of the joins in kFromRecordedQuery
+    if (paged)
+    {
+        QString countstr = "SELECT COUNT(*) FROM recorded AS r " + where;
+        query.prepare(countstr);
+        for (it = bindings.begin(); it != bindings.end(); ++it)
+        {
+            if (countstr.contains(it.key()))
+                query.bindValue(it.key(), it.value());
+        }
+
+        if (!query.exec() || !query.next())
+        {
+            MythDB::DBError("ProgramList::FromRecorded count", query);
+            return false;
+        }
+        count = query.value(0).toUInt();
+        if (start >= count)
+            return true;
+    }
+
+    QString order;
+    bool ordered = false;
 
     if (sortBy.isEmpty())
     {
+        ordered = (sort != 0);
         if (sort)
-            thequery += "ORDER BY r.starttime ";
+            order += "ORDER BY r.starttime ";
         if (sort < 0)
-            thequery += "DESC ";
+            order += "DESC ";
+        // Ensure a stable order between pages
+        if (sort && paged)
+            order += ", r.recordedid ";
     }
     else
     {
@@ -5871,16 +5988,64 @@ bool LoadFromRecorded(
             }
         }
 
-        thequery += "ORDER BY " + sSortBy;
+        if (!sSortBy.isEmpty())
+        {
+            ordered = true;
+            order += "ORDER BY " + sSortBy;
+            if (paged)
+                order += ",r.recordedid";
+            order += " ";
+        }
     }
 
-    MSqlQuery query(MSqlQuery::InitCon());
+    if (paged && !ordered)
+    {
+        // Pages are only meaningful in a stable order
+        order += "ORDER BY r.starttime, r.recordedid ";
+    }
+
+    if (paged)
+    {
+        // MySQL requires a LIMIT with an OFFSET
+        order += QString("LIMIT %1 OFFSET %2 ")
+            .arg(limit > 0 ? limit : count).arg(start);
+    }
+
+    QMap<QString,uint32_t>      rowInUseMap;
+    QMap<QString,bool>          rowJobsRunning;
+    QMap<QString, ProgramInfo*> rowRecMap;
+    if (!inUseMap || !isJobRunning || !recMap)
+    {
+        if (paged)
+        {
+            query_recorded_state(where + order, bindings, rectime,
+                                 rowInUseMap, rowJobsRunning, rowRecMap);
+        }
+        else
+        {
+            rowInUseMap    = ProgramInfo::QueryInUseMap();
+            rowJobsRunning = ProgramInfo::QueryJobsRunning(/*JOB_COMMFLAG*/ 0x0002);
+            if (gCoreContext->GetScheduler())
+                rowRecMap = gCoreContext->GetScheduler()->GetRecording();
+        }
+        inUseMap     = &rowInUseMap;
+        isJobRunning = &rowJobsRunning;
+        recMap       = &rowRecMap;
+    }
+
+    QString thequery = ProgramInfo::kFromRecordedQuery + where + order;
     query.prepare(thequery);
+    for (it = bindings.begin(); it != bindings.end(); ++it)
+    {
+        if (thequery.contains(it.key()))
+            query.bindValue(it.key(), it.value());
+    }
 
     if (!query.exec())
     {
         MythDB::DBError("ProgramList::FromRecorded", query);
-        return true;
+        qDeleteAll(rowRecMap);
+        return false;
     }
 
     while (query.next())
@@ -5907,7 +6072,7 @@ bool LoadFromRecorded(
 
         QString key = ProgramInfo::MakeUniqueKey(chanid, recstartts);
         if (MythDate::as_utc(query.value(25).toDateTime()) > rectime &&
-            recMap.contains(key))
+            recMap->contains(key))
         {
             recstatus = RecStatus::Recording;
         }
@@ -5932,11 +6097,11 @@ bool LoadFromRecorded(
         set_flag(flags, FL_BOOKMARK,      query.value(40).toBool());
         set_flag(flags, FL_WATCHED,       query.value(41).toBool());
 
-        if (inUseMap.contains(key))
-            flags |= inUseMap[key];
+        if (inUseMap->contains(key))
+            flags |= inUseMap->value(key);
 
         if (((flags & FL_COMMPROCESSING) != 0U) &&
-            (isJobRunning.find(key) == isJobRunning.end()))
+            !isJobRunning->contains(key))
         {
             flags &= ~FL_COMMPROCESSING;
             save_not_commflagged = true;
@@ -6023,9 +6188,76 @@ bool LoadFromRecorded(
             destination.back()->SaveCommFlagged(COMM_FLAG_NOT_FLAGGED);
     }
 
+    qDeleteAll(rowRecMap);
+
+    if (!paged)
+        count = destination.size();
+
     return true;
 }
 
+/** \fn ProgramInfo::LoadFromRecorded(void)
+ *  \brief Load a ProgramList from the recorded table.
+ *  \param destination     ProgramList to fill
+ *  \param possiblyInProgressRecordingsOnly  return only in-progress
+ *                                           recordings or empty list
+ *  \param inUseMap        in-use programs map
+ *  \param isJobRunning    job map
+ *  \param recMap          recording map
+ *  \param sort            sort order, negative for descending, 0 for
+ *                         unsorted, positive for ascending
+ *  \param sortBy          comma separated list of fields to sort by
+ *  \return true if it succeeds, false if it fails.
+ *  \sa QueryInUseMap(void)
+ *      QueryJobsRunning(int)
+ *      Scheduler::GetRecording()
+ */
+bool LoadFromRecorded(
+    ProgramList &destination,
+    bool possiblyInProgressRecordingsOnly,
+    const QMap<QString,uint32_t> &inUseMap,
+    const QMap<QString,bool> &isJobRunning,
+    const QMap<QString, ProgramInfo*> &recMap,
+    int sort,
+    const QString &sortBy)
+{
+    uint count = 0;
+    return load_from_recorded(destination, possiblyInProgressRecordingsOnly,
+                              &inUseMap, &isJobRunning, &recMap, sort, sortBy,
+                              QString(), MSqlBindings(), 0, 0, count);
+}
+
+/** \brief Load a filtered page of a ProgramList from the recorded table.
+ *
+ *  As above, but filtering, sorting and paging are all performed by the
+ *  database so that only the requested rows are turned into ProgramInfos.
+ *  The in-use, job and recording state is only looked up for those rows.
+ *
+ *  \param sql       additional conditions (without a leading AND/WHERE),
+ *                   which may only reference columns of recorded (as 'r')
+ *  \param bindings  bindings for sql
+ *  \param start     number of matching rows to skip
+ *  \param limit     maximum number of rows to load, 0 for no limit
+ *  \param count     set to the total number of matching rows, irrespective
+ *                   of start and limit
+ */
+bool LoadFromRecorded(
+    ProgramList &destination,
+    bool possiblyInProgressRecordingsOnly,
+    int sort,
+    const QString &sortBy,
+    const QString &sql,
+    const MSqlBindings &bindings,
+    uint start,
+    uint limit,
+    uint &count)
+{
+    return load_from_recorded(destination, possiblyInProgressRecordingsOnly,
+                              nullptr, nullptr, nullptr, sort, sortBy,
+                              sql, bindings, start, limit, count);
+}
+
+
 bool GetNextRecordingList(QDateTime &nextRecordingStart,
                           bool *hasConflicts,
                           vector<ProgramInfo> *list)
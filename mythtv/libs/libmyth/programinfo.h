@@ -872,6 +872,17 @@ MPUBLIC bool LoadFromRecorded(
     int                 sort = 0,
     const QString      &sortBy = "");
 
+MPUBLIC bool LoadFromRecorded(
+    ProgramList        &destination,
+    bool                possiblyInProgressRecordingsOnly,
+    int                 sort,
+    const QString      &sortBy,
+    const QString      &sql,
+    const MSqlBindings &bindings,
+    uint                start,
+    uint                limit,
+    uint               &count);
+
 
 template<typename TYPE>
 bool LoadFromScheduler(
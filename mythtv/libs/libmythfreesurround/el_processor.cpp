@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "el_processor.h"
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <cstdlib>
@@ -71,8 +72,11 @@ public:
         memset(m_fftContextForward, 0, sizeof(FFTContext));
         m_fftContextReverse = (FFTContext*)av_malloc(sizeof(FFTContext));
         memset(m_fftContextReverse, 0, sizeof(FFTContext));
-        ff_fft_init(m_fftContextForward, 13, 0);
-        ff_fft_init(m_fftContextReverse, 13, 1);
+        int nbits = 0;
+        while ((1U << nbits) < m_n)
+            nbits++;
+        ff_fft_init(m_fftContextForward, nbits, 0);
+        ff_fft_init(m_fftContextReverse, nbits, 1);
 #endif
         // resize our own buffers
         m_frontR.resize(m_n);
@@ -176,7 +180,7 @@ public:
     // set lfe filter params
     void sample_rate(unsigned int srate) {
         // lfe filter is just straight through band limited
-        unsigned int cutoff = (30*m_n)/srate;
+        unsigned int cutoff = std::max((30*m_n)/srate, 1U);
         for (unsigned f=0;f<=m_halfN;f++) {
             if (f<cutoff)
                 m_filter[5][f] = 0.5*sqrt(0.5);
@@ -207,6 +211,8 @@ public:
         const float modes[4][2] = {{0,0},{0,PI},{PI,0},{-PI/2,PI/2}};
         m_phaseOffsetL = modes[mode][0];
         m_phaseOffsetR = modes[mode][1];
+        m_phaseRotateL = polar(1, m_phaseOffsetL);
+        m_phaseRotateR = polar(1, m_phaseOffsetR);
     }
 
     // what steering mode should be chosen
@@ -274,20 +280,19 @@ private:
         // 2. compare amplitude and phase of each DFT bin and produce the X/Y coordinates in the sound field
         //    but dont do DC or N/2 component
         for (unsigned f=0;f<m_halfN;f++) {
-            // get left/right amplitudes/phases
+            // get left/right amplitudes
+            cfloat dftL(m_dftL[f][0], m_dftL[f][1]);
+            cfloat dftR(m_dftR[f][0], m_dftR[f][1]);
             float ampL = amplitude(m_dftL[f]);
             float ampR = amplitude(m_dftR[f]);
-            float phaseL = phase(m_dftL[f]);
-            float phaseR = phase(m_dftR[f]);
 //          if (ampL+ampR < epsilon)
 //              continue;       
 
-            // calculate the amplitude/phase difference
+            // calculate the amplitude/phase difference, the phase of
+            // L * conj(R) is the (wrapped) phase difference of L and R
             float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-            float phaseDiff = phaseL - phaseR;
-            if (phaseDiff < -PI) phaseDiff += 2*PI;
-            if (phaseDiff > PI) phaseDiff -= 2*PI;
-            phaseDiff = abs(phaseDiff);
+            cfloat cross = dftL * std::conj(dftR);
+            float phaseDiff = abs(std::atan2(cross.imag(), cross.real()));
 
             if (m_linearSteering) {
                 // --- this is the fancy new linear mode ---
@@ -322,13 +327,6 @@ private:
             } else {
                 // --- this is the old & simple steering mode ---
 
-                // calculate the amplitude/phase difference
-                float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-                float phaseDiff = phaseL - phaseR;
-                if (phaseDiff < -PI) phaseDiff += 2*PI;
-                if (phaseDiff > PI) phaseDiff -= 2*PI;
-                phaseDiff = abs(phaseDiff);
-
                 // determine sound field x-position
                 m_xFs[f] = ampDiff;
 
@@ -367,13 +365,15 @@ private:
                     m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
             }
 
-            // ... and build the signal which we want to position
-            m_frontL[f] = polar(ampL+ampR,phaseL);
-            m_frontR[f] = polar(ampL+ampR,phaseR);
+            // ... and build the signal which we want to position, scaling
+            // the input bins keeps their phase without any trigonometry
+            float amp = ampL+ampR;
+            m_frontL[f] = (ampL < epsilon) ? cfloat(amp,0) : dftL * (amp/ampL);
+            m_frontR[f] = (ampR < epsilon) ? cfloat(amp,0) : dftR * (amp/ampR);
             m_avg[f] = m_frontL[f] + m_frontR[f];
-            m_surL[f] = polar(ampL+ampR,phaseL+m_phaseOffsetL);
-            m_surR[f] = polar(ampL+ampR,phaseR+m_phaseOffsetR);
-            m_trueavg[f] = cfloat(m_dftL[f][0] + m_dftR[f][0], m_dftL[f][1] + m_dftR[f][1]);
+            m_surL[f] = m_frontL[f] * m_phaseRotateL;
+            m_surR[f] = m_frontR[f] * m_phaseRotateR;
+            m_trueavg[f] = dftL + dftR;
         }
 
         // 4. distribute the unfiltered reference signals over the channels
@@ -553,6 +553,8 @@ private:
     float m_surroundLevel   {0.0F};      // gain for the surround channels (follows from the coeffs
     float m_phaseOffsetL    {0.0F};      // phase shifts to be applied to the rear channels
     float m_phaseOffsetR    {0.0F};      // phase shifts to be applied to the rear channels
+    cfloat m_phaseRotateL   {1.0F};      // the left rear phase shift as a rotation
+    cfloat m_phaseRotateR   {1.0F};      // the right rear phase shift as a rotation
     float m_frontSeparation {0.0F};      // front stereo separation
     float m_rearSeparation  {0.0F};      // rear stereo separation
     bool  m_linearSteering  {false};     // whether the steering should be linear or not
@@ -17,10 +17,12 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cerrno>
 #include <cmath>
+#include <cstring>
 
 #include <iostream>
 #include <sstream>
@@ -31,21 +33,21 @@ using namespace std;
 
 #include "compat.h"
 #include "mythlogging.h"
+#include "mthread.h"
 #include "freesurround.h"
 #include "el_processor.h"
 
 #include <QString>
 #include <QDateTime>
+#include <QElapsedTimer>
 
-// our default internal block size, in floats
-static const unsigned default_block_size = SURROUND_BUFSIZE;
 // Gain of center and lfe channels in passive mode (sqrt 0.5)
 static const float center_level = 0.707107;
 static const float m3db = 0.7071067811865476F;           // 3dB  = SQRT(2)
 static const float m6db = 0.5;                           // 6dB  = SQRT(4)
 static const float m7db = 0.44721359549996;              // 7dB  = SQRT(5)
-
-unsigned int block_size = default_block_size;
+// Log the upmixing time every this many blocks
+static const uint stats_blocks = 1000;
 
 struct buffers
 {
@@ -67,18 +69,42 @@ struct buffers
                        m_rls, m_rrs;       // for demultiplexing
 };
 
+class FreeSurroundWorker : public MThread
+{
+  public:
+    explicit FreeSurroundWorker(FreeSurround *parent) :
+        MThread("FreeSurround"), m_parent(parent) {}
+
+    void run(void) override
+    {
+        RunProlog();
+        m_parent->worker_loop();
+        RunEpilog();
+    }
+
+  private:
+    FreeSurround *m_parent;
+};
+
 //#define SPEAKERTEST
 #ifdef SPEAKERTEST
 int channel_select = -1;
 #endif
 
-FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode) :
+FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode,
+                           uint blocksize, bool threaded) :
     m_srate(srate),
     m_surroundMode(smode)
 {
+    // the FFT needs a power of two
+    m_blockSize = SURROUND_MIN_BUFSIZE;
+    while (m_blockSize < blocksize && m_blockSize < SURROUND_BUFSIZE)
+        m_blockSize <<= 1;
+
     LOG(VB_AUDIO, LOG_DEBUG,
-        QString("FreeSurround::FreeSurround rate %1 moviemode %2")
-            .arg(srate).arg(moviemode));
+        QString("FreeSurround::FreeSurround rate %1 moviemode %2 "
+                "blocksize %3 threaded %4")
+            .arg(srate).arg(moviemode).arg(m_blockSize).arg(threaded));
 
     if (moviemode)
     {
@@ -98,14 +124,25 @@ FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode) :
             break;
         case SurroundModeActiveLinear:
             m_params.steering = 1;
-            m_latencyFrames = block_size/2;
+            m_latencyFrames = m_blockSize/2;
             break;
         default:
             break;
     }
 
-    m_bufs = new buffers(block_size/2);
+    m_bufs = new buffers(m_blockSize/2);
     open();
+
+    if (threaded && m_surroundMode != SurroundModePassive &&
+        m_surroundMode != SurroundModePassiveHall)
+    {
+        for (auto & buf : m_stageIn)
+            buf.resize(m_blockSize/2);
+        for (auto & buf : m_stageOut)
+            buf.resize(m_blockSize/2);
+        m_worker = new FreeSurroundWorker(this);
+        m_worker->start();
+    }
 #ifdef SPEAKERTEST
     channel_select++;
     if (channel_select>=6)
@@ -138,6 +175,24 @@ FreeSurround::fsurround_params::fsurround_params(int32_t center_width,
 FreeSurround::~FreeSurround()
 {
     LOG(VB_AUDIO, LOG_DEBUG, QString("FreeSurround::~FreeSurround"));
+    if (m_worker)
+    {
+        m_workerIdle.acquire();
+        m_quit = true;
+        m_blockReady.release();
+        m_worker->wait();
+        delete m_worker;
+        m_worker = nullptr;
+    }
+    if (m_processBlocks)
+    {
+        LOG(VB_AUDIO, LOG_INFO,
+            QString("FreeSurround: upmixed %1 blocks of %2 frames, "
+                    "avg %3 us max %4 us")
+                .arg(m_processBlocks).arg(m_blockSize/2)
+                .arg(m_processNSecs / m_processBlocks / 1000)
+                .arg(m_processMaxNSecs / 1000));
+    }
     close();
     delete m_bufs;
     m_bufs = nullptr;
@@ -148,14 +203,25 @@ uint FreeSurround::putFrames(void* buffer, uint numFrames, uint numChannels)
 {
     uint i = 0;
     int ic = m_inCount;
-    int bs = block_size/2;
+    int bs = m_blockSize/2;
     bool process = true;
     auto *samples = (float *)buffer;
     // demultiplex
 
-    float **inputs = m_decoder->getInputBuffers();
-    float *lt      = &inputs[0][ic];
-    float *rt      = &inputs[1][ic];
+    // with a worker the decoder is only ever touched on a block handoff
+    float *lt = nullptr;
+    float *rt = nullptr;
+    if (m_worker)
+    {
+        lt = &m_stageIn[0][ic];
+        rt = &m_stageIn[1][ic];
+    }
+    else
+    {
+        float **inputs = m_decoder->getInputBuffers();
+        lt = &inputs[0][ic];
+        rt = &inputs[1][ic];
+    }
 
     if ((m_surroundMode != SurroundModePassive) && (ic+numFrames > bs))
     {
@@ -287,11 +353,14 @@ uint FreeSurround::putFrames(void* buffer, uint numFrames, uint numChannels)
             m_processed = process;
             // process_block takes some time so dont update in and out count
             // before its finished so that Audiotime is correctly calculated
-            process_block();
+            if (m_worker)
+                hand_off_block();
+            else
+                process_block();
             m_inCount = 0;
             m_outCount = bs;
             m_processedSize = bs;
-            m_latencyFrames = block_size/2;
+            m_latencyFrames = m_worker ? m_blockSize : m_blockSize/2;
         }
     }
     else
@@ -346,7 +415,17 @@ uint FreeSurround::receiveFrames(void *buffer, uint maxFrames)
     {
         if (m_processed)
         {
-            float** outputs = m_decoder->getOutputBuffers();
+            float *stageOut[6];
+            float **outputs = stageOut;
+            if (m_worker)
+            {
+                for (int ch = 0; ch < 6; ch++)
+                    stageOut[ch] = m_stageOut[ch].data();
+            }
+            else
+            {
+                outputs = m_decoder->getOutputBuffers();
+            }
             float *l   = &outputs[0][outindex];
             float *c   = &outputs[1][outindex];
             float *r   = &outputs[2][outindex];
@@ -392,6 +471,9 @@ uint FreeSurround::receiveFrames(void *buffer, uint maxFrames)
 
 void FreeSurround::process_block()
 {
+    QElapsedTimer timer;
+    timer.start();
+
     // process the data
     try
     {
@@ -403,6 +485,44 @@ void FreeSurround::process_block()
     catch(...)
     {
     }
+
+    qint64 elapsed = timer.nsecsElapsed();
+    m_processNSecs += elapsed;
+    m_processMaxNSecs = max(m_processMaxNSecs, elapsed);
+    if (++m_processBlocks % stats_blocks == 0)
+    {
+        LOG(VB_AUDIO, LOG_DEBUG,
+            QString("FreeSurround: %1 frame blocks take avg %2 us max %3 us")
+                .arg(m_blockSize/2)
+                .arg(m_processNSecs / m_processBlocks / 1000)
+                .arg(m_processMaxNSecs / 1000));
+    }
+}
+
+// Swap a full input block for the block the worker upmixed last. In steady
+// state the worker finished that block long ago, so this never waits.
+void FreeSurround::hand_off_block()
+{
+    m_workerIdle.acquire();
+    float **outputs = m_decoder->getOutputBuffers();
+    for (int ch = 0; ch < 6; ch++)
+        memcpy(m_stageOut[ch].data(), outputs[ch], m_blockSize/2 * sizeof(float));
+    float **inputs = m_decoder->getInputBuffers();
+    for (int ch = 0; ch < 2; ch++)
+        memcpy(inputs[ch], m_stageIn[ch].data(), m_blockSize/2 * sizeof(float));
+    m_blockReady.release();
+}
+
+void FreeSurround::worker_loop()
+{
+    while (true)
+    {
+        m_blockReady.acquire();
+        if (m_quit)
+            break;
+        process_block();
+        m_workerIdle.release();
+    }
 }
 
 long long FreeSurround::getLatency()
@@ -415,9 +535,17 @@ long long FreeSurround::getLatency()
 
 void FreeSurround::flush()
 {
+    if (m_worker)
+    {
+        m_workerIdle.acquire();
+        for (auto & buf : m_stageOut)
+            fill(buf.begin(), buf.end(), 0.0F);
+    }
     if (m_decoder)
         m_decoder->flush();
     m_bufs->clear();
+    if (m_worker)
+        m_workerIdle.release();
 }
 
 // load the lib and initialize the interface
@@ -425,7 +553,7 @@ void FreeSurround::open()
 {
     if (!m_decoder)
     {
-        m_decoder = new fsurround_decoder(block_size);
+        m_decoder = new fsurround_decoder(m_blockSize);
         m_decoder->flush();
         if (m_bufs)
             m_bufs->clear();
@@ -450,15 +578,17 @@ uint FreeSurround::numFrames()
     return m_outCount;
 }
 
+// The decoder's overlap delays its output by half a block, and a worker
+// thread adds a further half block as it upmixes one block behind.
 uint FreeSurround::frameLatency()
 {
     if (m_processed)
-        return m_inCount + m_outCount + (block_size/2);
+        return m_inCount + m_outCount + (m_worker ? m_blockSize : m_blockSize/2);
     return m_inCount + m_outCount;
 }
 
-uint FreeSurround::framesPerBlock()
+uint FreeSurround::framesPerBlock() const
 {
-    return block_size/2;
+    return m_blockSize/2;
 }
 
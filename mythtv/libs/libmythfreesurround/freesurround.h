@@ -19,9 +19,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef FREESURROUND_H
 #define FREESURROUND_H
 
+#include <vector>
+
+#include <QSemaphore>
+
 #include "compat.h"  // instead of sys/types.h, for MinGW compatibility
 
 #define SURROUND_BUFSIZE 8192
+#define SURROUND_MIN_BUFSIZE 512
 
 class FreeSurround
 {
@@ -34,7 +39,8 @@ public:
         SurroundModePassiveHall
     };
 public:
-    FreeSurround(uint srate, bool moviemode, SurroundMode mode);
+    FreeSurround(uint srate, bool moviemode, SurroundMode mode,
+                 uint blocksize = SURROUND_BUFSIZE, bool threaded = false);
     ~FreeSurround();
 
     // put frames in buffer, returns number of frames used
@@ -49,10 +55,14 @@ public:
     long long getLatency();
     uint frameLatency();
 
-    static uint framesPerBlock();
+    uint framesPerBlock() const;
 
 protected:
+    friend class FreeSurroundWorker;
+
     void process_block();
+    void hand_off_block();
+    void worker_loop();
     void open();
     void close();
     void SetParams();
@@ -86,6 +96,20 @@ private:
     SurroundMode m_surroundMode {SurroundModePassive}; // 1 of 3 surround modes supported
     int m_latencyFrames                {0};       // number of frames of incurred latency
     int m_channels                     {0};
+    uint m_blockSize         {SURROUND_BUFSIZE}; // FFT size, in frames
+
+    // upmixing on a worker thread, a block behind putFrames()
+    class FreeSurroundWorker *m_worker {nullptr};
+    std::vector<float> m_stageIn[2];            // block being filled
+    std::vector<float> m_stageOut[6];           // last block upmixed
+    QSemaphore         m_blockReady  {0};       // a block was handed off
+    QSemaphore         m_workerIdle  {1};       // the worker is waiting
+    bool               m_quit        {false};
+
+    // time spent upmixing, only touched by the thread calling process_block
+    qint64 m_processNSecs              {0};
+    qint64 m_processMaxNSecs           {0};
+    uint   m_processBlocks             {0};
 };
 
 #endif
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: recordedCaption.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef RECORDEDCAPTION_H_
+#define RECORDEDCAPTION_H_
+
+#include <QString>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC RecordedCaption : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version"    , "1.0" );
+
+    Q_PROPERTY( int       RecordedId READ RecordedId WRITE setRecordedId )
+    Q_PROPERTY( int       Page       READ Page       WRITE setPage       )
+    Q_PROPERTY( QString   Language   READ Language   WRITE setLanguage   )
+    Q_PROPERTY( qlonglong Offset     READ Offset     WRITE setOffset     )
+    Q_PROPERTY( int       Duration   READ Duration   WRITE setDuration   )
+    Q_PROPERTY( QString   Text       READ Text       WRITE setText       )
+
+    PROPERTYIMP    ( int        , RecordedId )
+    PROPERTYIMP    ( int        , Page       )
+    PROPERTYIMP    ( QString    , Language   )
+    PROPERTYIMP    ( qlonglong  , Offset     )
+    PROPERTYIMP    ( int        , Duration   )
+    PROPERTYIMP    ( QString    , Text       )
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE RecordedCaption(QObject *parent = nullptr)
+            : QObject( parent ), m_RecordedId(0), m_Page(0),
+              m_Offset(0), m_Duration(0)
+        {
+        }
+
+        void Copy( const RecordedCaption *src )
+        {
+            m_RecordedId    = src->m_RecordedId ;
+            m_Page          = src->m_Page       ;
+            m_Language      = src->m_Language   ;
+            m_Offset        = src->m_Offset     ;
+            m_Duration      = src->m_Duration   ;
+            m_Text          = src->m_Text       ;
+        }
+
+    private:
+        Q_DISABLE_COPY(RecordedCaption);
+};
+
+inline void RecordedCaption::InitializeCustomTypes()
+{
+    qRegisterMetaType< RecordedCaption* >();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: recordedCaptionList.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef RECORDEDCAPTIONLIST_H_
+#define RECORDEDCAPTIONLIST_H_
+
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "recordedCaption.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC RecordedCaptionList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "Captions", "type=DTC::RecordedCaption");
+
+    Q_PROPERTY( QVariantList Captions READ Captions DESIGNABLE true )
+
+    PROPERTYIMP_RO_REF( QVariantList, Captions );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE RecordedCaptionList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const RecordedCaptionList *src )
+        {
+            CopyListContents< RecordedCaption >( this, m_Captions, src->m_Captions );
+        }
+
+        RecordedCaption *AddNewCaption()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            RecordedCaption *pObject = new RecordedCaption( this );
+            m_Captions.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(RecordedCaptionList);
+};
+
+inline void RecordedCaptionList::InitializeCustomTypes()
+{
+    qRegisterMetaType< RecordedCaptionList* >();
+
+    RecordedCaption::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: storageForecast.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef STORAGEFORECAST_H_
+#define STORAGEFORECAST_H_
+
+#include <QDateTime>
+#include <QString>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+namespace DTC
+{
+
+/////////////////////////////////////////////////////////////////////////////
+// Projected use of one recording file system.  Sizes are in MiB.
+/////////////////////////////////////////////////////////////////////////////
+
+class SERVICE_PUBLIC StorageForecast : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version"    , "1.0" );
+
+    Q_PROPERTY( int        Id            READ Id            WRITE setId            )
+    Q_PROPERTY( QString    Directories   READ Directories   WRITE setDirectories   )
+    Q_PROPERTY( qlonglong  TotalSpace    READ TotalSpace    WRITE setTotalSpace    )
+    Q_PROPERTY( qlonglong  FreeSpace     READ FreeSpace     WRITE setFreeSpace     )
+    Q_PROPERTY( qlonglong  DesiredSpace  READ DesiredSpace  WRITE setDesiredSpace  )
+    Q_PROPERTY( qlonglong  NeededSpace   READ NeededSpace   WRITE setNeededSpace   )
+    Q_PROPERTY( qlonglong  ProjectedFree READ ProjectedFree WRITE setProjectedFree )
+    Q_PROPERTY( int        Recordings    READ Recordings    WRITE setRecordings    )
+    Q_PROPERTY( QDateTime  FullTime      READ FullTime      WRITE setFullTime      )
+
+    PROPERTYIMP    ( int        , Id            )
+    PROPERTYIMP    ( QString    , Directories   )
+    PROPERTYIMP    ( qlonglong  , TotalSpace    )
+    PROPERTYIMP    ( qlonglong  , FreeSpace     )
+    PROPERTYIMP    ( qlonglong  , DesiredSpace  )
+    PROPERTYIMP    ( qlonglong  , NeededSpace   )
+    PROPERTYIMP    ( qlonglong  , ProjectedFree )
+    PROPERTYIMP    ( int        , Recordings    )
+    PROPERTYIMP    ( QDateTime  , FullTime      )
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE StorageForecast(QObject *parent = nullptr)
+            : QObject( parent ), m_Id(0), m_TotalSpace(0), m_FreeSpace(0),
+              m_DesiredSpace(0), m_NeededSpace(0), m_ProjectedFree(0),
+              m_Recordings(0)
+        {
+        }
+
+        void Copy( const StorageForecast *src )
+        {
+            m_Id            = src->m_Id            ;
+            m_Directories   = src->m_Directories   ;
+            m_TotalSpace    = src->m_TotalSpace    ;
+            m_FreeSpace     = src->m_FreeSpace     ;
+            m_DesiredSpace  = src->m_DesiredSpace  ;
+            m_NeededSpace   = src->m_NeededSpace   ;
+            m_ProjectedFree = src->m_ProjectedFree ;
+            m_Recordings    = src->m_Recordings    ;
+            m_FullTime      = src->m_FullTime      ;
+        }
+
+    private:
+        Q_DISABLE_COPY(StorageForecast);
+};
+
+inline void StorageForecast::InitializeCustomTypes()
+{
+    qRegisterMetaType< StorageForecast* >();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: storageForecastList.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef STORAGEFORECASTLIST_H_
+#define STORAGEFORECASTLIST_H_
+
+#include <QDateTime>
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "storageForecast.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC StorageForecastList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "FileSystems", "type=DTC::StorageForecast");
+
+    Q_PROPERTY( QDateTime    StartTime   READ StartTime   WRITE setStartTime )
+    Q_PROPERTY( QDateTime    EndTime     READ EndTime     WRITE setEndTime   )
+    Q_PROPERTY( QVariantList FileSystems READ FileSystems DESIGNABLE true    )
+
+    PROPERTYIMP       ( QDateTime   , StartTime   )
+    PROPERTYIMP       ( QDateTime   , EndTime     )
+    PROPERTYIMP_RO_REF( QVariantList, FileSystems );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE StorageForecastList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const StorageForecastList *src )
+        {
+            m_StartTime = src->m_StartTime;
+            m_EndTime   = src->m_EndTime;
+
+            CopyListContents< StorageForecast >( this, m_FileSystems, src->m_FileSystems );
+        }
+
+        StorageForecast *AddNewFileSystem()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            StorageForecast *pObject = new StorageForecast( this );
+            m_FileSystems.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(StorageForecastList);
+};
+
+inline void StorageForecastList::InitializeCustomTypes()
+{
+    qRegisterMetaType< StorageForecastList* >();
+
+    StorageForecast::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: tuningEvent.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TUNINGEVENT_H_
+#define TUNINGEVENT_H_
+
+#include <QString>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC TuningEvent : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version"    , "1.0" );
+
+    Q_PROPERTY( QString   Name    READ Name     WRITE setName   )
+    Q_PROPERTY( qlonglong Offset  READ Offset   WRITE setOffset )
+
+    PROPERTYIMP    ( QString    , Name   )
+    PROPERTYIMP    ( qlonglong  , Offset )
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE TuningEvent(QObject *parent = nullptr)
+            : QObject( parent ), m_Offset(0)
+        {
+        }
+
+        void Copy( const TuningEvent *src )
+        {
+            m_Name          = src->m_Name   ;
+            m_Offset        = src->m_Offset ;
+        }
+
+    private:
+        Q_DISABLE_COPY(TuningEvent);
+};
+
+inline void TuningEvent::InitializeCustomTypes()
+{
+    qRegisterMetaType< TuningEvent* >();
+}
+
+} // namespace DTC
+
+#endif
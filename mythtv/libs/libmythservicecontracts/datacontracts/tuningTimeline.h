@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: tuningTimeline.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TUNINGTIMELINE_H_
+#define TUNINGTIMELINE_H_
+
+#include <QDateTime>
+#include <QString>
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "tuningEvent.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC TuningTimeline : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "Events", "type=DTC::TuningEvent");
+
+    Q_PROPERTY( int          CardId            READ CardId            WRITE setCardId            )
+    Q_PROPERTY( uint         RecordedId        READ RecordedId        WRITE setRecordedId        )
+    Q_PROPERTY( uint         ChanId            READ ChanId            WRITE setChanId            )
+    Q_PROPERTY( QDateTime    StartTime         READ StartTime         WRITE setStartTime         )
+    Q_PROPERTY( bool         FastChannelChange READ FastChannelChange WRITE setFastChannelChange )
+    Q_PROPERTY( QVariantList Events            READ Events            DESIGNABLE true            )
+
+    PROPERTYIMP    ( int       , CardId            )
+    PROPERTYIMP    ( uint      , RecordedId        )
+    PROPERTYIMP    ( uint      , ChanId            )
+    PROPERTYIMP    ( QDateTime , StartTime         )
+    PROPERTYIMP    ( bool      , FastChannelChange )
+
+    PROPERTYIMP_RO_REF( QVariantList, Events );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE TuningTimeline(QObject *parent = nullptr)
+            : QObject            ( parent ),
+              m_CardId           ( 0      ),
+              m_RecordedId       ( 0      ),
+              m_ChanId           ( 0      ),
+              m_FastChannelChange( false  )
+        {
+        }
+
+        void Copy( const TuningTimeline *src )
+        {
+            m_CardId            = src->m_CardId;
+            m_RecordedId        = src->m_RecordedId;
+            m_ChanId            = src->m_ChanId;
+            m_StartTime         = src->m_StartTime;
+            m_FastChannelChange = src->m_FastChannelChange;
+
+            CopyListContents< TuningEvent >( this, m_Events, src->m_Events );
+        }
+
+        TuningEvent *AddNewEvent()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            TuningEvent *pObject = new TuningEvent( this );
+            m_Events.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(TuningTimeline);
+};
+
+inline void TuningTimeline::InitializeCustomTypes()
+{
+    qRegisterMetaType< TuningTimeline* >();
+
+    TuningEvent::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: tuningTimelineList.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TUNINGTIMELINELIST_H_
+#define TUNINGTIMELINELIST_H_
+
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "tuningTimeline.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC TuningTimelineList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "TuningTimelines", "type=DTC::TuningTimeline");
+
+    Q_PROPERTY( QVariantList TuningTimelines READ TuningTimelines DESIGNABLE true )
+
+    PROPERTYIMP_RO_REF( QVariantList, TuningTimelines );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE TuningTimelineList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const TuningTimelineList *src )
+        {
+            CopyListContents< TuningTimeline >( this, m_TuningTimelines, src->m_TuningTimelines );
+        }
+
+        TuningTimeline *AddNewTuningTimeline()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            TuningTimeline *pObject = new TuningTimeline( this );
+            m_TuningTimelines.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(TuningTimelineList);
+};
+
+inline void TuningTimelineList::InitializeCustomTypes()
+{
+    qRegisterMetaType< TuningTimelineList* >();
+
+    TuningTimeline::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
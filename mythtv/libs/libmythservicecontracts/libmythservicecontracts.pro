@@ -63,6 +63,10 @@ HEADERS += datacontracts/backendInfo.h           datacontracts/envInfo.h
 HEADERS += datacontracts/buildInfo.h             datacontracts/logInfo.h
 HEADERS += datacontracts/genre.h                 datacontracts/genreList.h
 HEADERS += datacontracts/musicMetadataInfo.h     datacontracts/musicMetadataInfoList.h
+HEADERS += datacontracts/tuningEvent.h           datacontracts/tuningTimeline.h
+HEADERS += datacontracts/tuningTimelineList.h
+HEADERS += datacontracts/recordedCaption.h       datacontracts/recordedCaptionList.h
+HEADERS += datacontracts/storageForecast.h       datacontracts/storageForecastList.h
 
 HEADERS += enums/recStatus.h
 
@@ -127,6 +131,10 @@ incDatacontracts.files += datacontracts/enum.h                datacontracts/enum
 incDatacontracts.files += datacontracts/cutting.h             datacontracts/cutList.h
 incDatacontracts.files += datacontracts/backendInfo.h         datacontracts/envInfo.h
 incDatacontracts.files += datacontracts/buildInfo.h           datacontracts/logInfo.h
+incDatacontracts.files += datacontracts/tuningEvent.h         datacontracts/tuningTimeline.h
+incDatacontracts.files += datacontracts/tuningTimelineList.h
+incDatacontracts.files += datacontracts/recordedCaption.h     datacontracts/recordedCaptionList.h
+incDatacontracts.files += datacontracts/storageForecast.h     datacontracts/storageForecastList.h
 
 INSTALLS += inc incServices incDatacontracts incEnums
 
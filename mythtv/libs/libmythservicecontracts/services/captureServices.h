@@ -20,6 +20,7 @@
 
 #include "datacontracts/captureCard.h"
 #include "datacontracts/captureCardList.h"
+#include "datacontracts/tuningTimelineList.h"
 
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
@@ -40,7 +41,7 @@
 class SERVICE_PUBLIC CaptureServices : public Service
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "1.4" );
+    Q_CLASSINFO( "version"    , "1.5" );
     Q_CLASSINFO( "RemoveCaptureCard_Method",                 "POST" )
     Q_CLASSINFO( "AddCaptureCard_Method",                    "POST" )
     Q_CLASSINFO( "UpdateCaptureCard_Method",                 "POST" )
@@ -57,6 +58,7 @@ class SERVICE_PUBLIC CaptureServices : public Service
         {
             DTC::CaptureCard::InitializeCustomTypes();
             DTC::CaptureCardList::InitializeCustomTypes();
+            DTC::TuningTimelineList::InitializeCustomTypes();
         }
 
     public slots:
@@ -120,6 +122,11 @@ class SERVICE_PUBLIC CaptureServices : public Service
         virtual bool                        UpdateCardInput    ( int              CardInputId,
                                                                  const QString    &Setting,
                                                                  const QString    &Value ) = 0;
+
+        // Tuning timelines
+
+        virtual DTC::TuningTimelineList*    GetTuningTimelineList ( int           CardId,
+                                                                    int           Count      ) = 0;
 };
 
 #endif
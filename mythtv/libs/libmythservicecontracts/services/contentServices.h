@@ -39,7 +39,7 @@
 class SERVICE_PUBLIC ContentServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "2.0" );
+    Q_CLASSINFO( "version"    , "2.1" );
     Q_CLASSINFO( "DownloadFile_Method",            "POST" )
 
     public:
@@ -99,6 +99,11 @@ class SERVICE_PUBLIC ContentServices : public Service  //, public QScriptable ??
                                                           int              ChanId,
                                                           const QDateTime &StartTime ) = 0;
 
+        virtual QFileInfo           GetRecordingPlaylist( int              RecordedId,
+                                                          int              ChanId,
+                                                          const QDateTime &StartTime,
+                                                          int              SegmentSize ) = 0;
+
         virtual QFileInfo           GetMusic            ( int Id ) = 0;
         virtual QFileInfo           GetVideo            ( int Id ) = 0;
 
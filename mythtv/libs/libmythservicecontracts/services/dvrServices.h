@@ -25,6 +25,9 @@
 #include "datacontracts/input.h"
 #include "datacontracts/inputList.h"
 #include "datacontracts/cutList.h"
+#include "datacontracts/tuningTimeline.h"
+#include "datacontracts/recordedCaptionList.h"
+#include "datacontracts/storageForecastList.h"
 
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
@@ -45,7 +48,7 @@
 class SERVICE_PUBLIC DvrServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "6.6" )
+    Q_CLASSINFO( "version"    , "6.9" )
     Q_CLASSINFO( "RemoveRecorded_Method",                       "POST" )
     Q_CLASSINFO( "DeleteRecording_Method",                      "POST" )
     Q_CLASSINFO( "UnDeleteRecording",                           "POST" )
@@ -74,6 +77,9 @@ class SERVICE_PUBLIC DvrServices : public Service  //, public QScriptable ???
             DTC::TitleInfoList::InitializeCustomTypes();
             DTC::RecRuleFilterList::InitializeCustomTypes();
             DTC::CutList::InitializeCustomTypes();
+            DTC::TuningTimeline::InitializeCustomTypes();
+            DTC::RecordedCaptionList::InitializeCustomTypes();
+            DTC::StorageForecastList::InitializeCustomTypes();
         }
 
     public slots:
@@ -81,6 +87,8 @@ class SERVICE_PUBLIC DvrServices : public Service  //, public QScriptable ???
         virtual DTC::ProgramList*  GetExpiringList       ( int              StartIndex,
                                                            int              Count      ) = 0;
 
+        virtual DTC::StorageForecastList* GetExpireForecast ( int           Hours      ) = 0;
+
         virtual DTC::ProgramList*  GetRecordedList       ( bool             Descending,
                                                            int              StartIndex,
                                                            int              Count,
@@ -157,6 +165,12 @@ class SERVICE_PUBLIC DvrServices : public Service  //, public QScriptable ???
         virtual DTC::CutList*      GetRecordedSeek       ( int              RecordedId,
                                                            const QString   &OffsetType ) = 0;
 
+        virtual DTC::TuningTimeline* GetRecordedTuningTimeline ( int        RecordedId ) = 0;
+
+        virtual DTC::RecordedCaptionList* GetRecordedCaptionList ( int      RecordedId,
+                                                                   const QString &Text,
+                                                                   int      Count ) = 0;
+
         virtual DTC::ProgramList*  GetConflictList       ( int              StartIndex,
                                                            int              Count,
                                                            int              RecordId ) = 0;
@@ -40,7 +40,7 @@
 class SERVICE_PUBLIC GuideServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "2.4" )
+    Q_CLASSINFO( "version"    , "2.5" )
     Q_CLASSINFO( "AddToChannelGroup_Method",                     "POST" )
     Q_CLASSINFO( "RemoveFromChannelGroup_Method",                "POST" )
 
@@ -83,6 +83,15 @@ class SERVICE_PUBLIC GuideServices : public Service  //, public QScriptable ???
                                                           bool             Descending,
                                                           bool             WithInvisible) = 0;
 
+        virtual DTC::ProgramList*   SearchProgramList   ( int              StartIndex,
+                                                          int              Count,
+                                                          const QString   &Query,
+                                                          const QDateTime &StartTime,
+                                                          const QDateTime &EndTime,
+                                                          int              ChanId,
+                                                          bool             Details,
+                                                          bool             WithInvisible) = 0;
+
         virtual DTC::Program*       GetProgramDetails   ( int              ChanId,
                                                           const QDateTime &StartTime ) = 0;
 
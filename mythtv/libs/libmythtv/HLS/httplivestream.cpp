@@ -24,6 +24,10 @@
 
 // C headers
 #include <cstdio>
+#include <cmath>
+
+// C++ headers
+#include <algorithm>
 
 #include <QDir>
 #include <QFile>
@@ -42,6 +46,7 @@
 #include "exitcodes.h"
 #include "mythlogging.h"
 #include "storagegroup.h"
+#include "programinfo.h"
 #include "httplivestream.h"
 
 #define LOC QString("HLS(%1): ").arg(m_sourceFile)
@@ -1030,4 +1035,138 @@ DTC::LiveStreamInfoList *HTTPLiveStream::GetLiveStreamInfoList(const QString &Fi
     return infoList;
 }
 
+/** \fn HTTPLiveStream::GetPassthroughPlaylist(const ProgramInfo&, const QString&, const QString&, uint16_t)
+ *  \brief Build a playlist which serves an MPEG-TS recording as is
+ *
+ *  Rather than transcoding into segment files, the recording is split into
+ *  segments of roughly segmentSize seconds at keyframes using its seek table,
+ *  and each segment is described as an EXT-X-BYTERANGE of the original file
+ *  (HLS version 4). Clients that can decode the recorded codecs can start
+ *  playing immediately, fetching segments with ordinary range requests.
+ *
+ *  Recordings still in progress get an EVENT playlist without an end tag,
+ *  ending at the last complete segment, which the client reloads.
+ *
+ *  \param pginfo      The recording.
+ *  \param mediaFile   Local path of the recording file.
+ *  \param mediaURL    URL of the recording, relative to the playlist.
+ *  \param segmentSize Target segment duration in seconds.
+ *  \return The playlist, or an empty string if the recording cannot be
+ *          served this way (not MPEG-TS, or no seek table).
+ */
+QString HTTPLiveStream::GetPassthroughPlaylist(const ProgramInfo &pginfo,
+                                               const QString &mediaFile,
+                                               const QString &mediaURL,
+                                               uint16_t segmentSize)
+{
+    QFileInfo finfo(mediaFile);
+
+    // HLS segments must be MPEG-TS
+    if (!finfo.exists() || finfo.suffix().toLower() != "ts")
+        return QString();
+
+    frm_pos_map_t posMap;
+    pginfo.QueryPositionMap(posMap, MARK_GOP_BYFRAME);
+    if (posMap.size() < 2)
+    {
+        LOG(VB_GENERAL, LOG_INFO, SLOC +
+            QString("No seek table for %1, passthrough unavailable")
+                .arg(mediaFile));
+        return QString();
+    }
+
+    // Prefer the real timestamps, otherwise assume a constant frame rate
+    frm_pos_map_t durMap;
+    pginfo.QueryPositionMap(durMap, MARK_DURATION_MS);
+
+    double fps = pginfo.QueryAverageFrameRate() / 1000.0;
+    if (fps < 1.0 || fps > 121.0)
+        fps = 29.97;
+
+    auto frameToMs = [&](long long frame) -> long long
+    {
+        auto it = durMap.constFind(frame);
+        if (it != durMap.constEnd())
+            return it.value();
+        return static_cast<long long>(frame * 1000.0 / fps);
+    };
+
+    if (segmentSize == 0)
+        segmentSize = 6;
+
+    bool inProgress = pginfo.GetRecordingEndTime() > MythDate::current();
+    long long fileSize = finfo.size();
+    long long segmentMs = segmentSize * 1000LL;
+
+    struct Segment
+    {
+        long long m_offset;
+        long long m_length;
+        double    m_duration;
+    };
+    QList<Segment> segments;
+
+    // The first segment starts at the beginning of the file so that it
+    // includes the initial PAT/PMT
+    long long startOffset = 0;
+    long long startMs     = 0;
+
+    for (auto it = posMap.constBegin(); it != posMap.constEnd(); ++it)
+    {
+        long long ms = frameToMs(it.key());
+        if ((ms - startMs) < segmentMs || it.value() <= startOffset)
+            continue;
+
+        segments.append({ startOffset, it.value() - startOffset,
+                          (ms - startMs) / 1000.0 });
+        startOffset = it.value();
+        startMs     = ms;
+    }
+
+    if (!inProgress && fileSize > startOffset)
+    {
+        // Whatever follows the last keyframe
+        long long lastMs = frameToMs(posMap.lastKey()) +
+                           static_cast<long long>(1000.0 / fps);
+        segments.append({ startOffset, fileSize - startOffset,
+                          std::max(lastMs - startMs, 1LL) / 1000.0 });
+    }
+
+    if (segments.isEmpty())
+        return QString();
+
+    double longest = 0.0;
+    foreach (const auto & segment, segments)
+        longest = std::max(longest, segment.m_duration);
+
+    QString playlist = QString(
+        "#EXTM3U\n"
+        "#EXT-X-VERSION:4\n"
+        "#EXT-X-TARGETDURATION:%1\n"
+        "#EXT-X-MEDIA-SEQUENCE:0\n"
+        "#EXT-X-PLAYLIST-TYPE:%2\n")
+        .arg(static_cast<int>(std::ceil(longest)))
+        .arg(inProgress ? "EVENT" : "VOD");
+
+    foreach (const auto & segment, segments)
+    {
+        playlist += QString("#EXTINF:%1,\n"
+                            "#EXT-X-BYTERANGE:%2@%3\n"
+                            "%4\n")
+            .arg(segment.m_duration, 0, 'f', 3)
+            .arg(segment.m_length).arg(segment.m_offset)
+            .arg(mediaURL);
+    }
+
+    if (!inProgress)
+        playlist += "#EXT-X-ENDLIST\n";
+
+    LOG(VB_GENERAL, LOG_INFO, SLOC +
+        QString("Passthrough playlist for %1: %2 segments%3")
+            .arg(mediaFile).arg(segments.size())
+            .arg(inProgress ? " (in progress)" : ""));
+
+    return playlist;
+}
+
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
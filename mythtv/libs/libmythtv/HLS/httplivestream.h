@@ -7,6 +7,8 @@
 
 #include "mythframe.h"
 
+class ProgramInfo;
+
 enum HTTPLiveStreamStatus {
     kHLSStatusUndefined    = -1,
     kHLSStatusQueued       = 0,
@@ -79,6 +81,11 @@ class MTV_PUBLIC HTTPLiveStream
            DTC::LiveStreamInfo     *GetLiveStreamInfo(DTC::LiveStreamInfo *info = nullptr);
     static DTC::LiveStreamInfoList *GetLiveStreamInfoList( const QString &FileName = "");
 
+    static QString GetPassthroughPlaylist(const ProgramInfo &pginfo,
+                                          const QString &mediaFile,
+                                          const QString &mediaURL,
+                                          uint16_t segmentSize = 6);
+
  protected:
     bool        m_writing          {false};
     int         m_streamid         {-1};
@@ -513,6 +513,11 @@ int64_t AudioPlayer::GetAudioBufferedTime(void)
     return m_audioOutput ? m_audioOutput->GetAudioBufferedTime() : 0;
 }
 
+uint AudioPlayer::GetUnderruns(void)
+{
+    return m_audioOutput ? m_audioOutput->GetUnderruns() : 0;
+}
+
 
 bool AudioPlayer::CanProcess(AudioFormat fmt)
 {
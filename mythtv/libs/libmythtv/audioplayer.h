@@ -97,6 +97,7 @@ class MTV_PUBLIC AudioPlayer
     bool GetBufferStatus(uint &fill, uint &total);
     bool IsBufferAlmostFull(void);
     int64_t GetAudioBufferedTime(void);
+    uint GetUnderruns(void);
     
     /**
      * Return internal AudioOutput object
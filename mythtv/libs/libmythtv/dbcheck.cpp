@@ -3786,6 +3786,64 @@ nullptr
             return false;
     }
 
+    if (dbver == "1361")
+    {
+        // Tuning and recording start timeline of each recording
+        const char *updates[] = {
+            "CREATE TABLE IF NOT EXISTS recordedtuning ("
+            "  recordedid INT UNSIGNED NOT NULL,"
+            "  inputid INT UNSIGNED NOT NULL DEFAULT 0,"
+            "  starttime DATETIME NOT NULL,"
+            "  fastchange TINYINT(1) NOT NULL DEFAULT 0,"
+            "  event VARCHAR(32) NOT NULL DEFAULT '',"
+            "  msecs INT NOT NULL DEFAULT 0,"
+            "  PRIMARY KEY (recordedid, event)"
+            ") ENGINE=MyISAM DEFAULT CHARSET=utf8;",
+            nullptr
+        };
+        if (!performActualUpdate(updates, "1362", dbver))
+            return false;
+    }
+
+    if (dbver == "1362")
+    {
+        // Subtitle text extracted while recording, searchable by text
+        const char *updates[] = {
+            "CREATE TABLE IF NOT EXISTS recordedcaption ("
+            "  recordedid INT UNSIGNED NOT NULL,"
+            "  page SMALLINT UNSIGNED NOT NULL DEFAULT 0,"
+            "  language CHAR(3) NOT NULL DEFAULT '',"
+            "  starttime INT UNSIGNED NOT NULL DEFAULT 0,"
+            "  duration INT UNSIGNED NOT NULL DEFAULT 0,"
+            "  caption TEXT NOT NULL,"
+            "  KEY recordedid (recordedid, starttime),"
+            "  FULLTEXT KEY caption (caption)"
+            ") ENGINE=MyISAM DEFAULT CHARSET=utf8;",
+            nullptr
+        };
+        if (!performActualUpdate(updates, "1363", dbver))
+            return false;
+    }
+
+    if (dbver == "1363")
+    {
+        // Word index of the guide data, filled by ProgramSearchIndex
+        const char *updates[] = {
+            "CREATE TABLE IF NOT EXISTS programterm ("
+            "  term VARCHAR(32) NOT NULL,"
+            "  chanid INT UNSIGNED NOT NULL,"
+            "  starttime DATETIME NOT NULL,"
+            "  fields TINYINT UNSIGNED NOT NULL DEFAULT 0,"
+            "  PRIMARY KEY (term, chanid, starttime),"
+            "  KEY program (chanid, starttime)"
+            ") ENGINE=MyISAM DEFAULT CHARSET=utf8;",
+            "DELETE FROM settings WHERE value = 'ProgramSearchIndexReady';",
+            nullptr
+        };
+        if (!performActualUpdate(updates, "1364", dbver))
+            return false;
+    }
+
     return true;
 }
 
@@ -2,6 +2,7 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <fcntl.h>
@@ -12,6 +13,7 @@ using namespace std;
 #include <QFileInfo>
 #include <QRegExp>
 #include <QEvent>
+#include <QThread>
 #include <QCoreApplication>
 
 #include "mythconfig.h"
@@ -89,6 +91,14 @@ void JobQueue::customEvent(QEvent *e)
             return;
         QString message = me->Message();
 
+        if (message == "JOBQUEUE_CHANGE")
+        {
+            // A job was queued or a command sent to one, don't
+            // wait for the next check to pick it up.
+            WakeQueue();
+            return;
+        }
+
         if (message.startsWith("LOCAL_JOB"))
         {
             // LOCAL_JOB action ID jobID
@@ -170,6 +180,9 @@ void JobQueue::ProcessQueue(void)
     QString hostname;
 
     QMap<int, int> jobStatus;
+    QMap<int, int> typesRunning;
+    QMap<QString, int> hostsRunning;
+    QMap<QString, int> recordingHead;
     QString message;
     QMap<int, JobQueueEntry> jobs;
     bool atMax = false;
@@ -200,7 +213,11 @@ void JobQueue::ProcessQueue(void)
         m_runningJobsLock->unlock();
 
         m_jobsRunning = 0;
+        typesRunning.clear();
+        hostsRunning.clear();
+        recordingHead.clear();
         GetJobsInQueue(jobs);
+        SortByPriority(jobs);
 
         if (!jobs.empty())
         {
@@ -210,11 +227,30 @@ void JobQueue::ProcessQueue(void)
                 int status = job.status;
                 hostname = job.hostname;
 
-                if (((status == JOB_RUNNING) ||
-                     (status == JOB_STARTING) ||
-                     (status == JOB_PAUSED)) &&
-                    (hostname == m_hostname))
-                m_jobsRunning++;
+                // Jobs are no longer looked at in queue order, so the
+                // status of every job is needed to tell whether another
+                // job is already running for the same recording.
+                jobStatus[job.id] = status;
+
+                // The job of each recording which may be started next,
+                // none while one is running for it on any host
+                QString recording = QString("%1_%2").arg(job.chanid)
+                                                    .arg(job.startts);
+                if (!recordingHead.contains(recording))
+                    recordingHead[recording] = job.id;
+
+                if ((status == JOB_RUNNING) ||
+                    (status == JOB_STARTING) ||
+                    (status == JOB_PAUSED))
+                {
+                    recordingHead[recording] = 0;
+                    hostsRunning[hostname]++;
+                    if (hostname == m_hostname)
+                    {
+                        m_jobsRunning++;
+                        typesRunning[job.type]++;
+                    }
+                }
             }
 
             message = QString("Currently Running %1 jobs.")
@@ -261,7 +297,21 @@ void JobQueue::ProcessQueue(void)
                 // Should we even be looking at this job?
                 if ((inTimeWindow) &&
                     (!hostname.isEmpty()) &&
-                    (hostname != m_hostname))
+                    (hostname != m_hostname) &&
+                    (CanStealJob(jobs[x], hostsRunning, recordingHead)))
+                {
+                    // Look at it as if it was ours, it is only taken
+                    // from its host once we know we can start it.
+                    message = QString("'%1' job for %2 is waiting on a "
+                                      "busy '%3', considering it here")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo)
+                                      .arg(hostname);
+                    LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
+                    jobs[x].hostname = m_hostname;
+                }
+                else if ((inTimeWindow) &&
+                         (!hostname.isEmpty()) &&
+                         (hostname != m_hostname))
                 {
                     // Setting the status here will prevent us from processing
                     // any other jobs for this recording until this one is
@@ -281,7 +331,8 @@ void JobQueue::ProcessQueue(void)
                 {
                     int otherJobID = GetRunningJobID(jobs[x].chanid,
                                                      jobs[x].recstartts);
-                    if (otherJobID && (jobStatus.contains(otherJobID)) &&
+                    if (otherJobID && (otherJobID != jobID) &&
+                        (jobStatus.contains(otherJobID)) &&
                         (!(jobStatus[otherJobID] & JOB_DONE)))
                     {
                         message =
@@ -427,9 +478,21 @@ void JobQueue::ProcessQueue(void)
                 if (startedJobAlready)
                     continue;
 
+                // Is there room for this job on this backend right now?
+                QString reason;
+                if ((inTimeWindow) && (!AdmitJob(jobs[x], typesRunning, reason)))
+                {
+                    message = QString("Deferring '%1' job for %2, %3")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo)
+                                      .arg(reason);
+                    LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
+                    continue;
+                }
+
+                // Claim the job whether it is unassigned, ours or taken
+                // from a busy host, so no other host can start it too.
                 if ((inTimeWindow) &&
-                    (hostname.isEmpty()) &&
-                    (!ChangeJobHost(jobID, m_hostname)))
+                    (!ClaimJob(jobID, hostname, m_hostname)))
                 {
                     message = QString("Unable to claim '%1' job for %2")
                                       .arg(JobText(jobs[x].type)).arg(logInfo);
@@ -437,6 +500,16 @@ void JobQueue::ProcessQueue(void)
                     continue;
                 }
 
+                if ((inTimeWindow) &&
+                    (!hostname.isEmpty()) &&
+                    (hostname != m_hostname))
+                {
+                    message = QString("Took over '%1' job for %2 from '%3'")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo)
+                                      .arg(hostname);
+                    LOG(VB_GENERAL, LOG_INFO, LOC + message);
+                }
+
                 if (!inTimeWindow)
                 {
                     message = QString("Skipping '%1' job for %2, "
@@ -595,6 +668,8 @@ bool JobQueue::QueueJob(int jobType, uint chanid, const QDateTime &recstartts,
         return false;
     }
 
+    NotifyQueueChanged();
+
     return true;
 }
 
@@ -937,6 +1012,9 @@ bool JobQueue::ChangeJobCmds(int jobID, int newCmds)
         return false;
     }
 
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -959,6 +1037,9 @@ bool JobQueue::ChangeJobCmds(int jobType, uint chanid,
         return false;
     }
 
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -1287,7 +1368,8 @@ int JobQueue::GetJobsInQueue(QMap<int, JobQueueEntry> &jobs, int findJobs)
 
     query.prepare("SELECT j.id, j.chanid, j.starttime, j.inserttime, j.type, "
                       "j.cmds, j.flags, j.status, j.statustime, j.hostname, "
-                      "j.args, j.comment, r.endtime, j.schedruntime "
+                      "j.args, j.comment, r.endtime, j.schedruntime, "
+                      "r.recpriority "
                   "FROM jobqueue j "
                   "LEFT JOIN recorded r "
                   "  ON j.chanid = r.chanid AND j.starttime = r.starttime "
@@ -1375,6 +1457,7 @@ int JobQueue::GetJobsInQueue(QMap<int, JobQueueEntry> &jobs, int findJobs)
         thisJob.hostname = query.value(9).toString();
         thisJob.args = query.value(10).toString();
         thisJob.comment = query.value(11).toString();
+        thisJob.priority = query.value(14).toInt();
 
         if ((thisJob.type & JOB_USERJOB) &&
             (UserJobTypeToIndex(thisJob.type) == 0))
@@ -1424,6 +1507,42 @@ bool JobQueue::ChangeJobHost(int jobID, const QString& newHostname)
     return query.numRowsAffected() > 0;
 }
 
+/** \fn JobQueue::ClaimJob(int, const QString&, const QString&)
+ *  \brief Atomically takes a queued job for a host.
+ *
+ *  The job is only claimed if it is still queued and still assigned to
+ *  \p oldHostname, which is empty for unassigned jobs. This is what keeps
+ *  two backends from starting the same job when jobs are taken from
+ *  busy hosts.
+ */
+bool JobQueue::ClaimJob(int jobID, const QString& oldHostname,
+                        const QString& newHostname)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    query.prepare("UPDATE jobqueue "
+                  "SET hostname = :NEWHOSTNAME, status = :PENDING, "
+                  "    statustime = now() "
+                  "WHERE id = :ID AND hostname = :OLDHOSTNAME AND "
+                  "      status = :QUEUED AND cmds = :RUN;");
+    query.bindValue(":NEWHOSTNAME", newHostname);
+    query.bindValue(":PENDING", JOB_PENDING);
+    query.bindValue(":ID", jobID);
+    query.bindValue(":OLDHOSTNAME", oldHostname);
+    query.bindValue(":QUEUED", JOB_QUEUED);
+    query.bindValue(":RUN", JOB_RUN);
+
+    if (!query.exec())
+    {
+        MythDB::DBError(QString("Error in JobQueue::ClaimJob(), "
+                                "Unable to claim job %1 for '%2'.")
+                                .arg(jobID).arg(newHostname), query);
+        return false;
+    }
+
+    return query.numRowsAffected() > 0;
+}
+
 bool JobQueue::AllowedToRun(const JobQueueEntry& job)
 {
     QString allowSetting;
@@ -1456,6 +1575,193 @@ bool JobQueue::AllowedToRun(const JobQueueEntry& job)
     return gCoreContext->GetBoolSetting(allowSetting, true);
 }
 
+/** \fn JobQueue::AdmitJob(const JobQueueEntry&, const QMap<int,int>&, QString&)
+ *  \brief Admission control, decides whether this backend has room to
+ *         start the job now.
+ *
+ *  Transcodes and commercial detection may be limited to fewer
+ *  simultaneous jobs than the total. Every job except metadata lookups
+ *  and preview generation is deferred while the system load or the
+ *  number of recordings in progress on this backend is above its limit,
+ *  so heavy jobs do not start just as recordings do. Those two are light
+ *  and are wanted as soon as a recording is available.
+ *
+ *  \param typesRunning Number of running jobs of each type on this backend.
+ *  \param reason       Set to the reason the job has to wait.
+ */
+bool JobQueue::AdmitJob(const JobQueueEntry& job,
+                        const QMap<int, int> &typesRunning, QString &reason)
+{
+    QString limitSetting;
+    if (job.type == JOB_TRANSCODE)
+        limitSetting = "JobQueueMaxTranscodeJobs";
+    else if (job.type == JOB_COMMFLAG)
+        limitSetting = "JobQueueMaxCommFlagJobs";
+
+    if (!limitSetting.isEmpty())
+    {
+        int maxOfType = gCoreContext->GetNumSetting(limitSetting, 0);
+        if (maxOfType > 0 && typesRunning.value(job.type) >= maxOfType)
+        {
+            reason = QString("%1 of this type already running")
+                .arg(typesRunning.value(job.type));
+            return false;
+        }
+    }
+
+    if ((job.type == JOB_METADATA) || (job.type == JOB_PREVIEW))
+        return true;
+
+    int maxRecordings = gCoreContext->GetNumSetting("JobQueueMaxRecordings", 0);
+    if (maxRecordings > 0)
+    {
+        int recordings = GetActiveRecordings(m_hostname);
+        if (recordings >= maxRecordings)
+        {
+            reason = QString("%1 recordings in progress").arg(recordings);
+            return false;
+        }
+    }
+
+    int maxLoad = gCoreContext->GetNumSetting("JobQueueMaxLoad", 0);
+    if (maxLoad > 0)
+    {
+        // The limit is a percentage of the available CPUs
+        double load = GetSystemLoad();
+        double limit = maxLoad * std::max(QThread::idealThreadCount(), 1) / 100.0;
+        if (load >= limit)
+        {
+            reason = QString("system load %1 is above %2")
+                .arg(load, 0, 'f', 2).arg(limit, 0, 'f', 2);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** \fn JobQueue::CanStealJob(const JobQueueEntry&, const QMap<QString,int>&)
+ *  \brief Whether a job queued for another backend may be run here.
+ *
+ *  With work stealing enabled, a job assigned to another backend
+ *  may be run by this backend when that backend already runs as many
+ *  jobs as it is allowed to, or has left the job waiting for longer
+ *  than kStealAfterSecs (it may be switched off).
+ *
+ *  Only the first job of a recording is taken, and only while no job
+ *  is running for it anywhere, so the jobs of one recording still run
+ *  one after the other.
+ *
+ *  mythcommflag reads a recording on another backend through the
+ *  backend protocol. Transcodes and user jobs need the file itself, so
+ *  they are only taken when the recording is available locally.
+ *
+ *  \param hostsRunning  Number of jobs running on each backend.
+ *  \param recordingHead ID of the job of each recording which may run
+ *                       next, 0 if one is running.
+ */
+bool JobQueue::CanStealJob(const JobQueueEntry& job,
+                           const QMap<QString, int> &hostsRunning,
+                           const QMap<QString, int> &recordingHead)
+{
+    if (!gCoreContext->GetBoolSetting("JobQueueWorkStealing", false))
+        return false;
+
+    if ((job.status != JOB_QUEUED) || (job.cmds != JOB_RUN) || !job.chanid)
+        return false;
+
+    QString recording = QString("%1_%2").arg(job.chanid).arg(job.startts);
+    if (recordingHead.value(recording) != job.id)
+        return false;
+
+    QDateTime now = MythDate::current();
+    if (job.schedruntime > now)
+        return false;
+
+    int hostMax = gCoreContext->GetNumSettingOnHost(
+        "JobQueueMaxSimultaneousJobs", job.hostname, 3);
+    QDateTime waitingSince = std::max(job.statustime, job.schedruntime);
+    if ((hostsRunning.value(job.hostname) < hostMax) &&
+        (waitingSince.secsTo(now) < kStealAfterSecs))
+        return false;
+
+    if (job.type == JOB_METADATA)
+        return true;
+
+    if (job.type == JOB_COMMFLAG)
+    {
+        QString command = gCoreContext->GetSetting("JobQueueCommFlagCommand");
+        if (command.trimmed().isEmpty() || command == "mythcommflag")
+            return true;
+    }
+
+    ProgramInfo pginfo(job.chanid, job.recstartts);
+    return pginfo.GetChanID() &&
+        !pginfo.GetPlaybackURL(false, true).startsWith("myth://");
+}
+
+/** \fn JobQueue::SortByPriority(QMap<int, JobQueueEntry>&)
+ *  \brief Orders the jobs by the priority of their recordings.
+ *
+ *  The sort is stable, so jobs of the same priority, and in particular
+ *  the jobs of one recording, stay in queue order.
+ */
+void JobQueue::SortByPriority(QMap<int, JobQueueEntry> &jobs)
+{
+    QList<JobQueueEntry> sorted = jobs.values();
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const JobQueueEntry &a, const JobQueueEntry &b)
+                     { return a.priority > b.priority; });
+
+    for (int i = 0; i < sorted.size(); ++i)
+        jobs[i] = sorted[i];
+}
+
+/// Number of recordings currently being made by the given backend.
+int JobQueue::GetActiveRecordings(const QString &hostname)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT COUNT(*) FROM inuseprograms "
+                  "WHERE recusage = :RECUSAGE AND hostname = :HOSTNAME "
+                  "AND lastupdatetime >= :ONEHOURAGO");
+    query.bindValue(":RECUSAGE",   kRecorderInUseID);
+    query.bindValue(":HOSTNAME",   hostname);
+    query.bindValue(":ONEHOURAGO", MythDate::current().addSecs(-61 * 60));
+
+    if (!query.exec() || !query.next())
+    {
+        MythDB::DBError("JobQueue::GetActiveRecordings()", query);
+        return 0;
+    }
+
+    return query.value(0).toInt();
+}
+
+/// The one minute load average, or 0 where it is not available.
+double JobQueue::GetSystemLoad(void)
+{
+#if defined(Q_OS_ANDROID) || defined(_WIN32)
+    return 0.0;
+#else
+    double loads[1];
+    if (getloadavg(loads, 1) == -1)
+        return 0.0;
+    return loads[0];
+#endif
+}
+
+void JobQueue::WakeQueue(void)
+{
+    QMutexLocker locker(&m_queueThreadCondLock);
+    m_queueThreadCond.wakeAll();
+}
+
+/// Tells the job queues on all backends that there is something to do.
+void JobQueue::NotifyQueueChanged(void)
+{
+    gCoreContext->SendMessage("JOBQUEUE_CHANGE");
+}
+
 enum JobCmds JobQueue::GetJobCmd(int jobID)
 {
     MSqlQuery query(MSqlQuery::InitCon());
@@ -1865,6 +2171,9 @@ void JobQueue::RemoveRunningJob(int id)
     }
 
     m_runningJobsLock->unlock();
+
+    // A slot is free, start the next job without waiting for the next check
+    WakeQueue();
 }
 
 QString JobQueue::PrettyPrint(off_t bytes)
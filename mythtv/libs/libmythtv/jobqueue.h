@@ -111,6 +111,7 @@ struct JobQueueEntry {
     QString hostname;
     QString args;
     QString comment;
+    int       priority     {0};  ///< recording priority of the recording
 };
 
 struct RunningJobInfo {
@@ -161,6 +162,8 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     static bool ChangeJobStatus(int jobID, int newStatus,
                                 const QString& comment = "");
     static bool ChangeJobHost(int jobID, const QString& newHostname);
+    static bool ClaimJob(int jobID, const QString& oldHostname,
+                         const QString& newHostname);
     static bool ChangeJobComment(int jobID,
                                  const QString& comment = "");
     static bool ChangeJobArgs(int jobID,
@@ -228,6 +231,17 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     void ProcessJob(const JobQueueEntry& job);
 
     bool AllowedToRun(const JobQueueEntry& job);
+    bool AdmitJob(const JobQueueEntry& job, const QMap<int, int> &typesRunning,
+                  QString &reason);
+    static bool CanStealJob(const JobQueueEntry& job,
+                            const QMap<QString, int> &hostsRunning,
+                            const QMap<QString, int> &recordingHead);
+    static void SortByPriority(QMap<int, JobQueueEntry> &jobs);
+    static int GetActiveRecordings(const QString &hostname);
+    static double GetSystemLoad(void);
+
+    void WakeQueue(void);
+    static void NotifyQueueChanged(void);
 
     static bool InJobRunWindow(int orStartsWithinMins = 0);
 
@@ -270,6 +284,10 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     QWaitCondition             m_queueThreadCond;
     QMutex                     m_queueThreadCondLock;
     bool                       m_processQueue        {false};
+
+    /// Jobs left queued on another backend for longer than this
+    /// may be taken over when work stealing is enabled.
+    static const int           kStealAfterSecs       {30 * 60};
 };
 
 #endif
@@ -207,6 +207,7 @@ HEADERS += mpeg/tsstats.h           mpeg/streamlisteners.h
 HEADERS += mpeg/H264Parser.h
 HEADERS += mpeg/tablestatus.h
 HEADERS += mpeg/tsstreamdata.h
+HEADERS += mpeg/psicache.h
 
 SOURCES += mpeg/tspacket.cpp        mpeg/pespacket.cpp
 SOURCES += mpeg/mpegtables.cpp      mpeg/atsctables.cpp
@@ -224,6 +225,7 @@ SOURCES += mpeg/iso6937tables.cpp
 SOURCES += mpeg/H264Parser.cpp
 SOURCES += mpeg/tablestatus.cpp
 SOURCES += mpeg/tsstreamdata.cpp
+SOURCES += mpeg/psicache.cpp
 
 # Channels, and the multiplexes that transmit them
 HEADERS += frequencies.h            frequencytables.h
@@ -656,20 +658,24 @@ using_backend {
     SOURCES += eitfixup.cpp                eitcache.cpp
 
     # non-EIT EPG stuff
-    HEADERS += programdata.h
-    SOURCES += programdata.cpp
+    HEADERS += programdata.h               programsearchindex.h
+    SOURCES += programdata.cpp             programsearchindex.cpp
 
     # TVRec stuff
     HEADERS += tv_rec.h                    recordingquality.h
+    HEADERS += tuningtimeline.h
     SOURCES += tv_rec.cpp                  recordingquality.cpp
+    SOURCES += tuningtimeline.cpp
 
     # Recorder base and util classes
     HEADERS += recorders/recorderbase.h
     HEADERS += recorders/DeviceReadBuffer.h
     HEADERS += recorders/dtvrecorder.h
+    HEADERS += recorders/captionextractor.h
     SOURCES += recorders/recorderbase.cpp
     SOURCES += recorders/DeviceReadBuffer.cpp
     SOURCES += recorders/dtvrecorder.cpp
+    SOURCES += recorders/captionextractor.cpp
 
     # Import recorder
     HEADERS += recorders/importrecorder.h
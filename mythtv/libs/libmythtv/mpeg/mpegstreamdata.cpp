@@ -1101,6 +1101,16 @@ bool MPEGStreamData::IsAudioPID(uint pid) const
     return it != m_pidsAudio.end();
 }
 
+/** \fn MPEGStreamData::IsInterestingPID(uint) const
+ *  \brief Returns true if ProcessTSPacket() does anything with packets
+ *         on \a pid, so a StreamHandler can skip the others.
+ */
+bool MPEGStreamData::IsInterestingPID(uint pid) const
+{
+    return IsVideoPID(pid) || IsAudioPID(pid) || IsWritingPID(pid) ||
+        IsListeningPID(pid) || IsEncryptionTestPID(pid);
+}
+
 uint MPEGStreamData::GetPIDs(pid_map_t &pids) const
 {
     uint sz = pids.size();
@@ -115,6 +115,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     virtual void HandleTSTables(const TSPacket* tspacket);
     virtual bool ProcessTSPacket(const TSPacket& tspacket);
     virtual int  ProcessData(const unsigned char *buffer, int len);
+    static int ResyncStream(const unsigned char *buffer, int curr_pos, int len);
     inline  void HandleAdaptationFieldControl(const TSPacket* tspacket);
 
     // Listening
@@ -142,6 +143,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     bool IsVideoPID(uint pid) const
         { return m_pidVideoSingleProgram == pid; }
     virtual bool IsAudioPID(uint pid) const;
+    virtual bool IsInterestingPID(uint pid) const;
 
     const pid_map_t& ListeningPIDs(void) const
         { return m_pidsListening; }
@@ -237,6 +239,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     // Program Stream Stuff
     void AddPSStreamListener(PSStreamListener *val);
     void RemovePSStreamListener(PSStreamListener *val);
+    bool HasPSStreamListeners(void) const { return !m_psListeners.empty(); }
 
   public:
     // Single program stuff, sets
@@ -290,8 +293,6 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     void ProcessPMT(const ProgramMapTable *pmt);
     void ProcessEncryptedPacket(const TSPacket &tspacket);
 
-    static int ResyncStream(const unsigned char *buffer, int curr_pos, int len);
-
     void UpdateTimeOffset(uint64_t si_utc_time);
 
     // Caching
@@ -0,0 +1,166 @@
+// -*- Mode: c++ -*-
+
+#include "psicache.h"
+
+// MythTV
+#include "atscstreamdata.h"
+#include "dvbstreamdata.h"
+#include "atsctables.h"
+#include "dvbtables.h"
+#include "mythlogging.h"
+#include "mythdate.h"
+
+#define LOC QString("PSICache: ")
+
+static const int kMaxEntries = 256;
+static const int kMaxAgeSecs = 24 * 60 * 60;
+
+QMutex                         PSICache::s_lock;
+QHash<QString,PSICache::Entry> PSICache::s_entries;
+
+void PSICache::AddSection(Entry &entry, uint pid, const PSIPTable &psip)
+{
+    Section section;
+    section.m_pid  = pid;
+    section.m_data = QByteArray(reinterpret_cast<const char*>(psip.pesdata()),
+                                psip.SectionLength());
+    entry.m_sections.push_back(section);
+}
+
+/** \fn PSICache::Store(const QString&, int, const MPEGStreamData*)
+ *  \brief Copies the tables describing program \a progNum out of the
+ *         table cache of \a sd, replacing anything stored under \a key.
+ *
+ *   The stream data must have table caching enabled.
+ */
+void PSICache::Store(const QString &key, int progNum, const MPEGStreamData *sd)
+{
+    if (key.isEmpty() || !sd || progNum < 0)
+        return;
+
+    Entry entry;
+    uint pmt_pid = 0;
+
+    pat_vec_t pats = sd->GetCachedPATs();
+    for (const auto *pat : pats)
+    {
+        AddSection(entry, MPEG_PAT_PID, *pat);
+        if (!pmt_pid)
+            pmt_pid = pat->FindPID(progNum);
+    }
+    sd->ReturnCachedPATTables(pats);
+
+    pmt_const_ptr_t pmt = sd->GetCachedPMT(progNum, 0);
+    if (pmt && pmt_pid)
+        AddSection(entry, pmt_pid, *pmt);
+    if (pmt)
+        sd->ReturnCachedTable(pmt);
+
+    // Without a PAT and PMT there is nothing to gain on the next tune.
+    if (entry.m_sections.size() < 2)
+        return;
+
+    const auto *dsd = dynamic_cast<const DVBStreamData*>(sd);
+    if (dsd)
+    {
+        sdt_vec_t sdts = dsd->GetCachedSDTs();
+        for (const auto *sdt : sdts)
+        {
+            if (sdt->TableID() == TableID::SDT)
+                AddSection(entry, DVB_SDT_PID, *sdt);
+        }
+        dsd->ReturnCachedSDTTables(sdts);
+    }
+
+    const auto *asd = dynamic_cast<const ATSCStreamData*>(sd);
+    if (asd)
+    {
+        // The VCT goes last, matching it is what makes the ATSC signal
+        // monitor look for the PAT and PMT already stored above.
+        tvct_const_ptr_t tvct = asd->GetCachedTVCT(ATSC_PSIP_PID);
+        if (tvct)
+        {
+            AddSection(entry, ATSC_PSIP_PID, *tvct);
+            asd->ReturnCachedTable(tvct);
+        }
+        cvct_const_ptr_t cvct = asd->GetCachedCVCT(ATSC_PSIP_PID);
+        if (cvct)
+        {
+            AddSection(entry, ATSC_PSIP_PID, *cvct);
+            asd->ReturnCachedTable(cvct);
+        }
+    }
+
+    entry.m_stored = MythDate::current();
+
+    QMutexLocker locker(&s_lock);
+    if (!s_entries.contains(key) && s_entries.size() >= kMaxEntries)
+    {
+        auto oldest = s_entries.begin();
+        for (auto it = s_entries.begin(); it != s_entries.end(); ++it)
+        {
+            if (it->m_stored < oldest->m_stored)
+                oldest = it;
+        }
+        s_entries.erase(oldest);
+    }
+    s_entries[key] = entry;
+
+    LOG(VB_CHANNEL, LOG_DEBUG, LOC + QString("Stored %1 sections for %2")
+        .arg(entry.m_sections.size()).arg(key));
+}
+
+/** \fn PSICache::Apply(const QString&, MPEGStreamData*, bool)
+ *  \brief Feeds the tables stored under \a key into \a sd as though they
+ *         had just been received.
+ *
+ *   This must be called after the signal monitor has been attached to the
+ *   stream data and told which program to look for.
+ *
+ *  \param includeSDT Set to false to skip the SDT, which also signals
+ *                    that a DiSEqC rotor has reached its position.
+ *  \return Number of sections applied.
+ */
+uint PSICache::Apply(const QString &key, MPEGStreamData *sd, bool includeSDT)
+{
+    if (key.isEmpty() || !sd)
+        return 0;
+
+    Entry entry;
+    {
+        QMutexLocker locker(&s_lock);
+        auto it = s_entries.find(key);
+        if (it == s_entries.end())
+            return 0;
+        if (it->m_stored.secsTo(MythDate::current()) > kMaxAgeSecs)
+        {
+            s_entries.erase(it);
+            return 0;
+        }
+        entry = *it;
+    }
+
+    uint applied = 0;
+    const QVector<Section> &sections = entry.m_sections;
+    for (const auto &section : sections)
+    {
+        PSIPTable psip(reinterpret_cast<const unsigned char*>(
+                           section.m_data.constData()));
+        if (!includeSDT && psip.TableID() == TableID::SDT)
+            continue;
+        sd->HandleTables(section.m_pid, psip);
+        applied++;
+    }
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC + QString("Applied %1 cached sections for %2")
+        .arg(applied).arg(key));
+
+    return applied;
+}
+
+/// Forget the tables stored under \a key, e.g. after they failed to lock.
+void PSICache::Invalidate(const QString &key)
+{
+    QMutexLocker locker(&s_lock);
+    s_entries.remove(key);
+}
@@ -0,0 +1,57 @@
+// -*- Mode: c++ -*-
+#ifndef PSICACHE_H_
+#define PSICACHE_H_
+
+// Qt
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// MythTV
+#include "mythtvexp.h"
+
+class MPEGStreamData;
+class PSIPTable;
+
+/** \class PSICache
+ *  \brief Remembers the PSI tables last seen on each channel.
+ *
+ *   When fast channel change is enabled TVRec stores the PAT, PMT and
+ *   SDT (or VCT for ATSC) of a channel once the signal monitor reports
+ *   a good lock. On the next tune to that channel the saved sections are
+ *   fed into the MPEGStreamData before the frontend locks, so PID filtering
+ *   can start immediately instead of waiting for the tables to be
+ *   rebroadcast. Any table with a new version that arrives from the
+ *   stream still replaces the cached copy in the usual way.
+ */
+class MTV_PUBLIC PSICache
+{
+  public:
+    static void Store(const QString &key, int progNum,
+                      const MPEGStreamData *sd);
+    static uint Apply(const QString &key, MPEGStreamData *sd,
+                      bool includeSDT = true);
+    static void Invalidate(const QString &key);
+
+  private:
+    struct Section
+    {
+        uint       m_pid {0};
+        QByteArray m_data;
+    };
+    struct Entry
+    {
+        QVector<Section> m_sections;
+        QDateTime        m_stored;
+    };
+
+    static void AddSection(Entry &entry, uint pid, const PSIPTable &psip);
+
+    static QMutex               s_lock;
+    static QHash<QString,Entry> s_entries;
+};
+
+#endif // PSICACHE_H_
@@ -4833,6 +4833,8 @@ void MythPlayer::GetPlaybackData(InfoMap &infoMap)
     infoMap.insert("buffersize",  QString::number(m_playerCtx->m_buffer->GetBufferSize() >> 20));
     int avsync = m_avsyncAvg / 1000;
     infoMap.insert("avsync", tr("%1 ms").arg(avsync));
+    infoMap.insert("audiounderruns", QString::number(m_audio.GetUnderruns()));
+    infoMap.insert("audiolatency", tr("%1 ms").arg(m_audio.GetAudioBufferedTime()));
 
     if (m_videoOutput)
     {
@@ -12,6 +12,7 @@ using namespace std;
 
 // MythTV headers
 #include "programdata.h"
+#include "programsearchindex.h"
 #include "channelutil.h"
 #include "mythdb.h"
 #include "mythlogging.h"
@@ -810,6 +811,9 @@ uint DBEvent::UpdateDB(
         return 0;
     }
 
+    ProgramSearchIndex::IndexProgram(query, chanid, m_starttime,
+                                     ltitle, lsubtitle, ldesc);
+
     if (m_credits)
     {
         for (auto & credit : *m_credits)
@@ -894,7 +898,7 @@ static bool delete_program(MSqlQuery &query, uint chanid, const QDateTime &st)
         return false;
     }
 
-    return true;
+    return ProgramSearchIndex::RemovePrograms(query, chanid, st, st.addSecs(1));
 }
 
 static bool program_exists(MSqlQuery &query, uint chanid, const QDateTime &st)
@@ -981,7 +985,7 @@ static bool change_program(MSqlQuery &query, uint chanid, const QDateTime &st,
         return false;
     }
 
-    return true;
+    return ProgramSearchIndex::MoveProgram(query, chanid, st, new_st);
 }
 
 // Move the program "prog" (3rd parameter) out of the way
@@ -1118,6 +1122,9 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid) const
         return 0;
     }
 
+    ProgramSearchIndex::IndexProgram(query, chanid, m_starttime,
+                                     m_title, m_subtitle, m_description);
+
     foreach (const auto & rating, m_ratings)
     {
         query.prepare(
@@ -1286,6 +1293,9 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid) const
         return 0;
     }
 
+    ProgramSearchIndex::IndexProgram(query, chanid, m_starttime,
+                                     m_title, m_subtitle, m_description);
+
     for (const auto & rating : m_ratings)
     {
         query.prepare(
@@ -1356,6 +1366,8 @@ bool ProgramData::ClearDataByChannel(
     query.bindValue(":CHANID", chanid);
     ok &= query.exec();
 
+    ok &= ProgramSearchIndex::RemovePrograms(query, chanid, newFrom, newTo);
+
     return ok;
 }
 
@@ -0,0 +1,293 @@
+// -*- Mode: c++ -*-
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QMap>
+
+// MythTV headers
+#include "programsearchindex.h"
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "mythdate.h"
+#include "mythdb.h"
+
+#define LOC QString("ProgramSearchIndex: ")
+
+/** \class ProgramSearchIndex
+ *  \brief Inverted index of the words in the guide data.
+ *
+ *   Every word of a program's title, subtitle and description is stored
+ *   once per program in the programterm table, together with a mask of
+ *   the fields it came from. The table's primary key starts with the term,
+ *   so a search for a word or the beginning of a word is a range scan of
+ *   the index instead of a LIKE '%...%' scan of every program.
+ *
+ *   The index is kept up to date as programs are inserted, updated, moved
+ *   and removed by ProgramData, which covers both mythfilldatabase and the
+ *   EIT scanner. Build() indexes the whole program table the first time,
+ *   and until it has finished IsReady() returns false and searches fall
+ *   back to LIKE.
+ *
+ *   Only the beginnings of words are matched, so the index does not
+ *   replace the substring matching of the program guide's own search
+ *   screens. It is used by Guide/SearchProgramList, which ranks matches by
+ *   the field and by whether whole words matched.
+ *
+ *   MySQL's FULLTEXT search, as used for recorded captions by
+ *   Dvr/GetRecordedCaptionList, has no such per field weighting of matches
+ *   and is not used for the guide data.
+ */
+
+/**
+ *  \brief Splits text into the terms stored in the index.
+ *
+ *  Terms are lower case with accents removed, so that searches are
+ *  insensitive to both. Anything which is not a letter or a digit
+ *  separates terms.
+ */
+QStringList ProgramSearchIndex::Tokenize(const QString &text)
+{
+    QStringList terms;
+    QString term;
+
+    QString folded = text.normalized(QString::NormalizationForm_KD).toLower();
+    for (QChar c : folded)
+    {
+        if (c.isLetterOrNumber())
+        {
+            term += c;
+            continue;
+        }
+        if (c.category() == QChar::Mark_NonSpacing)
+            continue;
+        if (term.size() >= kMinTermLength)
+            terms << term.left(kMaxTermLength);
+        term.clear();
+    }
+    if (term.size() >= kMinTermLength)
+        terms << term.left(kMaxTermLength);
+
+    return terms;
+}
+
+/**
+ *  \brief Indexes the words of one program.
+ *
+ *  \param replace If true the existing terms of the program are removed
+ *                 first. Only Build() which starts from an empty table
+ *                 passes false.
+ */
+bool ProgramSearchIndex::IndexProgram(
+    MSqlQuery &query, uint chanid, const QDateTime &starttime,
+    const QString &title, const QString &subtitle,
+    const QString &description, bool replace)
+{
+    if (replace)
+    {
+        query.prepare("DELETE FROM programterm "
+                      "WHERE chanid = :CHANID AND starttime = :STARTTIME");
+        query.bindValue(":CHANID",    chanid);
+        query.bindValue(":STARTTIME", starttime);
+        if (!query.exec())
+        {
+            MythDB::DBError("ProgramSearchIndex::IndexProgram delete", query);
+            return false;
+        }
+    }
+
+    QMap<QString, uint> terms;
+    for (const auto &term : Tokenize(title))
+        terms[term] |= kTitle;
+    for (const auto &term : Tokenize(subtitle))
+        terms[term] |= kSubtitle;
+    for (const auto &term : Tokenize(description))
+        terms[term] |= kDescription;
+
+    if (terms.isEmpty())
+        return true;
+
+    // One multi row insert per program
+    QString sql = "INSERT IGNORE INTO programterm "
+                  "    (term, chanid, starttime, fields) VALUES ";
+    int i = 0;
+    for (auto it = terms.cbegin(); it != terms.cend(); ++it, ++i)
+    {
+        if (i)
+            sql += ", ";
+        sql += QString("(:TERM%1, %2, :START%1, %3)")
+            .arg(i).arg(chanid).arg(*it);
+    }
+
+    query.prepare(sql);
+    i = 0;
+    for (auto it = terms.cbegin(); it != terms.cend(); ++it, ++i)
+    {
+        query.bindValue(QString(":TERM%1").arg(i),  it.key());
+        query.bindValue(QString(":START%1").arg(i), starttime);
+    }
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramSearchIndex::IndexProgram insert", query);
+        return false;
+    }
+
+    return true;
+}
+
+/// Follows a program whose start time was changed.
+bool ProgramSearchIndex::MoveProgram(
+    MSqlQuery &query, uint chanid,
+    const QDateTime &oldstart, const QDateTime &newstart)
+{
+    query.prepare("UPDATE programterm "
+                  "SET starttime = :NEWSTART "
+                  "WHERE chanid    = :CHANID AND "
+                  "      starttime = :OLDSTART");
+    query.bindValue(":CHANID",   chanid);
+    query.bindValue(":OLDSTART", oldstart);
+    query.bindValue(":NEWSTART", newstart);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramSearchIndex::MoveProgram", query);
+        return false;
+    }
+    return true;
+}
+
+/// Removes the terms of the programs starting in [from, to) on a channel.
+bool ProgramSearchIndex::RemovePrograms(
+    MSqlQuery &query, uint chanid, const QDateTime &from, const QDateTime &to)
+{
+    query.prepare("DELETE FROM programterm "
+                  "WHERE starttime >= :FROM AND starttime < :TO "
+                  "AND chanid = :CHANID");
+    query.bindValue(":CHANID", chanid);
+    query.bindValue(":FROM",   from);
+    query.bindValue(":TO",     to);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramSearchIndex::RemovePrograms", query);
+        return false;
+    }
+    return true;
+}
+
+/// True once Build() has indexed all existing programs.
+bool ProgramSearchIndex::IsReady(void)
+{
+    return gCoreContext->GetBoolSetting("ProgramSearchIndexReady", false);
+}
+
+/**
+ *  \brief Rebuilds the index from the whole program table.
+ *  \return The number of programs indexed.
+ */
+uint ProgramSearchIndex::Build(void)
+{
+    LOG(VB_GENERAL, LOG_INFO, LOC + "Building program search index");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    if (!query.exec("TRUNCATE TABLE programterm"))
+    {
+        MythDB::DBError("ProgramSearchIndex::Build truncate", query);
+        return 0;
+    }
+
+    MSqlQuery insert(MSqlQuery::InitCon());
+    query.setForwardOnly(true);
+    query.prepare("SELECT chanid, starttime, title, subtitle, description "
+                  "FROM program");
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramSearchIndex::Build select", query);
+        return 0;
+    }
+
+    uint count = 0;
+    while (query.next())
+    {
+        if (IndexProgram(insert, query.value(0).toUInt(),
+                         MythDate::as_utc(query.value(1).toDateTime()),
+                         query.value(2).toString(),
+                         query.value(3).toString(),
+                         query.value(4).toString(), false))
+        {
+            count++;
+        }
+    }
+
+    gCoreContext->SaveSettingOnHost("ProgramSearchIndexReady", "1", "");
+    gCoreContext->SendMessage("CLEAR_SETTINGS_CACHE");
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Indexed %1 programs in %2 seconds")
+        .arg(count).arg(timer.elapsed() / 1000));
+
+    return count;
+}
+
+void ProgramSearchIndex::BuildIfNeeded(void)
+{
+    if (!IsReady())
+        Build();
+}
+
+/**
+ *  \brief Builds the SQL to find programs matching a search phrase.
+ *
+ *  Each term of the phrase must match the beginning of a word in one
+ *  of the given fields. The result is one JOIN per term to be placed
+ *  before the WHERE of a program query, and a ranking expression for
+ *  use with GROUP BY program.chanid, program.starttime which favours
+ *  title matches and whole words.
+ *
+ *  \param alias Prefix for the table aliases and bindings, so that
+ *               several phrases can be used in one query.
+ *  \return false if the phrase contains no searchable terms.
+ */
+bool ProgramSearchIndex::BuildJoin(
+    const QString &phrase, uint fields, const QString &alias,
+    QString &join, QString &rank, MSqlBindings &bindings)
+{
+    QStringList terms = Tokenize(phrase);
+    terms.removeDuplicates();
+    if (terms.isEmpty())
+        return false;
+
+    if (terms.size() > kMaxSearchTerms)
+        terms = terms.mid(0, kMaxSearchTerms);
+
+    join.clear();
+    QStringList ranks;
+    for (int i = 0; i < terms.size(); ++i)
+    {
+        QString table = QString("%1%2").arg(alias).arg(i);
+        QString bind  = QString(":%1TERM%2").arg(alias.toUpper()).arg(i);
+
+        join += QString(
+            "JOIN programterm %1 ON "
+            "  %1.chanid = program.chanid AND "
+            "  %1.starttime = program.starttime AND "
+            "  %1.term LIKE %2 AND "
+            "  (%1.fields & %3) <> 0 ")
+            .arg(table).arg(bind).arg(fields & kAllFields);
+        bindings[bind] = terms[i] + '%';
+
+        // The term starts with the search term, so it is the
+        // whole word if it has the same length.
+        ranks << QString(
+            "MAX(CASE WHEN %1.fields & %2 THEN 8 "
+            "         WHEN %1.fields & %3 THEN 3 ELSE 1 END + "
+            "    CASE WHEN CHAR_LENGTH(%1.term) = %4 THEN 2 ELSE 0 END)")
+            .arg(table).arg(kTitle).arg(kSubtitle).arg(terms[i].size());
+    }
+    rank = ranks.join(" + ");
+
+    return true;
+}
@@ -0,0 +1,54 @@
+// -*- Mode: c++ -*-
+#ifndef PROGRAM_SEARCH_INDEX_H
+#define PROGRAM_SEARCH_INDEX_H
+
+// Qt headers
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+
+// MythTV headers
+#include "mythtvexp.h"
+#include "mythdbcon.h"
+
+class MTV_PUBLIC ProgramSearchIndex
+{
+  public:
+    /// Program fields a term was found in, stored as a bit mask.
+    enum Field
+    {
+        kTitle       = 0x01,
+        kSubtitle    = 0x02,
+        kDescription = 0x04,
+        kAllFields   = 0x07,
+    };
+
+    static QStringList Tokenize(const QString &text);
+
+    static bool IndexProgram(MSqlQuery &query, uint chanid,
+                             const QDateTime &starttime,
+                             const QString &title, const QString &subtitle,
+                             const QString &description, bool replace = true);
+    static bool MoveProgram(MSqlQuery &query, uint chanid,
+                            const QDateTime &oldstart,
+                            const QDateTime &newstart);
+    static bool RemovePrograms(MSqlQuery &query, uint chanid,
+                               const QDateTime &from, const QDateTime &to);
+
+    static bool IsReady(void);
+    static uint Build(void);
+    static void BuildIfNeeded(void);
+
+    static bool BuildJoin(const QString &phrase, uint fields,
+                          const QString &alias, QString &join,
+                          QString &rank, MSqlBindings &bindings);
+
+    /// Terms shorter than this are not indexed
+    static const int kMinTermLength {2};
+    /// Terms are cut to the size of the programterm.term column
+    static const int kMaxTermLength {32};
+    /// Only this many terms of a search phrase are used
+    static const int kMaxSearchTerms {6};
+};
+
+#endif // PROGRAM_SEARCH_INDEX_H
@@ -778,13 +778,9 @@ void ExternalStreamHandler::run(void)
         if (!m_listenerLock.tryLock())
             continue;
 
-        for (auto sit = m_streamDataList.cbegin();
-             sit != m_streamDataList.cend(); ++sit)
-        {
-            remainder = sit.key()->ProcessData
-                        (reinterpret_cast<const uint8_t *>
-                         (buffer.constData()), buffer.size());
-        }
+        remainder = DistributePackets(
+            reinterpret_cast<const uint8_t *>(buffer.constData()),
+            buffer.size());
 
         m_listenerLock.unlock();
 
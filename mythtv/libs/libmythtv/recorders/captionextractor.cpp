@@ -0,0 +1,369 @@
+// -*- Mode: c++ -*-
+
+// MythTV headers
+#include "captionextractor.h"
+#include "srtwriter.h"
+#include "vbilut.h"
+#include "iso639.h"
+#include "mythdbcon.h"
+#include "mythdb.h"
+#include "mythlogging.h"
+
+#define LOC QString("CaptionExtractor[%1]: ").arg(m_recordedId)
+
+CaptionExtractor::CaptionExtractor(uint recordedid, const QString &filename,
+                                   int64_t startpts) :
+    MThread("CaptionExtractor"),
+    m_recordedId(recordedid),
+    m_fileName(filename),
+    m_startPts(startpts)
+{
+    m_queue.reserve(256);
+}
+
+CaptionExtractor::~CaptionExtractor()
+{
+    Finish();
+
+    for (auto *stream : m_streams)
+        delete stream;
+    m_streams.clear();
+}
+
+/** \fn CaptionExtractor::AddPage(uint,int,int)
+ *  \brief Adds a teletext subtitle page to decode from the given PID.
+ *
+ *  The first page added is the one written to the subtitle file.
+ *  Pages which are already known are ignored.
+ */
+void CaptionExtractor::AddPage(uint pid, int page, int language)
+{
+    QMutexLocker locker(&m_lock);
+    m_newPages.push_back({pid, page, language});
+}
+
+/** \fn CaptionExtractor::AddTSPacket(const TSPacket&)
+ *  \brief Queues a copy of a teletext packet for the extractor thread.
+ *
+ *  This never blocks on the decoder; if the thread falls too far
+ *  behind the packet is dropped.
+ */
+void CaptionExtractor::AddTSPacket(const TSPacket &tspacket)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_queue.size() >= kMaxQueued)
+    {
+        m_dropped++;
+        return;
+    }
+    m_queue.push_back(tspacket);
+    m_wait.wakeAll();
+}
+
+/** \fn CaptionExtractor::Finish(void)
+ *  \brief Decodes whatever is still queued, writes out the last
+ *         subtitles and stops the extractor thread.
+ */
+void CaptionExtractor::Finish(void)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_finishing = true;
+        m_wait.wakeAll();
+    }
+    wait();
+}
+
+void CaptionExtractor::run(void)
+{
+    RunProlog();
+
+    LOG(VB_RECORD, LOG_INFO, LOC + QString("Extracting subtitles to '%1'")
+        .arg(m_fileName));
+
+    std::vector<TSPacket> packets;
+    packets.reserve(256);
+
+    while (true)
+    {
+        QList<NewPage> pages;
+        bool finishing = false;
+        {
+            QMutexLocker locker(&m_lock);
+            while (m_queue.empty() && m_newPages.isEmpty() && !m_finishing)
+                m_wait.wait(&m_lock);
+            packets.swap(m_queue);
+            pages.swap(m_newPages);
+            finishing = m_finishing;
+        }
+
+        for (const auto &np : pages)
+        {
+            CaptionStream *&stream = m_streams[np.m_pid];
+            if (!stream)
+                stream = new CaptionStream();
+            if (stream->m_pages.contains(np.m_page))
+                continue;
+
+            CaptionPage &cpage = stream->m_pages[np.m_page];
+            cpage.m_language = np.m_language;
+            cpage.m_sidecar = !m_haveSidecar;
+            m_haveSidecar = true;
+
+            LOG(VB_RECORD, LOG_INFO, LOC +
+                QString("Teletext subtitles on PID 0x%1 page %2 (%3)%4")
+                .arg(np.m_pid, 0, 16).arg(np.m_page, 3, 16)
+                .arg(iso639_key_to_str3(np.m_language))
+                .arg(cpage.m_sidecar ? " written to subtitle file" : ""));
+        }
+
+        for (const auto &tspacket : packets)
+            ProcessPacket(tspacket);
+        packets.clear();
+
+        WriteSubtitles(finishing);
+
+        if (finishing)
+            break;
+    }
+
+    delete m_srtWriter;
+    m_srtWriter = nullptr;
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Finished, %1 subtitles saved, %2 packets dropped")
+        .arg(m_saved).arg(m_dropped));
+
+    RunEpilog();
+}
+
+void CaptionExtractor::ProcessPacket(const TSPacket &tspacket)
+{
+    auto it = m_streams.find(tspacket.PID());
+    if (it == m_streams.end() || !tspacket.HasPayload())
+        return;
+
+    CaptionStream &stream = **it;
+
+    // A lost packet corrupts the PES it belongs to, so drop it
+    uint cc = tspacket.ContinuityCounter();
+    if (stream.m_continuity != 0xff &&
+        ((stream.m_continuity + 1) & 0xf) != cc)
+    {
+        stream.m_pes.clear();
+    }
+    stream.m_continuity = cc;
+
+    uint offset = tspacket.AFCOffset();
+    if (offset >= TSPacket::kSize)
+        return;
+
+    const auto *payload = reinterpret_cast<const char*>(tspacket.data()) + offset;
+    int len = TSPacket::kSize - offset;
+
+    if (tspacket.PayloadStart())
+    {
+        if (!stream.m_pes.isEmpty())
+            ProcessPES(stream);
+        stream.m_pes = QByteArray(payload, len);
+    }
+    else if (!stream.m_pes.isEmpty())
+    {
+        stream.m_pes.append(payload, len);
+    }
+
+    // Teletext PES always carry their length, so a complete
+    // one can be decoded without waiting for the next.
+    if (stream.m_pes.size() >= 6)
+    {
+        const auto *pes = reinterpret_cast<const uint8_t*>(stream.m_pes.constData());
+        int pes_len = (pes[4] << 8) | pes[5];
+        if (pes_len && stream.m_pes.size() >= 6 + pes_len)
+        {
+            stream.m_pes.truncate(6 + pes_len);
+            ProcessPES(stream);
+        }
+    }
+}
+
+void CaptionExtractor::ProcessPES(CaptionStream &stream)
+{
+    const auto *buf = reinterpret_cast<const uint8_t*>(stream.m_pes.constData());
+    const uint8_t *buf_end = buf + stream.m_pes.size();
+
+    if ((buf_end - buf) < 9 || buf[0] != 0x00 || buf[1] != 0x00 ||
+        buf[2] != 0x01 || buf[3] != 0xBD)
+    {
+        stream.m_pes.clear();
+        return;
+    }
+
+    // Take the presentation time of the PES as the current time
+    if ((buf[7] & 0x80) && (buf_end - buf) >= 14)
+    {
+        int64_t pts = ((uint64_t(buf[ 9] & 0x0e) << 29) |
+                       (uint64_t(buf[10]       ) << 22) |
+                       (uint64_t(buf[11] & 0xfe) << 14) |
+                       (uint64_t(buf[12]       ) <<  7) |
+                       (uint64_t(buf[13] & 0xfe) >>  1));
+        int64_t diff = (pts - m_startPts) & 0x1ffffffffLL;
+        // Anything more than half the PTS range is before the start
+        if (diff < 0x100000000LL)
+            m_curTime = diff / 90;
+    }
+
+    buf += 9 + buf[8];
+
+    // data_identifier 0x10 - 0x1F is EBU teletext
+    if (buf < buf_end && (*buf & 0xf0) == 0x10)
+        buf++;
+
+    while (buf + 2 <= buf_end)
+    {
+        uint unit_id  = buf[0];
+        uint unit_len = buf[1];
+        if (unit_id == 0xff)
+            break; // stuffing up to the end of the PES
+        if (buf + 2 + unit_len > buf_end)
+            break;
+        if ((unit_id == 0x02 || unit_id == 0x03) && unit_len >= 44)
+        {
+            stream.m_decoder.Decode(
+                buf + 4, (unit_id == 0x02) ? VBI_DVB : VBI_DVB_SUBTITLE);
+        }
+        buf += 2 + unit_len;
+    }
+
+    stream.m_pes.clear();
+
+    IngestPages(stream);
+}
+
+static QStringList to_string_list(const TeletextSubPage &subPage)
+{
+    QStringList content;
+    // Skip the page header (line 0)
+    for (int i = 1; i < 25; ++i)
+    {
+        QString str = decode_teletext(subPage.lang, subPage.data[i]).trimmed();
+        if (!str.isEmpty())
+            content += str;
+    }
+    return content;
+}
+
+void CaptionExtractor::IngestPages(CaptionStream &stream)
+{
+    using qpii = QPair<int, int>;
+    QSet<qpii> updatedPages = stream.m_reader.GetUpdatedPages();
+    if (updatedPages.isEmpty())
+        return;
+
+    for (auto it = updatedPages.constBegin(); it != updatedPages.constEnd(); ++it)
+    {
+        auto pit = stream.m_pages.find((*it).first);
+        if (pit == stream.m_pages.end())
+            continue;
+
+        stream.m_reader.SetPage((*it).first, (*it).second);
+        TeletextSubPage *subpage = stream.m_reader.FindSubPage();
+        if (subpage && subpage->subtitle)
+            IngestSubtitle(*pit, to_string_list(*subpage));
+    }
+
+    stream.m_reader.ClearUpdatedPages();
+}
+
+/// Same as MythCCExtractorPlayer::IngestSubtitle() for text subtitles
+void CaptionExtractor::IngestSubtitle(
+    CaptionPage &page, const QStringList &content) const
+{
+    QList<OneSubtitle> &list = page.m_subs;
+
+    if (!list.isEmpty() && m_curTime == list.back().m_startTime &&
+        !content.isEmpty())
+    {
+        list.back().m_text = content;
+        return;
+    }
+
+    OneSubtitle last_one = list.isEmpty() ? OneSubtitle() : list.back();
+    if (content != last_one.m_text || last_one.m_length >= 0)
+    {
+        // Finish previous subtitle.
+        if (!last_one.m_text.isEmpty() && last_one.m_length < 0)
+            list.back().m_length =
+                static_cast<int>(m_curTime - last_one.m_startTime);
+
+        // Put new one if it isn't empty.
+        if (!content.isEmpty())
+        {
+            OneSubtitle new_one;
+            new_one.m_startTime = m_curTime;
+            new_one.m_text = content;
+            list.push_back(new_one);
+        }
+    }
+}
+
+/** \fn CaptionExtractor::WriteSubtitles(bool)
+ *  \brief Writes out every subtitle whose end is known.
+ *
+ *  When finalizing, the subtitles still on screen are given the
+ *  default length and written too.
+ */
+void CaptionExtractor::WriteSubtitles(bool finalize)
+{
+    for (auto *stream : m_streams)
+    {
+        for (auto it = stream->m_pages.begin(); it != stream->m_pages.end(); ++it)
+        {
+            QList<OneSubtitle> &subs = (*it).m_subs;
+            while (!subs.isEmpty())
+            {
+                OneSubtitle &sub = subs.front();
+                if (sub.m_length < 0 && !finalize)
+                    break;
+                if (sub.m_length <= 0)
+                    sub.m_length = OneSubtitle::kDefaultLength;
+
+                if ((*it).m_sidecar)
+                {
+                    if (!m_srtWriter)
+                        m_srtWriter = new SRTWriter(m_fileName);
+                    if (m_srtWriter->IsOpen())
+                        m_srtWriter->AddSubtitle(sub, ++m_srtCount);
+                }
+
+                SaveCaption(it.key(), *it, sub);
+                subs.pop_front();
+            }
+        }
+    }
+
+    if (m_srtWriter)
+        m_srtWriter->Flush();
+}
+
+void CaptionExtractor::SaveCaption(int page, const CaptionPage &cpage,
+                                   const OneSubtitle &sub)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("INSERT INTO recordedcaption "
+                  "    (recordedid, page, language, starttime, duration, "
+                  "     caption) "
+                  "VALUES "
+                  "    (:RECORDEDID, :PAGE, :LANGUAGE, :START, :DURATION, "
+                  "     :CAPTION)");
+    query.bindValue(":RECORDEDID", m_recordedId);
+    query.bindValue(":PAGE",       page);
+    query.bindValue(":LANGUAGE",   iso639_key_to_str3(cpage.m_language));
+    query.bindValue(":START",      static_cast<qlonglong>(sub.m_startTime));
+    query.bindValue(":DURATION",   sub.m_length);
+    query.bindValue(":CAPTION",    sub.m_text.join("\n"));
+
+    if (!query.exec())
+        MythDB::DBError("CaptionExtractor::SaveCaption", query);
+    else
+        m_saved++;
+}
@@ -0,0 +1,111 @@
+// -*- Mode: c++ -*-
+#ifndef CAPTIONEXTRACTOR_H
+#define CAPTIONEXTRACTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include <QWaitCondition>
+#include <QStringList>
+#include <QByteArray>
+#include <QString>
+#include <QMutex>
+#include <QList>
+#include <QMap>
+
+#include "mthread.h"
+#include "tspacket.h"
+#include "teletextdecoder.h"
+#include "teletextextractorreader.h"
+#include "mythccextractorplayer.h" // for OneSubtitle
+
+class SRTWriter;
+
+/** \class CaptionExtractor
+ *  \brief Decodes DVB teletext subtitles while a recording is being made.
+ *
+ *  DTVRecorder hands over a copy of every teletext TS packet it writes.
+ *  The packets are queued and decoded on a separate thread, so the
+ *  recorder never waits on the decoder or on the database.
+ *
+ *  Subtitles of the first subtitle page are written to a SubRip file
+ *  next to the recording, which the player picks up automatically.
+ *  The text of every subtitle page is stored in the recordedcaption
+ *  table, which has a full-text index for searching inside recordings.
+ */
+class CaptionExtractor : public MThread
+{
+  public:
+    CaptionExtractor(uint recordedid, const QString &filename,
+                     int64_t startpts);
+    ~CaptionExtractor() override;
+
+    void AddPage(uint pid, int page, int language);
+    void AddTSPacket(const TSPacket &tspacket);
+    void Finish(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    class CaptionPage
+    {
+      public:
+        int                m_language  {0};
+        bool               m_sidecar   {false};
+        QList<OneSubtitle> m_subs;
+    };
+
+    class CaptionStream
+    {
+      public:
+        CaptionStream() : m_decoder(&m_reader) {}
+
+        TeletextExtractorReader m_reader;
+        TeletextDecoder         m_decoder;
+        QByteArray              m_pes;
+        uint                    m_continuity {0xff};
+        QMap<int, CaptionPage>  m_pages;
+    };
+
+    class NewPage
+    {
+      public:
+        uint m_pid;
+        int  m_page;
+        int  m_language;
+    };
+
+    void ProcessPacket(const TSPacket &tspacket);
+    void ProcessPES(CaptionStream &stream);
+    void IngestPages(CaptionStream &stream);
+    void IngestSubtitle(CaptionPage &page, const QStringList &content) const;
+    void WriteSubtitles(bool finalize);
+    void SaveCaption(int page, const CaptionPage &cpage,
+                     const OneSubtitle &sub);
+
+    uint                         m_recordedId;
+    QString                      m_fileName;
+    int64_t                      m_startPts;
+    int64_t                      m_curTime     {0};  ///< msecs into file
+
+    QMutex                       m_lock;
+    QWaitCondition               m_wait;
+    std::vector<TSPacket>        m_queue;
+    QList<NewPage>               m_newPages;
+    bool                         m_finishing   {false};
+    uint                         m_dropped     {0};
+
+    // Only touched by the extractor thread
+    QMap<uint, CaptionStream*>   m_streams;
+    bool                         m_haveSidecar {false};
+    SRTWriter                   *m_srtWriter   {nullptr};
+    int                          m_srtCount    {0};
+    uint                         m_saved       {0};
+
+    /// Packets queued beyond this are dropped rather than
+    /// letting a stalled database grow the queue without bound.
+    static const uint            kMaxQueued    {20000};
+};
+
+#endif // CAPTIONEXTRACTOR_H
@@ -18,6 +18,8 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <QFileInfo>
+
 #include "atscstreamdata.h"
 #include "mpegstreamdata.h"
 #include "dvbstreamdata.h"
@@ -28,6 +30,9 @@
 #include "ringbuffer.h"
 #include "tv_rec.h"
 #include "mythsystemevent.h"
+#include "tuningtimeline.h"
+#include "dvbdescriptors.h"
+#include "captionextractor.h"
 
 #define LOC ((m_tvrec) ? \
     QString("DTVRec[%1]: ").arg(m_tvrec->GetInputId()) : \
@@ -53,6 +58,8 @@ DTVRecorder::DTVRecorder(TVRec *rec) :
 
     m_minimumRecordingQuality =
         gCoreContext->GetNumSetting("MinimumRecordingQuality", 95);
+    m_extractCaptions =
+        gCoreContext->GetBoolSetting("RecordingCaptions", false);
 
     m_containerFormat = formatMPEG2_TS;
 
@@ -62,6 +69,7 @@ DTVRecorder::DTVRecorder(TVRec *rec) :
 DTVRecorder::~DTVRecorder(void)
 {
     StopRecording();
+    StopCaptionExtractor();
 
     DTVRecorder::SetStreamData(nullptr);
 
@@ -118,6 +126,8 @@ void DTVRecorder::FinishRecording(void)
     if (m_ringBuffer)
         m_ringBuffer->WriterFlush();
 
+    StopCaptionExtractor();
+
     if (m_curRecording)
     {
         SetDuration((int64_t)(m_totalDuration * 1000));
@@ -155,6 +165,8 @@ void DTVRecorder::ResetForNewFile(void)
     m_progressiveSequence        = 0;
     m_repeatPict                 = 0;
 
+    m_captionStartPts            = -1;
+
     //m_pes_synced
     //m_seen_sps
     m_positionMap.clear();
@@ -251,6 +263,11 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
             m_timeOfFirstData = MythDate::current();
             m_timeOfLatestData = MythDate::current();
             m_timeOfLatestDataTimer.start();
+            if (m_tvrec)
+            {
+                TuningTimeline::Mark(m_tvrec->GetInputId(),
+                                     TuningTimeline::kFirstWrite);
+            }
         }
 
         int val = m_timeOfLatestDataCount.fetchAndAddRelaxed(1);
@@ -778,6 +795,11 @@ void DTVRecorder::HandleKeyframe(int64_t extra)
     {
         m_firstKeyframe = frameNum;
         SendMythSystemRecEvent("REC_STARTED_WRITING", m_curRecording);
+        if (m_tvrec)
+        {
+            TuningTimeline::Mark(m_tvrec->GetInputId(),
+                                 TuningTimeline::kFirstKeyframe);
+        }
     }
 
     // Add key frame to position map
@@ -1014,6 +1036,11 @@ void DTVRecorder::HandleH264Keyframe(void)
         m_firstKeyframe = frameNum;
         startpos = 0;
         SendMythSystemRecEvent("REC_STARTED_WRITING", m_curRecording);
+        if (m_tvrec)
+        {
+            TuningTimeline::Mark(m_tvrec->GetInputId(),
+                                 TuningTimeline::kFirstKeyframe);
+        }
     }
     else
         startpos = m_h264Parser.keyframeAUstreamOffset();
@@ -1404,6 +1431,9 @@ void DTVRecorder::HandleSingleProgramPMT(ProgramMapTable *pmt, bool insert)
     if (pmt->PCRPID() != 0x1fff && pmt->FindPID(pmt->PCRPID()) == -1)
         m_streamId[pmt->PCRPID()] = StreamID::PrivSec;
 
+    if (m_extractCaptions)
+        FindCaptionPages(pmt);
+
     if (!m_ringBuffer)
         return;
 
@@ -1474,6 +1504,9 @@ bool DTVRecorder::ProcessTSPacket(const TSPacket &tspacket)
             return true;
     }
 
+    if (m_captionPages.contains(pid))
+        HandleCaptionPacket(tspacket);
+
     BufferedWrite(tspacket);
 
     return true;
@@ -1570,11 +1603,110 @@ bool DTVRecorder::ProcessAVTSPacket(const TSPacket &tspacket)
             QString("PID 0x%1 Found Payload Start").arg(pid,0,16));
     }
 
+    // Subtitle times are relative to the first PES written
+    if (m_captionStartPts < 0 && !m_captionPages.isEmpty() &&
+        tspacket.PayloadStart())
+    {
+        uint offset = tspacket.AFCOffset();
+        const uint8_t *pes = tspacket.data() + offset;
+        if (offset + 9 < TSPacket::kSize &&
+            pes[0] == 0x00 && pes[1] == 0x00 && pes[2] == 0x01)
+        {
+            m_captionStartPts = extract_timestamp(
+                pes + 4, TSPacket::kSize - offset - 4, kExtractPTS);
+        }
+    }
+
     BufferedWrite(tspacket);
 
     return true;
 }
 
+/** \fn DTVRecorder::FindCaptionPages(const ProgramMapTable*)
+ *  \brief Collects the DVB teletext subtitle pages listed in the PMT.
+ */
+void DTVRecorder::FindCaptionPages(const ProgramMapTable *pmt)
+{
+    m_captionPages.clear();
+
+    for (uint i = 0; i < pmt->StreamCount(); ++i)
+    {
+        if (pmt->StreamType(i) != StreamID::PrivData)
+            continue;
+
+        const desc_list_t desc_list = MPEGDescriptor::ParseOnlyInclude(
+            pmt->StreamInfo(i), pmt->StreamInfoLength(i),
+            DescriptorID::teletext);
+
+        for (const auto *desc : desc_list)
+        {
+            const TeletextDescriptor td(desc);
+            if (!td.IsValid())
+                continue;
+
+            for (uint k = 0; k < td.StreamCount(); ++k)
+            {
+                // 2 is subtitles, 5 is subtitles for the hearing impaired
+                uint type = td.TeletextType(k);
+                if (type != 2 && type != 5)
+                    continue;
+
+                int magazine = td.TeletextMagazineNum(k);
+                if (magazine == 0)
+                    magazine = 8;
+                int page = (magazine << 8) | td.TeletextPageNum(k);
+                int language = td.CanonicalLanguageKey(k);
+
+                m_captionPages[pmt->StreamPID(i)].push_back(
+                    qMakePair(page, language));
+                if (m_captionExtractor)
+                {
+                    m_captionExtractor->AddPage(
+                        pmt->StreamPID(i), page, language);
+                }
+            }
+        }
+    }
+}
+
+/** \fn DTVRecorder::HandleCaptionPacket(const TSPacket&)
+ *  \brief Passes a teletext packet that is about to be written
+ *         on to the caption extractor, starting it if needed.
+ */
+void DTVRecorder::HandleCaptionPacket(const TSPacket &tspacket)
+{
+    if (!m_captionExtractor)
+    {
+        // Wait until the file has a start time and a recording
+        if (m_captionStartPts < 0 || !m_curRecording || !m_ringBuffer)
+            return;
+
+        QFileInfo fi(m_ringBuffer->GetFilename());
+        QString srtfile = fi.path() + "/" + fi.completeBaseName() + ".srt";
+
+        m_captionExtractor = new CaptionExtractor(
+            m_curRecording->GetRecordingID(), srtfile, m_captionStartPts);
+        for (auto it = m_captionPages.cbegin(); it != m_captionPages.cend(); ++it)
+        {
+            for (const auto &page : *it)
+                m_captionExtractor->AddPage(it.key(), page.first, page.second);
+        }
+        m_captionExtractor->start();
+    }
+
+    m_captionExtractor->AddTSPacket(tspacket);
+}
+
+void DTVRecorder::StopCaptionExtractor(void)
+{
+    if (!m_captionExtractor)
+        return;
+
+    m_captionExtractor->Finish();
+    delete m_captionExtractor;
+    m_captionExtractor = nullptr;
+}
+
 RecordingQuality *DTVRecorder::GetRecordingQuality(const RecordingInfo *r) const
 {
     RecordingQuality *recq = RecorderBase::GetRecordingQuality(r);
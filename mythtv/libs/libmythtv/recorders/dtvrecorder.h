@@ -15,6 +15,9 @@ using namespace std;
 
 #include <QAtomicInt>
 #include <QString>
+#include <QList>
+#include <QPair>
+#include <QMap>
 
 #include "streamlisteners.h"
 #include "recorderbase.h"
@@ -23,6 +26,7 @@ using namespace std;
 class MPEGStreamData;
 class TSPacket;
 class StreamID;
+class CaptionExtractor;
 
 class DTVRecorder :
     public RecorderBase,
@@ -122,6 +126,11 @@ class DTVRecorder :
 
     inline bool CheckCC(uint pid, uint new_cnt);
 
+    // Teletext subtitle extraction
+    void FindCaptionPages(const ProgramMapTable *pmt);
+    void HandleCaptionPacket(const TSPacket &tspacket);
+    void StopCaptionExtractor(void);
+
     virtual QString GetSIStandard(void) const { return "mpeg"; }
     virtual void SetCAMPMT(const ProgramMapTable */*pmt*/) {}
     virtual void UpdateCAMTimeOffset(void) {}
@@ -200,6 +209,14 @@ class DTVRecorder :
     uint64_t                 m_tdTickCount                {0};
     FrameRate                m_tdTickFramerate            {0};
 
+    // Teletext subtitle extraction
+    bool                     m_extractCaptions            {false};
+    /// subtitle pages wanted on each PID, as (page, language) pairs
+    QMap<uint, QList<QPair<int,int> > > m_captionPages;
+    CaptionExtractor        *m_captionExtractor           {nullptr};
+    /// PTS of the first audio/video PES written to the current file
+    int64_t                  m_captionStartPts            {-1};
+
     // Music Choice
     // Comcast Music Choice uses 3 frames every 6 seconds and no key frames
     bool                     m_musicChoice                {false};
@@ -10,6 +10,7 @@ using namespace std;
 #include "atsctables.h"
 #include "dvbtables.h"
 #include "compat.h"
+#include "tuningtimeline.h"
 
 #undef DBG_SM
 #define DBG_SM(FUNC, MSG) LOG(VB_CHANNEL, LOG_INFO, \
@@ -296,6 +297,7 @@ void DTVSignalMonitor::HandlePAT(const ProgramAssociationTable *pat)
     if (GetStreamData() && pmt_pid)
     {
         AddFlags(kDTVSigMon_PATMatch);
+        TuningTimeline::Mark(m_inputid, TuningTimeline::kFirstPAT);
         GetStreamData()->AddListeningPID(pmt_pid);
         insert_crc(m_seen_table_crc, *pat);
         return;
@@ -384,6 +386,7 @@ void DTVSignalMonitor::HandlePMT(uint /*program_num*/, const ProgramMapTable *pm
             AddFlags(kDTVSigMon_WaitForCrypt);
 
         AddFlags(kDTVSigMon_PMTMatch);
+        TuningTimeline::Mark(m_inputid, TuningTimeline::kFirstPMT);
     }
     else
     {
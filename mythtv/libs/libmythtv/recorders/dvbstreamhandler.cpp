@@ -23,6 +23,11 @@
 
 #define LOC      QString("DVBSH[%1](%2): ").arg(m_inputId).arg(m_device)
 
+/// Pseudo PID that makes the demux pass the full transport stream
+static const uint kFullTSPID         = 0x2000;
+/// Free filters needed before leaving full TS mode, to avoid flapping
+static const uint kFullTSHysteresis  = 2;
+
 QMap<QString,bool> DVBStreamHandler::s_recSupportsTsMonitoring;
 QMutex             DVBStreamHandler::s_rec_supportsTsMonitoringLock;
 
@@ -108,6 +113,11 @@ DVBStreamHandler::DVBStreamHandler(const QString &dvb_device, int inputid)
     setObjectName("DVBRead");
 }
 
+DVBStreamHandler::~DVBStreamHandler()
+{
+    delete m_fullTSFilter;
+}
+
 void DVBStreamHandler::run(void)
 {
     RunProlog();
@@ -197,6 +207,13 @@ void DVBStreamHandler::RunTS(void)
 
     LOG(VB_RECORD, LOG_DEBUG, LOC + "RunTS(): begin");
 
+    {
+        QMutexLocker locker(&m_pidLock);
+        m_filterModeTimer.start();
+    }
+    PIDFilterTable pid_filter;
+    bool use_pid_filter = false;
+
     fd_set fd_select_set;
     FD_ZERO(        &fd_select_set); // NOLINT(readability-isolate-declaration)
     FD_SET (dvr_fd, &fd_select_set);
@@ -205,6 +222,14 @@ void DVBStreamHandler::RunTS(void)
         RetuneMonitor();
         UpdateFiltersFromStreamData();
 
+        {
+            // A full multiplex recording wants every packet
+            QMutexLocker read_locker(&m_pidLock);
+            use_pid_filter = m_fullTS && !m_pidInfo.contains(kFullTSPID);
+            if (use_pid_filter)
+                pid_filter = m_pidFilterTable;
+        }
+
         ssize_t len = 0;
 
         if (drb)
@@ -262,8 +287,8 @@ void DVBStreamHandler::RunTS(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
+        remainder = DistributePackets(buffer, len,
+                                      use_pid_filter ? &pid_filter : nullptr);
 
         WriteMPTS(buffer, len - remainder);
 
@@ -276,6 +301,13 @@ void DVBStreamHandler::RunTS(void)
 
     RemoveAllPIDFilters();
 
+    {
+        QMutexLocker locker(&m_pidLock);
+        if (m_fullTS)
+            SetFullTS(false);
+        LogFilterStats();
+    }
+
     {
         QMutexLocker locker(&m_startStopLock);
         m_drb = nullptr;
@@ -377,9 +409,142 @@ static pid_list_t::iterator find(
     return list.end();
 }
 
+/** \brief Opens the hardware filter for \a info, remembering how many
+ *         filters the demux had room for when this first fails.
+ */
+bool DVBStreamHandler::OpenFilter(PIDInfo *info)
+{
+    if (info->Open(m_device, m_usingSectionReader))
+        return true;
+
+    m_filterOpenFailures++;
+    if (m_openPidFilters < m_filterLimit)
+    {
+        m_filterLimit = m_openPidFilters;
+        LOG(VB_RECORD, LOG_INFO, LOC +
+            QString("Demux has room for %1 PID filters").arg(m_filterLimit));
+    }
+
+    return false;
+}
+
+/** \brief Switches between a hardware filter per PID and reading the full
+ *         transport stream, as needed for the PIDs currently wanted.
+ *
+ *   Full TS mode is entered when more PIDs are wanted than the demux had
+ *   room for when a filter last failed to open. The packets are then
+ *   filtered in software using m_pidFilterTable. We go back to hardware
+ *   filters once the wanted PIDs fit again, so USB and other bandwidth
+ *   limited devices only carry the full multiplex when they must. When a
+ *   full multiplex recording wants kFullTSPID nothing is filtered out.
+ *
+ *   \note The m_pidLock must be held when this is called.
+ *   \return true if in full TS mode.
+ */
+bool DVBStreamHandler::UpdateFilterMode(void)
+{
+    // The section reader needs a filter per table PID
+    if (m_usingSectionReader || m_fullTSUnsupported)
+        return false;
+
+    uint wanted = m_pidInfo.size();
+    if (m_fullTS && (wanted + kFullTSHysteresis <= m_filterLimit))
+        SetFullTS(false);
+    else if (!m_fullTS && (wanted > m_filterLimit))
+        SetFullTS(true);
+
+    if (!m_fullTS || m_pidInfo.contains(kFullTSPID))
+        return m_fullTS;
+
+    m_pidFilterTable.reset();
+    for (auto it = m_pidInfo.cbegin(); it != m_pidInfo.cend(); ++it)
+    {
+        if (it.key() < kFullTSPID)
+            m_pidFilterTable.set(it.key());
+    }
+
+    return true;
+}
+
+/// \note The m_pidLock must be held when this is called.
+void DVBStreamHandler::SetFullTS(bool full_ts)
+{
+    UpdateFilterModeTime();
+
+    if (!full_ts)
+    {
+        if (m_fullTSFilter)
+            m_fullTSFilter->Close(m_device);
+        m_fullTS = false;
+
+        LOG(VB_RECORD, LOG_INFO, LOC +
+            QString("Leaving full TS mode, %1 PIDs wanted")
+                .arg(m_pidInfo.size()));
+        return;
+    }
+
+    // Release the per PID filters, the full TS filter needs one too
+    for (auto it = m_pidInfo.begin(); it != m_pidInfo.end(); ++it)
+    {
+        if ((*it)->IsOpen())
+        {
+            (*it)->Close(m_device);
+            m_openPidFilters--;
+        }
+    }
+
+    if (!m_fullTSFilter)
+        m_fullTSFilter = new DVBPIDInfo(kFullTSPID);
+
+    if (!m_fullTSFilter->Open(m_device, false))
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            "Demux can not pass the full TS, cycling PID filters instead");
+        m_fullTSUnsupported = true;
+        return;
+    }
+
+    m_fullTS = true;
+    m_fullTSSwitches++;
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Entering full TS mode, %1 PIDs wanted with room for %2")
+            .arg(m_pidInfo.size()).arg(m_filterLimit));
+}
+
+/// Adds the time since the last call to the current filter mode.
+void DVBStreamHandler::UpdateFilterModeTime(void)
+{
+    if (!m_filterModeTimer.isRunning())
+        return;
+
+    if (m_fullTS)
+        m_fullTSMsecs += m_filterModeTimer.restart();
+    else
+        m_perPIDMsecs += m_filterModeTimer.restart();
+}
+
+void DVBStreamHandler::LogFilterStats(void)
+{
+    UpdateFilterModeTime();
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("PID filtering: %1 s with hardware filters, %2 s in full TS "
+                "mode, %3 switches to full TS, %4 failed filter opens")
+            .arg(m_perPIDMsecs / 1000).arg(m_fullTSMsecs / 1000)
+            .arg(m_fullTSSwitches).arg(m_filterOpenFailures));
+}
+
 void DVBStreamHandler::CycleFiltersByPriority(void)
 {
     QMutexLocker writing_locker(&m_pidLock);
+
+    if (UpdateFilterMode())
+    {
+        m_cycleTimer.start();
+        return;
+    }
+
     QMap<PIDPriority, pid_list_t> priority_queue;
     QMap<PIDPriority, uint> priority_open_cnt;
 
@@ -413,7 +578,7 @@ void DVBStreamHandler::CycleFiltersByPriority(void)
             if (closed == priority_queue[i].end())
                 break; // something is broken
 
-            if (m_pidInfo[*closed]->Open(m_device, m_usingSectionReader))
+            if (OpenFilter(m_pidInfo[*closed]))
             {
                 m_openPidFilters++;
                 priority_open_cnt[i]++;
@@ -446,8 +611,7 @@ void DVBStreamHandler::CycleFiltersByPriority(void)
             if (freed)
             {
                 // if we can open a filter, just do it
-                if (m_pidInfo[*closed]->Open(
-                        m_device, m_usingSectionReader))
+                if (OpenFilter(m_pidInfo[*closed]))
                 {
                     m_openPidFilters++;
                     priority_open_cnt[i]++;
@@ -469,8 +633,7 @@ void DVBStreamHandler::CycleFiltersByPriority(void)
             priority_open_cnt[i]--;
 
             // open "closed"
-            if (ok && m_pidInfo[*closed]->
-                Open(m_device, m_usingSectionReader))
+            if (ok && OpenFilter(m_pidInfo[*closed]))
             {
                 m_openPidFilters++;
                 priority_open_cnt[i]++;
@@ -48,12 +48,18 @@ class DVBStreamHandler : public StreamHandler
 
   private:
     explicit DVBStreamHandler(const QString &dvb_device, int inputid);
+    ~DVBStreamHandler() override;
 
     void run(void) override; // MThread
     void RunTS(void);
     void RunSR(void);
 
     void CycleFiltersByPriority(void) override; // StreamHandler
+    bool OpenFilter(PIDInfo *info);
+    bool UpdateFilterMode(void);
+    void SetFullTS(bool full_ts);
+    void UpdateFilterModeTime(void);
+    void LogFilterStats(void);
 
     bool SupportsTSMonitoring(void);
 
@@ -68,6 +74,22 @@ class DVBStreamHandler : public StreamHandler
     DVBChannel       *m_dvbChannel;
     DeviceReadBuffer *m_drb;
 
+    // Full TS mode, used once the demux runs out of PID filters.
+    // All of these are protected by m_pidLock.
+    bool              m_fullTS              {false};
+    bool              m_fullTSUnsupported   {false};
+    DVBPIDInfo       *m_fullTSFilter        {nullptr};
+    /// Number of PID filters open when opening one more first failed
+    uint              m_filterLimit         {UINT_MAX};
+    PIDFilterTable    m_pidFilterTable;
+
+    // Filter mode statistics
+    uint              m_filterOpenFailures  {0};
+    uint              m_fullTSSwitches      {0};
+    MythTimer         m_filterModeTimer;
+    qint64            m_perPIDMsecs         {0};
+    qint64            m_fullTSMsecs         {0};
+
     // for caching TS monitoring supported value.
     static QMutex             s_rec_supportsTsMonitoringLock;
     static QMap<QString,bool> s_recSupportsTsMonitoring;
@@ -187,8 +187,7 @@ void HLSStreamHandler::run(void)
 
         {
             QMutexLocker locker(&m_listenerLock);
-            for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-                remainder = sit.key()->ProcessData(m_readbuffer, size);
+            remainder = DistributePackets(m_readbuffer, size);
         }
 
         if (remainder > 0)
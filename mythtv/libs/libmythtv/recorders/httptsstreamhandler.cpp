@@ -212,11 +212,7 @@ void HTTPReader::WriteBytes()
     int remainder = 0;
     {
         QMutexLocker locker(&m_parent->m_listenerLock);
-        for (auto sit = m_parent->m_streamDataList.cbegin();
-             sit != m_parent->m_streamDataList.cend(); ++sit)
-        {
-            remainder = sit.key()->ProcessData(m_buffer, m_size);
-        }
+        remainder = m_parent->DistributePackets(m_buffer, m_size);
     }
     LOG(VB_RECORD, LOG_DEBUG, LOC + QString("WriteBytes: %1/%2 bytes remain").arg(remainder).arg(m_size));
 
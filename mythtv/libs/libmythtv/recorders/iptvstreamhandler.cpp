@@ -433,13 +433,9 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
         {
             QMutexLocker locker(&m_parent->m_listenerLock);
             QByteArray &data = packet.GetDataReference();
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    reinterpret_cast<const unsigned char*>(data.data()),
-                    data.size());
-            }
+            remainder = m_parent->DistributePackets(
+                reinterpret_cast<const unsigned char*>(data.data()),
+                data.size());
         }
 
         if (remainder != 0)
@@ -491,13 +487,8 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
 
             m_parent->m_listenerLock.lock();
 
-            int remainder = 0;
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    ts_packet.GetTSData(), ts_packet.GetTSDataSize());
-            }
+            int remainder = m_parent->DistributePackets(
+                ts_packet.GetTSData(), ts_packet.GetTSDataSize());
 
             m_parent->m_listenerLock.unlock();
 
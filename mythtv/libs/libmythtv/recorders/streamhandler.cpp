@@ -346,6 +346,105 @@ PIDPriority StreamHandler::GetPIDPriority(uint pid) const
     return tmp;
 }
 
+/** \brief Hands the TS packets in \a buffer to all the listeners.
+ *
+ *   The packet boundaries are found once for the whole multiplex, then
+ *   each packet is passed in place to only those listeners that want its
+ *   PID. This replaces calling MPEGStreamData::ProcessData() on every
+ *   listener, which resyncs and looks up every packet again for each
+ *   recording sharing the multiplex.
+ *
+ *   When \a pidFilter is given, packets on PIDs it does not have set are
+ *   dropped before any listener is consulted.
+ *
+ *   \note The m_listenerLock must be held when this is called.
+ *   \return Number of bytes at the end of \a buffer that were not
+ *           processed because they do not make up a whole packet.
+ */
+int StreamHandler::DistributePackets(const unsigned char *buffer, int len,
+                                     const PIDFilterTable *pidFilter)
+{
+    int remainder = 0;
+
+    // Program stream listeners need the unsplit data
+    m_tsListeners.clear();
+    for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
+    {
+        if (it.key()->HasPSStreamListeners())
+            remainder = it.key()->ProcessData(buffer, len);
+        else
+            m_tsListeners.push_back(it.key());
+    }
+
+    if (m_tsListeners.empty())
+        return remainder;
+
+    // Listeners may have changed their PIDs since the last batch
+    m_pidListeners.clear();
+
+    int pos = 0;
+    bool resync = false;
+
+    while (pos + int(TSPacket::kSize) <= len)
+    { // while we have a whole packet left...
+        if (buffer[pos] != SYNC_BYTE || resync)
+        {
+            int newpos = MPEGStreamData::ResyncStream(buffer, pos+1, len);
+            LOG(VB_RECORD, LOG_DEBUG, LOC +
+                QString("Resyncing @ %1+1 w/len %2 -> %3")
+                .arg(pos).arg(len).arg(newpos));
+            if (newpos == -1)
+                return len - pos;
+            if (newpos == -2)
+                return TSPacket::kSize;
+            pos = newpos;
+        }
+
+        const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
+        pos += TSPacket::kSize; // Advance to next TS packet
+        resync = false;
+
+        if (!pidFilter || pidFilter->test(pkt->PID()))
+        {
+            const PIDListeners &pl = GetPIDListeners(pkt->PID(), m_tsListeners);
+            for (auto *data : pl.m_listeners)
+                data->ProcessTSPacket(*pkt);
+            if (pl.m_tables)
+                m_pidListeners.clear();
+        }
+
+        // if the packet is damaged, and we don't appear to be
+        // in sync on the next packet, then resync.
+        if (pkt->TransportError() && (pos + int(TSPacket::kSize) <= len) &&
+            (buffer[pos] != SYNC_BYTE))
+        {
+            pos -= TSPacket::kSize;
+            resync = true;
+        }
+    }
+
+    return len - pos;
+}
+
+const StreamHandler::PIDListeners &StreamHandler::GetPIDListeners(
+    uint pid, const vector<MPEGStreamData*> &listeners)
+{
+    auto it = m_pidListeners.constFind(pid);
+    if (it != m_pidListeners.constEnd())
+        return *it;
+
+    PIDListeners entry;
+    for (auto *data : listeners)
+    {
+        if (!data->IsInterestingPID(pid))
+            continue;
+        entry.m_listeners.push_back(data);
+        entry.m_tables |= data->IsListeningPID(pid);
+    }
+
+    return *m_pidListeners.insert(pid, entry);
+}
+
 void StreamHandler::WriteMPTS(unsigned char * buffer, uint len)
 {
     if (m_mptsTfw == nullptr)
@@ -3,6 +3,7 @@
 #ifndef _STREAM_HANDLER_H_
 #define _STREAM_HANDLER_H_
 
+#include <bitset>
 #include <utility>
 #include <vector>
 using namespace std;
@@ -11,6 +12,7 @@ using namespace std;
 #include <QWaitCondition>
 #include <QString>
 #include <QMutex>
+#include <QHash>
 #include <QMap>
 
 // MythTV headers
@@ -46,6 +48,8 @@ class PIDInfo
 // HDHRStreamHandler::UpdateFilters() relies on the forward
 // iterator returning these in order of ascending pid number.
 using PIDInfoMap = QMap<uint,PIDInfo*>;
+/// Set for each PID wanted when filtering the full TS in software
+using PIDFilterTable = std::bitset<0x2000>;
 
 // locking order
 // _pid_lock -> _listener_lock
@@ -91,6 +95,9 @@ class StreamHandler : protected MThread, public DeviceReaderCB
 
     PIDPriority GetPIDPriority(uint pid) const;
 
+    int DistributePackets(const unsigned char *buffer, int len,
+                          const PIDFilterTable *pidFilter = nullptr);
+
     // DeviceReaderCB
     void ReaderPaused(int fd) override { (void) fd; } // DeviceReaderCB
     void PriorityEvent(int fd) override { (void) fd; } // DeviceReaderCB
@@ -141,6 +148,22 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     using StreamDataList = QMap<MPEGStreamData*,QString>;
     mutable QMutex      m_listenerLock         {QMutex::Recursive};
     StreamDataList      m_streamDataList;
+
+  private:
+    /// Listeners that want the packets on one PID
+    struct PIDListeners
+    {
+        vector<MPEGStreamData*> m_listeners;
+        /// Set if a listener parses tables on this PID, which may
+        /// change the PIDs it is interested in.
+        bool                    m_tables {false};
+    };
+    const PIDListeners &GetPIDListeners(
+        uint pid, const vector<MPEGStreamData*> &listeners);
+
+    /// Used by DistributePackets(), protected by m_listenerLock
+    QHash<uint,PIDListeners> m_pidListeners;
+    vector<MPEGStreamData*>  m_tsListeners;
 };
 
 #endif // _STREAM_HANDLER_H_
@@ -300,13 +300,8 @@ void V4L2encStreamHandler::run(void)
             continue;
         }
 
-        int remainder = 0;
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-        {
-            remainder = sit.key()->ProcessData
-                        (reinterpret_cast<const uint8_t *>
-                         (buffer.constData()), len);
-        }
+        int remainder = DistributePackets(
+            reinterpret_cast<const uint8_t *>(buffer.constData()), len);
 
         m_listenerLock.unlock();
 
@@ -589,6 +589,7 @@ bool SourceUtil::DeleteAllSources(void)
             query.exec("TRUNCATE TABLE credits") &&
             query.exec("TRUNCATE TABLE programrating") &&
             query.exec("TRUNCATE TABLE programgenres") &&
+            query.exec("TRUNCATE TABLE programterm") &&
             query.exec("TRUNCATE TABLE dtv_multiplex") &&
             query.exec("TRUNCATE TABLE diseqc_config") &&
             query.exec("TRUNCATE TABLE diseqc_tree") &&
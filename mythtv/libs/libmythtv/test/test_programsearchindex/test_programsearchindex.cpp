@@ -0,0 +1,92 @@
+/*
+ *  Class TestProgramSearchIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_programsearchindex.h"
+#include "programsearchindex.h"
+
+void TestProgramSearchIndex::test_tokenize_data(void)
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QStringList>("terms");
+
+    QTest::newRow("empty")     << ""
+                               << QStringList();
+    QTest::newRow("words")     << "Doctor Who"
+                               << QStringList({"doctor", "who"});
+    QTest::newRow("punctuation") << "Law & Order: SVU"
+                               << QStringList({"law", "order", "svu"});
+    QTest::newRow("short")     << "A to Z"
+                               << QStringList({"to"});
+    QTest::newRow("accents")   << QString::fromUtf8("Caf\xC3\xA9 Fran\xC3\xA7" "ais")
+                               << QStringList({"cafe", "francais"});
+    QTest::newRow("numbers")   << "Apollo 13 (1995)"
+                               << QStringList({"apollo", "13", "1995"});
+    QTest::newRow("long")      << QString(40, 'x')
+                               << QStringList({QString(32, 'x')});
+}
+
+void TestProgramSearchIndex::test_tokenize(void)
+{
+    QFETCH(QString, text);
+    QFETCH(QStringList, terms);
+
+    QCOMPARE(ProgramSearchIndex::Tokenize(text), terms);
+}
+
+void TestProgramSearchIndex::test_buildjoin(void)
+{
+    QString join;
+    QString rank;
+    MSqlBindings bindings;
+
+    QVERIFY(ProgramSearchIndex::BuildJoin(
+                "Star Trek star", ProgramSearchIndex::kTitle, "t",
+                join, rank, bindings));
+
+    // Duplicate terms are only joined once
+    QCOMPARE(join.count("JOIN programterm"), 2);
+    QVERIFY(join.contains("JOIN programterm t0 ON"));
+    QVERIFY(join.contains("JOIN programterm t1 ON"));
+    QVERIFY(join.contains("(t0.fields & 1) <> 0"));
+    QCOMPARE(bindings.size(), 2);
+    QCOMPARE(bindings[":TTERM0"].toString(), QString("star%"));
+    QCOMPARE(bindings[":TTERM1"].toString(), QString("trek%"));
+    QCOMPARE(rank.count("MAX("), 2);
+
+    // Terms beyond the limit are ignored
+    bindings.clear();
+    QVERIFY(ProgramSearchIndex::BuildJoin(
+                "aa bb cc dd ee ff gg hh", ProgramSearchIndex::kAllFields,
+                "k", join, rank, bindings));
+    QCOMPARE(bindings.size(), ProgramSearchIndex::kMaxSearchTerms);
+    QVERIFY(!join.contains("k6"));
+}
+
+void TestProgramSearchIndex::test_buildjoin_empty(void)
+{
+    QString join;
+    QString rank;
+    MSqlBindings bindings;
+
+    QVERIFY(!ProgramSearchIndex::BuildJoin(
+                "- a !", ProgramSearchIndex::kAllFields, "k",
+                join, rank, bindings));
+    QVERIFY(bindings.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestProgramSearchIndex)
@@ -0,0 +1,288 @@
+// -*- Mode: c++ -*-
+
+// C++ headers
+#include <algorithm>
+#include <vector>
+
+// Qt headers
+#include <QStringList>
+
+// MythTV headers
+#include "tuningtimeline.h"
+#include "mythlogging.h"
+#include "mythdbcon.h"
+#include "mythdate.h"
+#include "mythdb.h"
+
+#define LOC QString("TuningTimeline[%1]: ").arg(m_inputId)
+
+static const int kMaxHistory = 500;
+
+static const char *kEventNames[TuningTimeline::kEventCount] =
+{
+    "StateChange",
+    "Shutdowns",
+    "RecorderPause",
+    "Frequency",
+    "SignalLock",
+    "FirstPAT",
+    "FirstPMT",
+    "RecorderStart",
+    "FirstKeyframe",
+    "FirstWrite",
+};
+
+QMutex                      TuningTimeline::s_lock;
+QHash<uint,TuningTimeline*> TuningTimeline::s_timelines;
+QList<TuningTimelineData>   TuningTimeline::s_history;
+
+/** \class TuningTimeline
+ *  \brief Records when each phase of a tune was reached.
+ *
+ *   Each TVRec owns one TuningTimeline. It is started when a state change
+ *   or tuning request begins and records monotonic offsets for the tuning
+ *   phases in TVRec, for the first PAT and PMT seen by the signal monitor
+ *   and for the first keyframe and first write in the recorder. Those
+ *   other threads report events with the static Mark() using the input id.
+ *
+ *   Finished timelines are kept in a short in-memory history for the
+ *   Capture service and the status page, and are saved with the recording
+ *   in the recordedtuning table.
+ */
+TuningTimeline::TuningTimeline(uint inputid) : m_inputId(inputid)
+{
+    QMutexLocker locker(&s_lock);
+    s_timelines[m_inputId] = this;
+}
+
+TuningTimeline::~TuningTimeline()
+{
+    QMutexLocker locker(&s_lock);
+    if (s_timelines.value(m_inputId) == this)
+        s_timelines.remove(m_inputId);
+}
+
+/// Starts a new timeline, discarding any unfinished one.
+void TuningTimeline::Start(bool fastChannelChange)
+{
+    QMutexLocker locker(&s_lock);
+    m_data = TuningTimelineData();
+    m_data.m_inputId = m_inputId;
+    m_data.m_startTime = MythDate::current(true);
+    m_data.m_fastChannelChange = fastChannelChange;
+    m_data.m_offsets.fill(-1, kEventCount);
+    m_timer.start();
+    m_active = true;
+}
+
+/** \brief Stops the timeline and adds it to the history.
+ *  \return The finished timeline, ready for SaveToDB().
+ */
+TuningTimelineData TuningTimeline::Finish(uint recordedid, uint chanid)
+{
+    QMutexLocker locker(&s_lock);
+    if (!m_active)
+        return TuningTimelineData();
+
+    m_active = false;
+    m_data.m_recordedId = recordedid;
+    m_data.m_chanId = chanid;
+
+    s_history.push_back(m_data);
+    while (s_history.size() > kMaxHistory)
+        s_history.pop_front();
+
+    QStringList events;
+    for (int i = 0; i < kEventCount; ++i)
+    {
+        if (m_data.m_offsets[i] >= 0)
+            events << QString("%1=%2").arg(kEventNames[i])
+                                      .arg(m_data.m_offsets[i]);
+    }
+    LOG(VB_CHANNEL, LOG_INFO, LOC + QString("Recording %1: %2 (ms)")
+        .arg(recordedid).arg(events.join(" ")));
+
+    return m_data;
+}
+
+/// Abandons the current timeline without adding it to the history.
+void TuningTimeline::Cancel(void)
+{
+    QMutexLocker locker(&s_lock);
+    m_active = false;
+}
+
+bool TuningTimeline::IsActive(void) const
+{
+    QMutexLocker locker(&s_lock);
+    return m_active;
+}
+
+bool TuningTimeline::Has(Event event) const
+{
+    QMutexLocker locker(&s_lock);
+    return m_active && m_data.m_offsets[event] >= 0;
+}
+
+/// Milliseconds since the timeline was started.
+qint64 TuningTimeline::Elapsed(void) const
+{
+    QMutexLocker locker(&s_lock);
+    return m_active ? m_timer.elapsed() : 0;
+}
+
+/** \brief Records the first occurrence of \a event on the active timeline
+ *         of input \a inputid. Safe to call from any thread, later
+ *         occurrences and inputs without an active timeline are ignored.
+ */
+void TuningTimeline::Mark(uint inputid, Event event)
+{
+    QMutexLocker locker(&s_lock);
+    TuningTimeline *timeline = s_timelines.value(inputid);
+    if (!timeline || !timeline->m_active ||
+        timeline->m_data.m_offsets[event] >= 0)
+    {
+        return;
+    }
+
+    qint64 elapsed = timeline->m_timer.elapsed();
+    timeline->m_data.m_offsets[event] = elapsed;
+
+    LOG(VB_CHANNEL, LOG_INFO, QString("TuningTimeline[%1]: %2 at %3 ms")
+        .arg(inputid).arg(kEventNames[event]).arg(elapsed));
+}
+
+QString TuningTimeline::EventName(Event event)
+{
+    if (event < 0 || event >= kEventCount)
+        return QString();
+    return kEventNames[event];
+}
+
+/// \return The event called \a name, or -1 if there is none.
+int TuningTimeline::EventFromName(const QString &name)
+{
+    for (int i = 0; i < kEventCount; ++i)
+    {
+        if (name.compare(kEventNames[i], Qt::CaseInsensitive) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/// Returns the recently finished timelines, oldest first.
+QList<TuningTimelineData> TuningTimeline::GetHistory(uint inputid)
+{
+    QMutexLocker locker(&s_lock);
+    if (!inputid)
+        return s_history;
+
+    QList<TuningTimelineData> history;
+    foreach (const auto & data, s_history)
+    {
+        if (data.m_inputId == inputid)
+            history.push_back(data);
+    }
+    return history;
+}
+
+/** \brief Nearest rank percentile of the offset of \a event.
+ *  \return The offset in msecs, or -1 if no timeline reached the event.
+ */
+qint64 TuningTimeline::Percentile(const QList<TuningTimelineData> &timelines,
+                                  Event event, int percent)
+{
+    std::vector<qint64> offsets;
+    offsets.reserve(timelines.size());
+    foreach (const auto & data, timelines)
+    {
+        if (event < data.m_offsets.size() && data.m_offsets[event] >= 0)
+            offsets.push_back(data.m_offsets[event]);
+    }
+
+    if (offsets.empty())
+        return -1;
+
+    std::sort(offsets.begin(), offsets.end());
+    percent = std::min(std::max(percent, 1), 100);
+    size_t rank = (offsets.size() * percent + 99) / 100;
+    return offsets[rank - 1];
+}
+
+bool TuningTimeline::SaveToDB(const TuningTimelineData &data)
+{
+    if (!data.m_recordedId)
+        return false;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("DELETE FROM recordedtuning "
+                  "WHERE recordedid = :RECORDEDID");
+    query.bindValue(":RECORDEDID", data.m_recordedId);
+    if (!query.exec())
+    {
+        MythDB::DBError("TuningTimeline::SaveToDB() delete", query);
+        return false;
+    }
+
+    query.prepare("INSERT INTO recordedtuning "
+                  "    (recordedid, inputid, starttime, fastchange, "
+                  "     event, msecs) "
+                  "VALUES (:RECORDEDID, :INPUTID, :STARTTIME, :FASTCHANGE, "
+                  "        :EVENT, :MSECS)");
+    for (int i = 0; i < data.m_offsets.size() && i < kEventCount; ++i)
+    {
+        if (data.m_offsets[i] < 0)
+            continue;
+
+        query.bindValue(":RECORDEDID", data.m_recordedId);
+        query.bindValue(":INPUTID",    data.m_inputId);
+        query.bindValue(":STARTTIME",  data.m_startTime);
+        query.bindValue(":FASTCHANGE", data.m_fastChannelChange);
+        query.bindValue(":EVENT",      kEventNames[i]);
+        query.bindValue(":MSECS",      data.m_offsets[i]);
+        if (!query.exec())
+        {
+            MythDB::DBError("TuningTimeline::SaveToDB() insert", query);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Loads the timeline stored with a recording, returns false if there is none.
+bool TuningTimeline::LoadFromDB(uint recordedid, TuningTimelineData &data)
+{
+    data = TuningTimelineData();
+    data.m_offsets.fill(-1, kEventCount);
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT t.inputid, t.starttime, t.fastchange, "
+                  "       t.event, t.msecs, r.chanid "
+                  "FROM recordedtuning t "
+                  "LEFT JOIN recorded r ON r.recordedid = t.recordedid "
+                  "WHERE t.recordedid = :RECORDEDID");
+    query.bindValue(":RECORDEDID", recordedid);
+    if (!query.exec())
+    {
+        MythDB::DBError("TuningTimeline::LoadFromDB()", query);
+        return false;
+    }
+
+    bool found = false;
+    while (query.next())
+    {
+        data.m_recordedId        = recordedid;
+        data.m_inputId           = query.value(0).toUInt();
+        data.m_startTime         = MythDate::as_utc(query.value(1).toDateTime());
+        data.m_fastChannelChange = query.value(2).toBool();
+        data.m_chanId            = query.value(5).toUInt();
+
+        int event = EventFromName(query.value(3).toString());
+        if (event >= 0)
+            data.m_offsets[event] = query.value(4).toLongLong();
+        found = true;
+    }
+
+    return found;
+}
@@ -0,0 +1,84 @@
+// -*- Mode: c++ -*-
+#ifndef TUNING_TIMELINE_H
+#define TUNING_TIMELINE_H
+
+// Qt headers
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// MythTV headers
+#include "mythtvexp.h"
+
+/// Events of one tuning timeline, as stored by TuningTimeline.
+class MTV_PUBLIC TuningTimelineData
+{
+  public:
+    uint            m_inputId           {0};
+    uint            m_recordedId        {0};
+    uint            m_chanId            {0};
+    QDateTime       m_startTime;
+    bool            m_fastChannelChange {false};
+    /// msecs after m_startTime indexed by TuningTimeline::Event,
+    /// -1 if the event was not reached.
+    QVector<qint64> m_offsets;
+};
+
+class MTV_PUBLIC TuningTimeline
+{
+  public:
+    enum Event
+    {
+        kStateChange = 0,
+        kShutdowns,
+        kRecorderPause,
+        kFrequency,
+        kSignalLock,
+        kFirstPAT,
+        kFirstPMT,
+        kRecorderStart,
+        kFirstKeyframe,
+        kFirstWrite,
+        kEventCount
+    };
+
+    explicit TuningTimeline(uint inputid);
+    ~TuningTimeline();
+
+    void Start(bool fastChannelChange);
+    TuningTimelineData Finish(uint recordedid, uint chanid);
+    void Cancel(void);
+    bool IsActive(void) const;
+    bool Has(Event event) const;
+    qint64 Elapsed(void) const;
+
+    static void Mark(uint inputid, Event event);
+
+    static QString EventName(Event event);
+    static int EventFromName(const QString &name);
+
+    static QList<TuningTimelineData> GetHistory(uint inputid = 0);
+    static qint64 Percentile(const QList<TuningTimelineData> &timelines,
+                             Event event, int percent);
+
+    static bool SaveToDB(const TuningTimelineData &data);
+    static bool LoadFromDB(uint recordedid, TuningTimelineData &data);
+
+  private:
+    Q_DISABLE_COPY(TuningTimeline)
+
+    uint               m_inputId;
+    bool               m_active  {false};
+    QElapsedTimer      m_timer;
+    TuningTimelineData m_data;
+
+    static QMutex                         s_lock;
+    static QHash<uint,TuningTimeline*>    s_timelines;
+    static QList<TuningTimelineData>      s_history;
+};
+
+#endif // TUNING_TIMELINE_H
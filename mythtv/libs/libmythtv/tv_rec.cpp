@@ -40,6 +40,8 @@
 #include "mythdate.h"
 #include "osd.h"
 #include "../vboxutils.h"
+#include "psicache.h"
+#include "tuningtimeline.h"
 
 #define DEBUG_CHANNEL_PREFIX 0 /**< set to 1 to channel prefixing */
 
@@ -48,6 +50,7 @@
 
 /// How many milliseconds the signal monitor should wait between checks
 const uint TVRec::kSignalMonitoringRate = 50; /* msec */
+const int TVRec::kTuningTimelineTimeout = 60 * 1000; /* msec */
 
 QReadWriteLock    TVRec::s_inputsLock;
 QMap<uint,TVRec*> TVRec::s_inputs;
@@ -56,6 +59,7 @@ static bool is_dishnet_eit(uint inputid);
 static int init_jobs(const RecordingInfo *rec, RecordingProfile &profile,
                      bool on_host, bool transcode_bfr_comm, bool on_line_comm);
 static void apply_broken_dvb_driver_crc_hack(ChannelBase* /*c*/, MPEGStreamData* /*s*/);
+static bool has_rotor(ChannelBase* /*c*/);
 static int eit_start_rand(int eitTransportTimeout);
 
 /** \class TVRec
@@ -86,7 +90,8 @@ TVRec::TVRec(int inputid)
       // Various threads
     : m_eventThread(new MThread("TVRecEvent", this)),
       // Configuration variables from setup routines
-      m_inputId(inputid)
+      m_inputId(inputid),
+      m_tuningTimeline(new TuningTimeline(inputid))
 {
     s_inputs[m_inputId] = this;
 }
@@ -161,6 +166,7 @@ bool TVRec::Init(void)
     m_overRecordSecNrml = gCoreContext->GetNumSetting("RecordOverTime");
     m_overRecordSecCat  = gCoreContext->GetNumSetting("CategoryOverTime") * 60;
     m_overRecordCategory= gCoreContext->GetSetting("OverTimeCategory");
+    m_fastChannelChange = gCoreContext->GetBoolSetting("FastChannelChange", false);
 
     m_eventThread->start();
 
@@ -190,6 +196,9 @@ TVRec::~TVRec()
         delete m_channel;
         m_channel = nullptr;
     }
+
+    delete m_tuningTimeline;
+    m_tuningTimeline = nullptr;
 }
 
 void TVRec::TeardownAll(void)
@@ -1012,6 +1021,15 @@ void TVRec::HandleStateChange(void)
         return;
     }
 
+    // Time the tune from here when starting a recording or LiveTV
+    bool timeline = (nextState == kState_None) &&
+        ((m_desiredNextState == kState_RecordingOnly) ||
+         (m_desiredNextState == kState_WatchingLiveTV));
+    if (timeline || (m_desiredNextState == kState_None))
+        FinishTuningTimeline(true);
+    if (timeline)
+        m_tuningTimeline->Start(m_fastChannelChange);
+
     // Make sure EIT scan is stopped before any tuning,
     // to avoid race condition with it's tuning requests.
     if (m_scanner && HasFlags(kFlagEITScannerRunning))
@@ -1060,6 +1078,9 @@ void TVRec::HandleStateChange(void)
     m_internalState = nextState;
     m_changeState = false;
 
+    if (timeline)
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kStateChange);
+
     m_eitScanStartTime = MythDate::current();
     if (m_scanner && (m_internalState == kState_None))
     {
@@ -1312,6 +1333,9 @@ void TVRec::run(void)
             s_inputsLock.unlock();
         }
 
+        // Store the tuning timeline once data is flowing
+        FinishTuningTimeline(false);
+
         // Tell frontends about pending recordings
         HandlePendingRecordings();
 
@@ -1867,6 +1891,11 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
         sd->SetCaching(true);
     }
 
+    // Tables seen the last time this channel was tuned, see PSICache
+    bool use_psi_cache = m_fastChannelChange && !EITscan;
+    m_psiCacheKey = QString("%1:%2").arg(m_channel->GetSourceID())
+        .arg(m_channel->GetChannelName());
+
     QString recording_type = "all";
     RecordingInfo *rec = m_lastTuningRequest.m_program;
     RecordingProfile profile;
@@ -1904,6 +1933,9 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
         if (!ApplyCachedPids(sm, dtvchan))
             sm->AddFlags(SignalMonitor::kDTVSigMon_WaitForMGT);
 
+        if (use_psi_cache)
+            PSICache::Apply(m_psiCacheKey, sd);
+
         LOG(VB_RECORD, LOG_INFO, LOC +
             "Successfully set up ATSC table monitoring.");
         return true;
@@ -1941,6 +1973,9 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
                      SignalMonitor::kDVBSigMon_WaitForPos);
         sm->SetRotorTarget(1.0F);
 
+        if (use_psi_cache)
+            PSICache::Apply(m_psiCacheKey, sd, !has_rotor(m_channel));
+
         if (EITscan)
         {
             sm->GetStreamData()->SetVideoStreamsRequired(0);
@@ -1978,6 +2013,9 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
                      SignalMonitor::kDVBSigMon_WaitForPos);
         sm->SetRotorTarget(1.0F);
 
+        if (use_psi_cache)
+            PSICache::Apply(m_psiCacheKey, sd);
+
         if (EITscan)
         {
             sm->GetStreamData()->SetVideoStreamsRequired(0);
@@ -3501,6 +3539,17 @@ void TVRec::HandleTuning(void)
         LOG(VB_RECORD, LOG_INFO, LOC +
             "HandleTuning Request: " + request.toString());
 
+        // Requests queued by HandleStateChange() continue its timeline
+        bool tuning = (request.m_flags & (kFlagRecording|kFlagLiveTV)) != 0U;
+        if (request.m_flags & kFlagEITScan)
+            m_tuningTimeline->Cancel();
+        else if (tuning && (!m_tuningTimeline->Has(TuningTimeline::kStateChange) ||
+                            m_tuningTimeline->Has(TuningTimeline::kShutdowns)))
+        {
+            FinishTuningTimeline(true);
+            m_tuningTimeline->Start(m_fastChannelChange);
+        }
+
         QString input;
         request.m_channel = TuningGetChanNum(request, input);
         request.m_input   = input;
@@ -3509,6 +3558,7 @@ void TVRec::HandleTuning(void)
             LOG(VB_CHANNEL, LOG_INFO, LOC + "On same multiplex");
 
         TuningShutdowns(request);
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kShutdowns);
 
         // The dequeue isn't safe to do until now because we
         // release the stateChangeLock to teardown a recorder
@@ -3523,6 +3573,7 @@ void TVRec::HandleTuning(void)
                 LOG(VB_RECORD, LOG_INFO, LOC +
                     "No recorder yet, calling TuningFrequency");
                 TuningFrequency(request);
+                TuningTimeline::Mark(m_inputId, TuningTimeline::kFrequency);
             }
             else
             {
@@ -3539,14 +3590,20 @@ void TVRec::HandleTuning(void)
             return;
 
         ClearFlags(kFlagWaitingForRecPause, __FILE__, __LINE__);
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kRecorderPause);
         LOG(VB_RECORD, LOG_INFO, LOC +
             "Recorder paused, calling TuningFrequency");
         TuningFrequency(m_lastTuningRequest);
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kFrequency);
     }
 
     MPEGStreamData *streamData = nullptr;
-    if (HasFlags(kFlagWaitingForSignal) && !(streamData = TuningSignalCheck()))
-        return;
+    if (HasFlags(kFlagWaitingForSignal))
+    {
+        if (!(streamData = TuningSignalCheck()))
+            return;
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kSignalLock);
+    }
 
     if (HasFlags(kFlagNeedToStartRecorder))
     {
@@ -3554,6 +3611,7 @@ void TVRec::HandleTuning(void)
             TuningRestartRecorder();
         else
             TuningNewRecorder(streamData);
+        TuningTimeline::Mark(m_inputId, TuningTimeline::kRecorderStart);
 
         // If we got this far it is safe to set a new starting channel...
         if (m_channel)
@@ -3561,6 +3619,34 @@ void TVRec::HandleTuning(void)
     }
 }
 
+/** \brief Finishes the tuning timeline and saves it with the recording.
+ *
+ *   Unless \a force is set this only happens once the recorder has
+ *   written its first data, or the tune has taken too long to matter.
+ */
+void TVRec::FinishTuningTimeline(bool force)
+{
+    if (!m_tuningTimeline->IsActive())
+        return;
+
+    if (!force && !m_tuningTimeline->Has(TuningTimeline::kFirstWrite) &&
+        m_tuningTimeline->Elapsed() < kTuningTimelineTimeout)
+    {
+        return;
+    }
+
+    uint recordedid = 0;
+    uint chanid = 0;
+    if (m_curRecording)
+    {
+        recordedid = m_curRecording->GetRecordingID();
+        chanid = m_curRecording->GetChanID();
+    }
+
+    TuningTimelineData data = m_tuningTimeline->Finish(recordedid, chanid);
+    TuningTimeline::SaveToDB(data);
+}
+
 /** \fn TVRec::TuningShutdowns(const TuningRequest&)
  *  \brief This shuts down anything that needs to be shut down
  *         before handling the passed in tuning request.
@@ -4037,6 +4123,16 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (GetDTVSignalMonitor())
         streamData = GetDTVSignalMonitor()->GetStreamData();
 
+    // remember the tables for the next time this channel is tuned
+    if (m_fastChannelChange && !HasFlags(kFlagEITScannerRunning))
+    {
+        if (newRecStatus == RecStatus::Failed)
+            PSICache::Invalidate(m_psiCacheKey);
+        else if (streamData)
+            PSICache::Store(m_psiCacheKey, streamData->DesiredProgram(),
+                            streamData);
+    }
+
     if (!HasFlags(kFlagEITScannerRunning))
     {
         // shut down signal monitoring
@@ -4851,8 +4947,16 @@ static void apply_broken_dvb_driver_crc_hack(ChannelBase *c, MPEGStreamData *s)
     if (dynamic_cast<DVBChannel*>(c))
         s->SetIgnoreCRC(dynamic_cast<DVBChannel*>(c)->HasCRCBug());
 }
+
+static bool has_rotor(ChannelBase *c)
+{
+    // A rotor must still turn before the cached SDT can be trusted
+    auto *dvbchan = dynamic_cast<DVBChannel*>(c);
+    return dvbchan && dvbchan->GetRotor();
+}
 #else
 static void apply_broken_dvb_driver_crc_hack(ChannelBase*, MPEGStreamData*) {}
+static bool has_rotor(ChannelBase*) { return false; }
 #endif // USING_DVB
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -61,6 +61,7 @@ class CetonChannel;
 class MPEGStreamData;
 class ProgramMapTable;
 class RecordingQuality;
+class TuningTimeline;
 
 class GeneralDBOptions
 {
@@ -298,6 +299,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     void TuningRestartRecorder(void);
     QString TuningGetChanNum(const TuningRequest &request, QString &input) const;
     bool TuningOnSameMultiplex(TuningRequest &request);
+    void FinishTuningTimeline(bool force);
 
     void HandleStateChange(void);
     void ChangeState(TVState nextState);
@@ -348,6 +350,9 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     QDateTime          m_preFailDeadline;
     bool               m_reachedPreFail           {false};
 
+    // Fast channel change
+    QString            m_psiCacheKey;
+
     // Various threads
     /// Event processing thread, runs TVRec::run().
     MThread           *m_eventThread              {nullptr};
@@ -364,12 +369,16 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     int                m_overRecordSecNrml        {0};
     int                m_overRecordSecCat         {0};
     QString            m_overRecordCategory;
+    bool               m_fastChannelChange        {false};
 
     // Configuration variables from setup routines
     uint               m_inputId;
     uint               m_parentId                 {0};
     bool               m_isPip                    {false};
 
+    // Tuning and recording start timeline
+    TuningTimeline    *m_tuningTimeline           {nullptr};
+
     // Configuration variables from database, based on inputid
     GeneralDBOptions   m_genOpt;
     DVBDBOptions       m_dvbOpt;
@@ -428,6 +437,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
   public:
     static const uint kSignalMonitoringRate;
+    static const int  kTuningTimelineTimeout;
 
     // General State flags
     static const uint kFlagFrontendReady        = 0x00000001;
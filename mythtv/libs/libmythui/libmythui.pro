@@ -42,7 +42,7 @@ HEADERS += mythuiexp.h mythuisimpletext.h mythuistatetracker.h
 HEADERS += mythuianimation.h mythuiscrollbar.h
 HEADERS += mythnotificationcenter.h mythnotificationcenter_private.h
 HEADERS += mythuicomposite.h mythnotification.h
-HEADERS += mythedid.h
+HEADERS += mythedid.h mythuithemecache.h
 
 SOURCES  = mythmainwindow.cpp mythpainter.cpp mythimage.cpp mythrect.cpp
 SOURCES += myththemebase.cpp  mythpainter_qimage.cpp
@@ -64,7 +64,7 @@ SOURCES += mythuisimpletext.cpp mythuistatetracker.cpp
 SOURCES += mythuianimation.cpp mythuiscrollbar.cpp
 SOURCES += mythnotificationcenter.cpp mythnotification.cpp
 SOURCES += mythuicomposite.cpp
-SOURCES += mythedid.cpp
+SOURCES += mythedid.cpp mythuithemecache.cpp
 
 using_qtwebkit {
 HEADERS += mythuiwebbrowser.h
@@ -196,6 +196,8 @@ using_opengl {
     HEADERS += opengl/mythrenderopengldefs.h opengl/mythrenderopenglshaders.h
     HEADERS += opengl/mythopenglperf.h
     SOURCES += opengl/mythopenglperf.cpp
+    HEADERS += opengl/mythopenglglyphatlas.h
+    SOURCES += opengl/mythopenglglyphatlas.cpp
     HEADERS += opengl/mythegl.h
     SOURCES += opengl/mythegl.cpp
 
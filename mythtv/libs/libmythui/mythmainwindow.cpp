@@ -811,6 +811,8 @@ void MythMainWindow::draw(MythPainter *painter /* = 0 */)
 
     if (!painter->SupportsClipping())
         d->m_repaintRegion = QRegion(d->m_uiScreenRect);
+    else
+        painter->Clear(d->m_paintwin, d->m_repaintRegion);
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
     QVector<QRect> rects = d->m_repaintRegion.rects();
@@ -1,5 +1,6 @@
 #include "mythuibuttonlist.h"
 
+#include <algorithm>
 #include <cmath>
 
 // QT headers
@@ -113,12 +114,15 @@ void MythUIButtonList::SetActive(bool active)
 void MythUIButtonList::Reset()
 {
     m_ButtonToItem.clear();
+    m_provider = nullptr;
+    m_providerRowsStale = false;
 
     if (m_itemList.isEmpty())
         return;
 
     m_clearing = true;
 
+    m_filledItems.clear();
     while (!m_itemList.isEmpty())
         delete m_itemList.takeFirst();
 
@@ -1428,6 +1432,8 @@ void MythUIButtonList::CalculateArrowStates()
 
     m_needsUpdate = false;
 
+    PrefetchImages();
+
     if (!m_downArrow || !m_upArrow)
         return;
 
@@ -1453,6 +1459,69 @@ void MythUIButtonList::CalculateArrowStates()
     }
 }
 
+/**
+ * \brief Queue background loads of the images on the pages either side of
+ *        the visible one, so that paging through large grids doesn't stall
+ *        waiting for them to be decoded.
+ */
+void MythUIButtonList::PrefetchImages(void)
+{
+    if (m_ButtonList.empty() || m_itemsVisible == 0 ||
+        m_itemCount <= static_cast<int>(m_itemsVisible))
+        return;
+
+    // Any button will do, the images are loaded with the theme properties
+    // which are the same for every button
+    MythUIStateType *button = m_ButtonList[0];
+    auto *buttonstate = dynamic_cast<MythUIGroup *>(button->GetState("inactive"));
+    if (!buttonstate)
+        buttonstate = dynamic_cast<MythUIGroup *>(button->GetState("active"));
+    if (!buttonstate)
+        return;
+
+    int pageSize = static_cast<int>(m_itemsVisible);
+    int nextPage = m_topPosition + pageSize;
+    int prevPage = m_topPosition - pageSize;
+
+    // Next page first, it is the most likely destination
+    QList<int> positions;
+    for (int i = 0; i < pageSize; ++i)
+        positions.append(nextPage + i);
+    for (int i = 0; i < pageSize; ++i)
+        positions.append(prevPage + i);
+
+    foreach (int pos, positions)
+    {
+        if (m_wrapStyle == WrapItems)
+            pos = (pos + m_itemCount) % m_itemCount;
+        else if (pos < 0 || pos >= m_itemCount)
+            continue;
+
+        MythUIButtonListItem *item = m_itemList.at(pos);
+        if (!item)
+            continue;
+
+        FillItem(item);
+
+        if (!item->m_imageFilename.isEmpty())
+        {
+            auto *image = dynamic_cast<MythUIImage *>
+                          (buttonstate->GetChild("buttonimage"));
+            if (image)
+                image->Prefetch(item->m_imageFilename);
+        }
+
+        InfoMap::const_iterator it = item->m_imageFilenames.constBegin();
+        for (; it != item->m_imageFilenames.constEnd(); ++it)
+        {
+            auto *image = dynamic_cast<MythUIImage *>
+                          (buttonstate->GetChild(it.key()));
+            if (image)
+                image->Prefetch(it.value());
+        }
+    }
+}
+
 void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 {
     if (item)
@@ -1477,6 +1546,7 @@ void MythUIButtonList::InsertItem(MythUIButtonListItem *item, int listPosition)
         m_itemList.append(item);
 
     ++m_itemCount;
+    m_providerRowsStale = (m_provider != nullptr);
 
     if (wasEmpty)
     {
@@ -1529,7 +1599,9 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     }
 
     m_itemList.removeAt(curIndex);
+    m_filledItems.removeAll(item);
     --m_itemCount;
+    m_providerRowsStale = (m_provider != nullptr);
 
     Update();
 
@@ -1596,6 +1668,7 @@ MythUIButtonListItem *MythUIButtonList::GetItemCurrent() const
         m_selPosition < 0)
         return nullptr;
 
+    FillItem(m_itemList.at(m_selPosition));
     return m_itemList.at(m_selPosition);
 }
 
@@ -1639,7 +1712,10 @@ MythRect MythUIButtonList::GetButtonArea(void) const
 MythUIButtonListItem *MythUIButtonList::GetItemFirst() const
 {
     if (!m_itemList.empty())
+    {
+        FillItem(m_itemList[0]);
         return m_itemList[0];
+    }
 
     return nullptr;
 }
@@ -1652,7 +1728,9 @@ const
     if (!it.findNext(item))
         return nullptr;
 
-    return it.previous();
+    MythUIButtonListItem *next = it.previous();
+    FillItem(next);
+    return next;
 }
 
 int MythUIButtonList::GetCount() const
@@ -1681,6 +1759,7 @@ MythUIButtonListItem *MythUIButtonList::GetItemAt(int pos) const
     if (pos < 0 || pos >= m_itemList.size())
         return nullptr;
 
+    FillItem(m_itemList.at(pos));
     return m_itemList.at(pos);
 }
 
@@ -1692,7 +1771,10 @@ MythUIButtonListItem *MythUIButtonList::GetItemByData(const QVariant& data)
     foreach (auto item, m_itemList)
     {
         if (item->GetData() == data)
+        {
+            FillItem(item);
             return item;
+        }
     }
 
     return nullptr;
@@ -2345,6 +2427,7 @@ bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
 
     m_itemList.removeAt(oldpos);
     m_itemList.insert(insertat, item);
+    m_providerRowsStale = (m_provider != nullptr);
 
     if (up)
     {
@@ -2760,6 +2843,119 @@ void MythUIButtonList::customEvent(QEvent *event)
     }
 }
 
+/**
+ * \brief Turn this into a virtual list backed by \p provider
+ *
+ * Any existing items are deleted and a lightweight placeholder is created
+ * for each row, which is only filled in by the provider when it is needed.
+ * Call again, or call RefreshItems(), when the provider's rows change.
+ * Passing a null provider just empties the list.
+ */
+void MythUIButtonList::SetProvider(MythUIButtonListProvider *provider)
+{
+    Reset();
+
+    m_provider = provider;
+    if (!m_provider)
+        return;
+
+    int rows = m_provider->GetRowCount();
+
+    m_itemList.reserve(rows);
+    for (int row = 0; row < rows; ++row)
+    {
+        auto *item = new MythUIButtonListItem(this);
+        item->m_data = m_provider->GetRowData(row);
+        item->m_needsFill = true;
+        item->m_providerRow = row;
+        m_itemList.append(item);
+    }
+
+    m_itemCount = rows;
+    m_providerRowsStale = false;
+    m_selPosition = m_topPosition = 0;
+
+    LOG(VB_GUI, LOG_DEBUG, QString("Buttonlist '%1' using provider with %2 rows")
+        .arg(objectName()).arg(rows));
+
+    if (rows > 0)
+    {
+        emit itemSelected(GetItemCurrent());
+        emit DependChanged(false);
+    }
+
+    Update();
+}
+
+/**
+ * \brief Discard the filled in data for \p row, or every row when -1, so
+ *        that it is fetched from the provider again when next needed
+ */
+void MythUIButtonList::RefreshItems(int row)
+{
+    if (!m_provider)
+        return;
+
+    if (row < 0)
+    {
+        foreach (auto item, m_filledItems)
+            item->ReleaseData();
+        m_filledItems.clear();
+    }
+    else if (row < m_itemList.size())
+    {
+        MythUIButtonListItem *item = m_itemList.at(row);
+        if (m_filledItems.removeAll(item))
+            item->ReleaseData();
+    }
+
+    Update();
+}
+
+/**
+ * \brief Have the provider fill in a virtual list placeholder
+ *
+ * Only a few pages worth of rows are kept filled, the longest filled rows
+ * that are no longer on screen are released as others are filled. Once
+ * items have been inserted, removed or moved the remembered rows are
+ * renumbered from the list positions before the next fill.
+ */
+void MythUIButtonList::FillItem(MythUIButtonListItem *item) const
+{
+    if (!m_provider || !item || !item->m_needsFill)
+        return;
+
+    if (m_providerRowsStale)
+    {
+        for (int row = 0; row < m_itemList.size(); ++row)
+            m_itemList.at(row)->m_providerRow = row;
+        m_providerRowsStale = false;
+    }
+
+    if (item->m_providerRow < 0)
+        return;
+
+    item->m_needsFill = false;
+    m_provider->FillItem(item, item->m_providerRow);
+    m_filledItems.append(item);
+
+    int limit = std::max(static_cast<int>(m_itemsVisible) * 4, 64);
+    MythUIButtonListItem *current = nullptr;
+    if (m_selPosition >= 0 && m_selPosition < m_itemList.size())
+        current = m_itemList.at(m_selPosition);
+
+    QMutableListIterator<MythUIButtonListItem *> it(m_filledItems);
+    while (m_filledItems.size() > limit && it.hasNext())
+    {
+        MythUIButtonListItem *old = it.next();
+        if (old == item || old == current || old->isVisible())
+            continue;
+
+        old->ReleaseData();
+        it.remove();
+    }
+}
+
 void MythUIButtonList::LoadInBackground(int start, int pageSize)
 {
     m_nextItemLoaded = start;
@@ -3251,6 +3447,35 @@ MythUIButtonListItem::MythUIButtonListItem(MythUIButtonList *lbtype,
         m_parent->InsertItem(this, listPosition);
 }
 
+/**
+ * \brief Drop everything a provider filled in, leaving just the placeholder
+ */
+void MythUIButtonListItem::ReleaseData(void)
+{
+    m_text.clear();
+    m_fontState.clear();
+    m_imageFilename.clear();
+    m_strings.clear();
+    m_imageFilenames.clear();
+    m_states.clear();
+
+    if (m_image)
+    {
+        m_image->DecrRef();
+        m_image = nullptr;
+    }
+
+    QMap<QString, MythImage*>::iterator it;
+    for (it = m_images.begin(); it != m_images.end(); ++it)
+    {
+        if (*it)
+            (*it)->DecrRef();
+    }
+    m_images.clear();
+
+    m_needsFill = true;
+}
+
 MythUIButtonListItem::~MythUIButtonListItem()
 {
     if (m_parent)
@@ -3597,6 +3822,8 @@ void MythUIButtonListItem::SetToRealButton(MythUIStateType *button, bool selecte
     if (!m_parent)
         return;
 
+    m_parent->FillItem(this);
+
     m_parent->ItemVisible(this);
     m_isVisible = true;
 
@@ -15,6 +15,7 @@
 #include "mythimage.h"
 
 class MythUIButtonList;
+class MythUIButtonListItem;
 class MythUIScrollBar;
 class MythUIStateType;
 class MythUIGroup;
@@ -24,6 +25,32 @@ struct TextProperties {
     QString state;
 };
 
+/**
+ * \class MythUIButtonListProvider
+ *
+ * \brief Data source for a virtual MythUIButtonList
+ *
+ * With a provider set the list only holds a bare placeholder item per row.
+ * The text, images and states of a row are filled in by FillItem() when it
+ * is about to be drawn or is fetched from the list, and are released again
+ * once the row has been out of view for a while. The provider is the owner
+ * of the data, anything set directly on a filled item may be discarded.
+ */
+class MUI_PUBLIC MythUIButtonListProvider
+{
+  public:
+    virtual ~MythUIButtonListProvider() = default;
+
+    /// Number of rows in the model
+    virtual int GetRowCount(void) const = 0;
+
+    /// Cheap per row value kept on the placeholder, see GetItemByData()
+    virtual QVariant GetRowData(int row) const { return row; }
+
+    /// Populate a placeholder with the text, images and states of a row
+    virtual void FillItem(MythUIButtonListItem *item, int row) = 0;
+};
+
 class MUI_PUBLIC MythUIButtonListItem
 {
   public:
@@ -110,6 +137,12 @@ class MUI_PUBLIC MythUIButtonListItem
     virtual void SetToRealButton(MythUIStateType *button, bool selected);
 
   protected:
+    /// Placeholder for a virtual list row, is not inserted into the list
+    explicit MythUIButtonListItem(MythUIButtonList *lbtype)
+        : m_parent(lbtype), m_checkable(false), m_state(CantCheck) {}
+
+    void ReleaseData(void);
+
     MythUIButtonList *m_parent      {nullptr};
     QString         m_text;
     QString         m_fontState;
@@ -121,6 +154,8 @@ class MUI_PUBLIC MythUIButtonListItem
     bool            m_showArrow     {false};
     bool            m_isVisible     {false};
     bool            m_enabled       {true};
+    bool            m_needsFill     {false};
+    int             m_providerRow   {-1};
 
     QMap<QString, TextProperties> m_strings;
     QMap<QString, MythImage*> m_images;
@@ -212,6 +247,10 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void LoadInBackground(int start = 0, int pageSize = 20);
     int  StopLoad(void);
 
+    void SetProvider(MythUIButtonListProvider *provider);
+    MythUIButtonListProvider *GetProvider(void) const { return m_provider; }
+    void RefreshItems(int row = -1);
+
   public slots:
     void Select();
     void Deselect();
@@ -235,6 +274,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     virtual void Init();
 
     void InsertItem(MythUIButtonListItem *item, int listPosition = -1);
+    void FillItem(MythUIButtonListItem *item) const;
 
     int minButtonWidth(const MythRect & area);
     int minButtonHeight(const MythRect & area);
@@ -259,6 +299,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     bool DistributeButtons(void);
     void CalculateButtonPositions(void);
     void CalculateArrowStates(void);
+    void PrefetchImages(void);
     void SetScrollBarPosition(void);
     void ItemVisible(MythUIButtonListItem *item);
 
@@ -339,6 +380,10 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     QList<MythUIButtonListItem*> m_itemList;
     int m_nextItemLoaded              {0};
 
+    MythUIButtonListProvider *m_provider {nullptr};
+    mutable QList<MythUIButtonListItem*> m_filledItems;
+    mutable bool m_providerRowsStale  {false};
+
     bool m_drawFromBottom             {false};
 
     QString     m_lcdTitle;
@@ -1,6 +1,8 @@
 #include "mythuihelper.h"
 
+#include <algorithm>
 #include <cmath>
+#include <list>
 #include <unistd.h>
 
 #include <QImage>
@@ -8,6 +10,8 @@
 #include <QMutex>
 #include <QPalette>
 #include <QMap>
+#include <QHash>
+#include <QThread>
 #include <QDir>
 #include <QFileInfo>
 #include <QApplication>
@@ -100,6 +104,9 @@ public:
     void Init();
     void StoreGUIsettings(void);
 
+    void TouchCacheEntry(const QString &url);
+    void RemoveCacheEntry(const QString &url);
+
     bool      m_themeloaded {false}; ///< Do we have a palette and pixmap to use?
     QString   m_menuthemepathname;
     QString   m_themepathname;
@@ -121,6 +128,13 @@ public:
 #endif
     QMutex *m_cacheLock                      {nullptr};
 
+    // Memory cache keys, least recently used first
+    std::list<QString> m_cacheLRU;
+    QHash<QString, std::list<QString>::iterator> m_cacheLRUPos;
+    QAtomicInt m_cacheHits                   {0};
+    QAtomicInt m_cacheMisses                 {0};
+    QAtomicInt m_cacheEvicted                {0};
+
 #if QT_VERSION < QT_VERSION_CHECK(5,10,0)
     QAtomicInt m_cacheSize                   {0};
     QAtomicInt m_maxCacheSize                {30 * 1024 * 1024};
@@ -179,6 +193,8 @@ MythUIHelperPrivate::~MythUIHelperPrivate()
     }
 
     m_cacheTrack.clear();
+    m_cacheLRU.clear();
+    m_cacheLRUPos.clear();
 
     delete m_cacheLock;
     delete m_imageThreadPool;
@@ -193,6 +209,36 @@ MythUIHelperPrivate::~MythUIHelperPrivate()
     }
 }
 
+/**
+ * \brief Move an image to the most recently used end of the memory cache.
+ * \note  Must be called with m_cacheLock held.
+ */
+void MythUIHelperPrivate::TouchCacheEntry(const QString &url)
+{
+    auto it = m_cacheLRUPos.find(url);
+    if (it != m_cacheLRUPos.end())
+    {
+        m_cacheLRU.splice(m_cacheLRU.end(), m_cacheLRU, *it);
+        return;
+    }
+
+    m_cacheLRUPos.insert(url, m_cacheLRU.insert(m_cacheLRU.end(), url));
+}
+
+/**
+ * \brief Drop an image from the memory cache ordering.
+ * \note  Must be called with m_cacheLock held.
+ */
+void MythUIHelperPrivate::RemoveCacheEntry(const QString &url)
+{
+    auto it = m_cacheLRUPos.find(url);
+    if (it == m_cacheLRUPos.end())
+        return;
+
+    m_cacheLRU.erase(*it);
+    m_cacheLRUPos.erase(it);
+}
+
 void MythUIHelperPrivate::Init(void)
 {
     if (!m_display)
@@ -294,6 +340,13 @@ void MythUIHelper::Init(MythUIMenuCallbacks &cbs)
     LOG(VB_GUI, LOG_INFO, LOC +
         QString("MythUI Image Cache size set to %1 bytes")
         .arg(d->m_maxCacheSize.fetchAndAddRelease(0)));
+
+    // Keep the loader pool small so that a fast scroll through a large
+    // coverart grid can't starve the UI thread of CPU. Queued requests are
+    // prioritised, so visible images always jump ahead of prefetches.
+    int threads = GetMythDB()->GetNumSetting("UIImageLoaderThreads",
+                                             std::min(QThread::idealThreadCount(), 4));
+    d->m_imageThreadPool->setMaxThreadCount(std::max(threads, 1));
 }
 
 // This init is used for showing the startup UI that is shown
@@ -379,7 +432,16 @@ void MythUIHelper::UpdateImageCache(void)
         i.remove();
     }
 
+    MythUIImageCacheStats stats = GetImageCacheStats();
+    LOG(VB_GUI, LOG_INFO, LOC +
+        QString("Flushing image cache: %1 images, %2 hits, %3 misses, "
+                "%4 evicted")
+        .arg(stats.m_count).arg(stats.m_hits).arg(stats.m_misses)
+        .arg(stats.m_evicted));
+
     d->m_cacheTrack.clear();
+    d->m_cacheLRU.clear();
+    d->m_cacheLRUPos.clear();
 
     d->m_cacheSize.fetchAndStoreOrdered(0);
 
@@ -399,10 +461,14 @@ MythImage *MythUIHelper::GetImageFromCache(const QString &url)
 #else
         d->m_cacheTrack[url] = MythDate::current().toSecsSinceEpoch();
 #endif
+        d->TouchCacheEntry(url);
+        d->m_cacheHits.fetchAndAddRelaxed(1);
         d->m_imageCache[url]->IncrRef();
         return d->m_imageCache[url];
     }
 
+    d->m_cacheMisses.fetchAndAddRelaxed(1);
+
     /*
         if (QFileInfo(url).exists())
         {
@@ -459,65 +525,47 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
     // delete the oldest cached images until we fall below threshold.
     QMutexLocker locker(d->m_cacheLock);
 
-    while ((d->m_cacheSize.fetchAndAddOrdered(0) +
 #if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-	   im->byteCount()
+    qint64 imSize = im->byteCount();
 #else
-	   im->sizeInBytes()
+    qint64 imSize = im->sizeInBytes();
 #endif
-	    ) >=
+
+    // Walk from the least recently used end, skipping images that are
+    // still referenced outside of the cache.
+    auto lru = d->m_cacheLRU.begin();
+    while ((d->m_cacheSize.fetchAndAddOrdered(0) + imSize) >=
            d->m_maxCacheSize.fetchAndAddOrdered(0) &&
-           !d->m_imageCache.empty())
+           lru != d->m_cacheLRU.end())
     {
-        QMap<QString, MythImage *>::iterator it = d->m_imageCache.begin();
-#if QT_VERSION < QT_VERSION_CHECK(5,8,0)
-        uint oldestTime = MythDate::current().toTime_t();
-#else
-        qint64 oldestTime = MythDate::current().toSecsSinceEpoch();
-#endif
-        QString oldestKey = it.key();
-
-        int count = 0;
+        QString oldestKey = *lru;
+        MythImage *oldest = d->m_imageCache.value(oldestKey);
 
-        for (; it != d->m_imageCache.end(); ++it)
+        bool evictable = false;
+        if (oldest && oldest != im)
         {
-            if (d->m_cacheTrack[it.key()] < oldestTime)
-            {
-                if ((2 == it.value()->IncrRef()) && (it.value() != im))
-                {
-                    oldestTime = d->m_cacheTrack[it.key()];
-                    oldestKey = it.key();
-                    count++;
-                }
-                it.value()->DecrRef();
-            }
+            evictable = (2 == oldest->IncrRef());
+            oldest->DecrRef();
         }
 
-        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
-            QString("%1 images are eligible for expiry").arg(count));
-
-        if (count > 0)
+        if (!evictable)
         {
-            LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
-                QString("Cache too big (%1), removing :%2:")
-                .arg(d->m_cacheSize.fetchAndAddOrdered(0) +
-#if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-		     im->byteCount()
-#else
-		     im->sizeInBytes()
-#endif
-		     )
-                .arg(oldestKey));
-
-            d->m_imageCache[oldestKey]->SetIsInCache(false);
-            d->m_imageCache[oldestKey]->DecrRef();
-            d->m_imageCache.remove(oldestKey);
-            d->m_cacheTrack.remove(oldestKey);
-        }
-        else
-        {
-            break;
+            ++lru;
+            continue;
         }
+
+        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
+            QString("Cache too big (%1), removing :%2:")
+            .arg(d->m_cacheSize.fetchAndAddOrdered(0) + imSize)
+            .arg(oldestKey));
+
+        ++lru;
+        oldest->SetIsInCache(false);
+        oldest->DecrRef();
+        d->m_imageCache.remove(oldestKey);
+        d->m_cacheTrack.remove(oldestKey);
+        d->RemoveCacheEntry(oldestKey);
+        d->m_cacheEvicted.fetchAndAddRelaxed(1);
     }
 
     QMap<QString, MythImage *>::iterator it = d->m_imageCache.find(url);
@@ -531,6 +579,7 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
 #else
         d->m_cacheTrack[url] = MythDate::current().toSecsSinceEpoch();
 #endif
+        d->TouchCacheEntry(url);
 
         im->SetIsInCache(true);
         LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
@@ -563,6 +612,7 @@ void MythUIHelper::RemoveFromCacheByURL(const QString &url)
         d->m_imageCache[url]->DecrRef();
         d->m_imageCache.remove(url);
         d->m_cacheTrack.remove(url);
+        d->RemoveCacheEntry(url);
     }
 
     QString dstfile;
@@ -613,6 +663,20 @@ void MythUIHelper::RemoveFromCacheByFile(const QString &fname)
     }
 }
 
+MythUIImageCacheStats MythUIHelper::GetImageCacheStats(void)
+{
+    QMutexLocker locker(d->m_cacheLock);
+
+    MythUIImageCacheStats stats;
+    stats.m_size    = d->m_cacheSize.fetchAndAddRelaxed(0);
+    stats.m_maxSize = d->m_maxCacheSize.fetchAndAddRelaxed(0);
+    stats.m_count   = d->m_imageCache.count();
+    stats.m_hits    = d->m_cacheHits.fetchAndAddRelaxed(0);
+    stats.m_misses  = d->m_cacheMisses.fetchAndAddRelaxed(0);
+    stats.m_evicted = d->m_cacheEvicted.fetchAndAddRelaxed(0);
+    return stats;
+}
+
 bool MythUIHelper::IsImageInCache(const QString &url)
 {
     QMutexLocker locker(d->m_cacheLock);
@@ -1248,6 +1312,8 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, const QString& label,
         if (d->m_imageCache.contains(label) &&
             d->m_cacheTrack[label] + kImageCacheTimeout > now)
         {
+            d->TouchCacheEntry(label);
+            d->m_cacheHits.fetchAndAddRelaxed(1);
             d->m_imageCache[label]->IncrRef();
             return d->m_imageCache[label];
         }
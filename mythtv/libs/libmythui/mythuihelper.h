@@ -29,6 +29,23 @@ enum ImageCacheMode
     kCacheForceStat       = 0x4,
 };
 
+/// Image loader queue priorities, lower values are dequeued first
+enum ImageLoadPriority
+{
+    kImageLoadVisible     = 0,
+    kImageLoadPrefetch    = 10,
+};
+
+struct MUI_PUBLIC MythUIImageCacheStats
+{
+    qint64 m_size    {0};
+    qint64 m_maxSize {0};
+    int    m_count   {0};
+    uint   m_hits    {0};
+    uint   m_misses  {0};
+    uint   m_evicted {0};
+};
+
 struct MUI_PUBLIC MythUIMenuCallbacks
 {
     void (*exec_program)(const QString &cmd);
@@ -62,6 +79,7 @@ class MUI_PUBLIC MythUIHelper
 
     void IncludeInCacheSize(MythImage *im);
     void ExcludeFromCacheSize(MythImage *im);
+    MythUIImageCacheStats GetImageCacheStats(void);
 
     bool IsScreenSetup(void);
     static bool IsTopScreenInitialized(void);
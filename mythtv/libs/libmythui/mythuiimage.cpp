@@ -16,6 +16,7 @@
 #include <QImageReader>
 #include <QReadWriteLock>
 #include <QRunnable>
+#include <QSet>
 
 // libmythbase
 #include "mythlogging.h"
@@ -108,6 +109,61 @@ class ImageLoader
     static QMutex                        m_loadingImagesLock;
     static QWaitCondition                m_loadingImagesCond;
 
+    // Background loads are tagged with a per widget generation, queued
+    // loads whose generation is stale are dropped without touching the disk.
+    static QHash<const MythUIImage *, uint> m_loadGenerations;
+    static QHash<const MythUIImage *, int>  m_activeLoads;
+    static uint                             m_nextGeneration;
+    static QSet<QString>                    m_prefetching;
+
+    /**
+     *  \brief Invalidate all queued loads for this widget.
+     *  \return The generation to tag new loads for this widget with.
+     */
+    static uint CancelLoads(const MythUIImage *uitype)
+    {
+        QMutexLocker locker(&m_loadingImagesLock);
+        uint generation = ++m_nextGeneration;
+        m_loadGenerations[uitype] = generation;
+        return generation;
+    }
+
+    /// Returns false if the load was cancelled while it sat in the queue
+    static bool BeginLoad(const MythUIImage *uitype, uint generation)
+    {
+        if (!uitype)
+            return true;
+
+        QMutexLocker locker(&m_loadingImagesLock);
+        if (m_loadGenerations.value(uitype) != generation)
+            return false;
+        m_activeLoads[uitype]++;
+        return true;
+    }
+
+    static void EndLoad(const MythUIImage *uitype)
+    {
+        if (!uitype)
+            return;
+
+        QMutexLocker locker(&m_loadingImagesLock);
+        if (--m_activeLoads[uitype] <= 0)
+            m_activeLoads.remove(uitype);
+        m_loadingImagesCond.wakeAll();
+    }
+
+    /**
+     *  \brief Cancel queued loads for a widget that is going away and wait
+     *         for any that are already running to post their results.
+     */
+    static void ReleaseWidget(const MythUIImage *uitype)
+    {
+        QMutexLocker locker(&m_loadingImagesLock);
+        m_loadGenerations.remove(uitype);
+        while (m_activeLoads.contains(uitype))
+            m_loadingImagesCond.wait(&m_loadingImagesLock);
+    }
+
     static bool PreLoad(const QString &cacheKey, const MythUIImage *uitype)
     {
         m_loadingImagesLock.lock();
@@ -142,6 +198,63 @@ class ImageLoader
         m_loadingImagesLock.unlock();
     }
 
+    /**
+     *  \brief Decode straight to the requested size where the image format
+     *         supports it, instead of decoding at full size and scaling.
+     *
+     *  Only used where the result is identical to a decode and Resize(), i.e.
+     *  for local files with no reflection or orientation applied first.
+     */
+    static bool LoadScaled(MythImage *image, const ImageProperties &imProps,
+                           const QSize &size)
+    {
+        const QString &filename = imProps.m_filename;
+        if (!filename.startsWith('/') || size.width() <= 0 ||
+            size.height() <= 0 || imProps.m_isReflected ||
+            imProps.m_isOriented)
+            return false;
+
+        MythImageReader reader(filename);
+        if (!reader.supportsOption(QImageIOHandler::ScaledSize))
+            return false;
+
+        QSize srcSize = reader.size();
+        if (!srcSize.isValid())
+            return false;
+
+        QSize dstSize = size;
+        if (imProps.m_preserveAspect)
+            dstSize = srcSize.scaled(size, Qt::KeepAspectRatio);
+
+        // Never upscale during decode, leave that to Resize()
+        if (dstSize.width() >= srcSize.width() ||
+            dstSize.height() >= srcSize.height())
+            return false;
+
+        reader.setScaledSize(dstSize);
+        if (!image->Load(&reader))
+            return false;
+
+        image->SetFileName(filename);
+        return true;
+    }
+
+    /// Returns false if the image is already queued for prefetch
+    static bool QueuePrefetch(const QString &cacheKey)
+    {
+        QMutexLocker locker(&m_loadingImagesLock);
+        if (m_prefetching.contains(cacheKey))
+            return false;
+        m_prefetching.insert(cacheKey);
+        return true;
+    }
+
+    static void PrefetchDone(const QString &cacheKey)
+    {
+        QMutexLocker locker(&m_loadingImagesLock);
+        m_prefetching.remove(cacheKey);
+    }
+
     static bool SupportsAnimation(const QString &filename)
     {
         QString extension = filename.section('.', -1);
@@ -275,6 +388,8 @@ class ImageLoader
 
             if (imageReader)
                 ok = image->Load(imageReader);
+            else if (bResize && LoadScaled(image, imProps, QSize(w, h)))
+                ok = true;
             else
                 ok = image->Load(filename);
 
@@ -426,6 +541,10 @@ class ImageLoader
 QHash<QString, const MythUIImage *> ImageLoader::m_loadingImages;
 QMutex                              ImageLoader::m_loadingImagesLock;
 QWaitCondition                      ImageLoader::m_loadingImagesCond;
+QHash<const MythUIImage *, uint>    ImageLoader::m_loadGenerations;
+QHash<const MythUIImage *, int>     ImageLoader::m_activeLoads;
+uint                                ImageLoader::m_nextGeneration = 0;
+QSet<QString>                       ImageLoader::m_prefetching;
 
 /*!
  * \class ImageLoadEvent
@@ -484,17 +603,43 @@ class ImageLoadThread : public QRunnable
   public:
     ImageLoadThread(MythUIImage *parent, MythPainter *painter,
                     const ImageProperties &imProps, QString basefile,
-                    int number, ImageCacheMode mode) :
+                    int number, ImageCacheMode mode, uint generation = 0) :
         m_parent(parent), m_painter(painter), m_imageProperties(imProps),
-        m_basefile(std::move(basefile)), m_number(number), m_cacheMode(mode)
+        m_basefile(std::move(basefile)), m_number(number), m_cacheMode(mode),
+        m_generation(generation)
     {
     }
 
     void run() override // QRunnable
+    {
+        // The widget has since been given another image, or deleted
+        if (!ImageLoader::BeginLoad(m_parent, m_generation))
+            return;
+
+        Load();
+
+        ImageLoader::EndLoad(m_parent);
+    }
+
+  private:
+    void Load(void)
     {
         bool aborted = false;
         QString filename =  m_imageProperties.m_filename;
 
+        // A prefetch has no widget to deliver to, it only warms the cache
+        if (!m_parent)
+        {
+            MythImage *image = ImageLoader::LoadImage(m_painter,
+                                                      m_imageProperties,
+                                                      m_cacheMode, m_parent,
+                                                      aborted);
+            if (image)
+                image->DecrRef();
+            ImageLoader::PrefetchDone(ImageLoader::GenImageLabel(m_imageProperties));
+            return;
+        }
+
         // NOTE Do NOT use MythImageReader::supportsAnimation here, it defeats
         // the point of caching remote images
         if (ImageLoader::SupportsAnimation(filename))
@@ -528,13 +673,13 @@ class ImageLoadThread : public QRunnable
         QCoreApplication::postEvent(m_parent, le);
     }
 
-private:
     MythUIImage       *m_parent  {nullptr};
     MythPainter       *m_painter {nullptr};
     ImageProperties m_imageProperties;
     QString         m_basefile;
     int             m_number;
     ImageCacheMode  m_cacheMode;
+    uint            m_generation;
 };
 
 /////////////////////////////////////////////////////////////////
@@ -597,13 +742,10 @@ MythUIImage::MythUIImage(MythUIType *parent, const QString &name)
 
 MythUIImage::~MythUIImage()
 {
-    // Wait until all image loading threads are complete or bad things
-    // may happen if this MythUIImage disappears when a queued thread
+    // Drop our queued loads and wait for any running ones to complete or
+    // bad things may happen if this MythUIImage disappears when a thread
     // needs it.
-    if (m_runningThreads > 0)
-    {
-        GetMythUI()->GetImageThreadPool()->waitForDone();
-    }
+    ImageLoader::ReleaseWidget(this);
 
     Clear();
 
@@ -996,6 +1138,10 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
     if (isAnimation)
         Clear();
 
+    // Any background load still queued for the previous image is now stale,
+    // e.g. a button list item that has been scrolled out of view.
+    uint generation = ImageLoader::CancelLoads(this);
+
     bool complete = true;
 
     QString imagelabel;
@@ -1042,11 +1188,12 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
             LOG(VB_GUI | VB_FILE, LOG_DEBUG, LOC +
                 QString("Load(), spawning thread to load '%1'").arg(filename));
 
-            m_runningThreads++;
             auto *bImgThread = new ImageLoadThread(this, GetPainter(),
                                     imProps, bFilename, i,
-                                    static_cast<ImageCacheMode>(cacheMode2));
-            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad");
+                                    static_cast<ImageCacheMode>(cacheMode2),
+                                    generation);
+            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad",
+                                                     kImageLoadVisible);
         }
         else
         {
@@ -1135,6 +1282,42 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
     return true;
 }
 
+/**
+ *  \brief Queue a low priority background load of an image using this
+ *         widget's properties, without displaying it.
+ *
+ *  The image ends up decoded at the size this widget would display it at and
+ *  in the memory cache, so a later Load() of the same file is a cache hit.
+ */
+void MythUIImage::Prefetch(const QString &filename)
+{
+    if (filename.isEmpty() || ImageLoader::SupportsAnimation(filename) ||
+        getenv("DISABLETHREADEDMYTHUIIMAGE"))
+        return;
+
+    d->m_updateLock.lockForRead();
+    ImageProperties imProps = m_imageProperties;
+    d->m_updateLock.unlock();
+
+    imProps.m_filename = filename;
+    imProps.m_isThemeImage = false;
+
+    QString imagelabel = ImageLoader::GenImageLabel(imProps);
+    if (GetMythUI()->IsImageInCache(imagelabel))
+        return;
+
+    if (!ImageLoader::QueuePrefetch(imagelabel))
+        return;
+
+    LOG(VB_GUI | VB_FILE, LOG_DEBUG, LOC +
+        QString("Prefetch(), queueing '%1'").arg(filename));
+
+    auto *bImgThread = new ImageLoadThread(nullptr, GetPainter(), imProps,
+                                           filename, 0, kCacheNormal);
+    GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImagePrefetch",
+                                             kImageLoadPrefetch);
+}
+
 /**
  *  \copydoc MythUIType::Pulse()
  */
@@ -1544,8 +1727,6 @@ void MythUIImage::customEvent(QEvent *event)
         AnimationFrames *animationFrames = le->GetAnimationFrames();
         bool aborted                     = le->GetAbortState();
 
-        m_runningThreads--;
-
         d->m_updateLock.lockForRead();
         QString propFilename = m_imageProperties.m_filename;
         d->m_updateLock.unlock();
@@ -130,6 +130,7 @@ class MUI_PUBLIC MythUIImage : public MythUIType
 
     void Reset(void) override; // MythUIType
     bool Load(bool allowLoadInBackground = true, bool forceStat = false);
+    void Prefetch(const QString &filename);
 
     void Pulse(void) override; // MythUIType
 
@@ -182,8 +183,6 @@ class MUI_PUBLIC MythUIImage : public MythUIType
 
     ImageProperties m_imageProperties;
 
-    int             m_runningThreads     {0};
-
     bool            m_showingRandomImage {false};
     QString         m_imageDirectory;
 
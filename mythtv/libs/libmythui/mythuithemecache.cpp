@@ -0,0 +1,302 @@
+// Own header
+#include "mythuithemecache.h"
+
+// C++ headers
+#include <cstdlib>
+
+// QT headers
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDomDocument>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+// libmythbase headers
+#include "mythlogging.h"
+
+// Mythui headers
+#include "mythuihelper.h"
+
+#define LOC QString("ThemeCache: ")
+
+static const quint32 kCompiledMagic   = 0x4d544843; // "MTHC"
+static const quint32 kCompiledVersion = 1;
+static const int     kMaxDepth        = 64;
+
+enum CompiledNodeType : quint8
+{
+    kCompiledElement = 1,
+    kCompiledText    = 2,
+};
+
+static QMutex                     s_compiledLock;
+static QHash<QString, QByteArray> s_compiled;
+
+static void WriteElement(QDataStream &out, const QDomElement &element)
+{
+    out << element.tagName();
+
+    QDomNamedNodeMap attrs = element.attributes();
+    out << static_cast<quint32>(attrs.count());
+    for (int i = 0; i < attrs.count(); ++i)
+    {
+        QDomAttr attr = attrs.item(i).toAttr();
+        out << attr.name() << attr.value();
+    }
+
+    // Comments and processing instructions are never looked at by the
+    // parsers, only elements and text (including CDATA) are kept
+    QVector<QDomNode> children;
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling())
+    {
+        if (n.isElement() || n.isText())
+            children.append(n);
+    }
+
+    out << static_cast<quint32>(children.size());
+    foreach (const auto & child, children)
+    {
+        if (child.isElement())
+        {
+            out << static_cast<quint8>(kCompiledElement);
+            WriteElement(out, child.toElement());
+        }
+        else
+        {
+            out << static_cast<quint8>(kCompiledText) << child.toText().data();
+        }
+    }
+}
+
+static bool ReadElement(QDataStream &in, QDomDocument &doc,
+                        QDomElement &element, int depth)
+{
+    if (depth > kMaxDepth)
+        return false;
+
+    QString tagName;
+    in >> tagName;
+    element = doc.createElement(tagName);
+
+    quint32 attrCount = 0;
+    in >> attrCount;
+    for (quint32 i = 0; i < attrCount && in.status() == QDataStream::Ok; ++i)
+    {
+        QString name;
+        QString value;
+        in >> name >> value;
+        element.setAttribute(name, value);
+    }
+
+    quint32 childCount = 0;
+    in >> childCount;
+    for (quint32 i = 0; i < childCount && in.status() == QDataStream::Ok; ++i)
+    {
+        quint8 type = 0;
+        in >> type;
+        if (type == kCompiledElement)
+        {
+            QDomElement child;
+            if (!ReadElement(in, doc, child, depth + 1))
+                return false;
+            element.appendChild(child);
+        }
+        else if (type == kCompiledText)
+        {
+            QString text;
+            in >> text;
+            element.appendChild(doc.createTextNode(text));
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return in.status() == QDataStream::Ok;
+}
+
+bool MythUIThemeCache::IsEnabled(void)
+{
+    return getenv("DISABLECOMPILEDTHEMES") == nullptr;
+}
+
+QString MythUIThemeCache::CacheFile(const QString &filename,
+                                    const QString &windowname)
+{
+    QByteArray key = QCryptographicHash::hash(
+        (filename + '\n' + windowname).toUtf8(), QCryptographicHash::Md5);
+
+    return GetMythUI()->GetThemeCacheDir() + "/compiled/" +
+           QString(key.toHex()) + ".mtc";
+}
+
+/**
+ * \brief Rebuild a window's element tree from the compiled cache
+ *
+ * \param filename   Theme file the window was originally loaded from
+ * \param windowname Name of the window
+ * \param includes   Filled with the base files to load before the window
+ * \param doc        Document that owns the rebuilt elements
+ * \param window     Filled with the rebuilt window element
+ * \return false if there is no valid compiled copy of the window
+ */
+bool MythUIThemeCache::LoadWindow(const QString &filename,
+                                  const QString &windowname,
+                                  QStringList &includes, QDomDocument &doc,
+                                  QDomElement &window)
+{
+    if (!IsEnabled())
+        return false;
+
+    QFileInfo source(filename);
+    if (!source.exists())
+        return false;
+
+    QString cachefile = CacheFile(filename, windowname);
+
+    QByteArray data;
+    {
+        QMutexLocker locker(&s_compiledLock);
+        data = s_compiled.value(cachefile);
+    }
+
+    bool fromDisk = data.isEmpty();
+    if (fromDisk)
+    {
+        QFile f(cachefile);
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+        data = f.readAll();
+    }
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString srcName;
+    qint64 srcSize = 0;
+    qint64 srcModified = 0;
+    QString name;
+
+    in >> magic >> version >> srcName >> srcSize >> srcModified >> name;
+
+    if (in.status() != QDataStream::Ok || magic != kCompiledMagic ||
+        version != kCompiledVersion || srcName != filename ||
+        name != windowname || srcSize != source.size() ||
+        srcModified != source.lastModified().toMSecsSinceEpoch())
+    {
+        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
+            QString("Stale compiled copy of '%1' from '%2'")
+                .arg(windowname).arg(filename));
+        QMutexLocker locker(&s_compiledLock);
+        s_compiled.remove(cachefile);
+        QFile::remove(cachefile);
+        return false;
+    }
+
+    in >> includes;
+
+    if (!ReadElement(in, doc, window, 0))
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Corrupt compiled copy of '%1' from '%2'")
+                .arg(windowname).arg(filename));
+        QMutexLocker locker(&s_compiledLock);
+        s_compiled.remove(cachefile);
+        QFile::remove(cachefile);
+        return false;
+    }
+
+    doc.appendChild(window);
+
+    if (fromDisk)
+    {
+        QMutexLocker locker(&s_compiledLock);
+        s_compiled.insert(cachefile, data);
+    }
+
+    LOG(VB_GUI, LOG_DEBUG, LOC + QString("Loaded compiled '%1' from '%2'")
+        .arg(windowname).arg(filename));
+
+    return true;
+}
+
+/**
+ * \brief Store a window's element tree in the compiled cache
+ *
+ * \param filename   Theme file the window was loaded from
+ * \param windowname Name of the window
+ * \param includes   Base files the theme file loaded on the way to the window
+ * \param window     The parsed window element
+ */
+void MythUIThemeCache::StoreWindow(const QString &filename,
+                                   const QString &windowname,
+                                   const QStringList &includes,
+                                   const QDomElement &window)
+{
+    if (!IsEnabled())
+        return;
+
+    QFileInfo source(filename);
+    if (!source.exists())
+        return;
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    out << kCompiledMagic << kCompiledVersion << filename
+        << static_cast<qint64>(source.size())
+        << static_cast<qint64>(source.lastModified().toMSecsSinceEpoch())
+        << windowname << includes;
+    WriteElement(out, window);
+
+    QString cachefile = CacheFile(filename, windowname);
+
+    {
+        QMutexLocker locker(&s_compiledLock);
+        s_compiled.insert(cachefile, data);
+    }
+
+    QDir dir;
+    dir.mkpath(QFileInfo(cachefile).absolutePath());
+
+    // Write to a temporary file and rename so a reader never sees a
+    // partially written file
+    QString tmpfile = cachefile + ".tmp";
+    QFile f(tmpfile);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG(VB_GUI | VB_FILE, LOG_WARNING, LOC +
+            QString("Unable to write '%1'").arg(tmpfile));
+        return;
+    }
+
+    f.write(data);
+    f.close();
+
+    QFile::remove(cachefile);
+    if (!QFile::rename(tmpfile, cachefile))
+        QFile::remove(tmpfile);
+
+    LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
+        QString("Compiled '%1' from '%2' (%3 bytes)")
+            .arg(windowname).arg(filename).arg(data.size()));
+}
+
+/**
+ * \brief Drop the in memory copies, e.g. on a theme change
+ */
+void MythUIThemeCache::Clear(void)
+{
+    QMutexLocker locker(&s_compiledLock);
+    s_compiled.clear();
+}
@@ -0,0 +1,45 @@
+#ifndef MYTHUITHEMECACHE_H_
+#define MYTHUITHEMECACHE_H_
+
+#include <QString>
+#include <QStringList>
+
+#include "mythuiexp.h"
+
+class QDomDocument;
+class QDomElement;
+
+/**
+ * \class MythUIThemeCache
+ *
+ * \brief Precompiled cache of theme window definitions
+ *
+ * Loading a window from XML means parsing the whole theme file, which often
+ * holds many windows, on every screen load. The first time a window is
+ * loaded its element tree is stored in a compact binary form, together with
+ * the base files the theme file includes on the way to it. Later loads
+ * rebuild just that window's element tree from the binary form.
+ *
+ * Compiled windows are kept in memory and in the theme cache directory, which
+ * is already specific to the theme and GUI resolution. Each entry records the
+ * size and modification time of its source file and is ignored if the source
+ * has changed.
+ */
+class MUI_PUBLIC MythUIThemeCache
+{
+  public:
+    static bool LoadWindow(const QString &filename, const QString &windowname,
+                           QStringList &includes, QDomDocument &doc,
+                           QDomElement &window);
+    static void StoreWindow(const QString &filename, const QString &windowname,
+                            const QStringList &includes,
+                            const QDomElement &window);
+    static void Clear(void);
+    static bool IsEnabled(void);
+
+  private:
+    static QString CacheFile(const QString &filename,
+                             const QString &windowname);
+};
+
+#endif
@@ -0,0 +1,316 @@
+// Std
+#include <cmath>
+
+// Qt
+#include <QtMath>
+#include <QRawFont>
+#include <QFontMetrics>
+#include <QTextLayout>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythfontproperties.h"
+#include "mythrenderopengl.h"
+#include "mythopenglglyphatlas.h"
+
+#define LOC QString("GlyphAtlas: ")
+
+static const int kAtlasSize      = 1024;
+static const int kMaxGlyphSize   = 128;
+static const int kGlyphPadding   = 1;
+static const int kFloatsPerQuad  = 24;
+
+/*! \class MythOpenGLGlyphAtlas
+ *  \brief Renders plain text from a shared texture of rasterised glyphs.
+ *
+ * Rather than rendering every distinct string into its own image (and hence
+ * texture), each glyph is rasterised once into a single atlas texture and
+ * text is drawn as a batch of textured quads. This dramatically reduces texture
+ * uploads and memory use for screens that display lots of unique strings (e.g.
+ * the program guide).
+ *
+ * Only simple, single colour text is handled. Outlines, shadows, gradient
+ * brushes and rich text formatting are left to the generic MythPainter code.
+ *
+ * \note All methods must be called with the OpenGL context current.
+*/
+MythOpenGLGlyphAtlas::MythOpenGLGlyphAtlas(MythRenderOpenGL *Render)
+  : m_render(Render)
+{
+    m_vertices.reserve(kFloatsPerQuad * 64);
+}
+
+MythOpenGLGlyphAtlas::~MythOpenGLGlyphAtlas()
+{
+    if (m_render && m_texture)
+        m_render->DeleteTexture(m_texture);
+}
+
+bool MythOpenGLGlyphAtlas::CanRender(const MythFontProperties &Font)
+{
+    return !Font.hasShadow() && !Font.hasOutline() &&
+           (Font.GetBrush().style() == Qt::SolidPattern);
+}
+
+bool MythOpenGLGlyphAtlas::Create(void)
+{
+    if (m_texture)
+        return true;
+    if (m_full || !m_render)
+        return false;
+
+    int size = qMin(kAtlasSize, m_render->GetMaxTextureSize());
+    m_image = QImage(size, size, QImage::Format_RGBA8888);
+    m_image.fill(QColor(255, 255, 255, 0));
+    m_texture = m_render->CreateTextureFromQImage(&m_image);
+    if (!m_texture)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC + "Failed to create texture - disabling");
+        m_full = true;
+        return false;
+    }
+    m_render->SetTextureFilters(m_texture, QOpenGLTexture::Nearest);
+    LOG(VB_GPU, LOG_INFO, LOC + QString("Created %1x%1 glyph atlas").arg(size));
+    return true;
+}
+
+/// \brief Discard all glyphs. Called when the atlas is full.
+void MythOpenGLGlyphAtlas::Reset(void)
+{
+    LOG(VB_GPU, LOG_INFO, LOC + QString("Atlas full (%1 glyphs) - resetting").arg(m_glyphs.size()));
+    m_glyphs.clear();
+    m_image.fill(QColor(255, 255, 255, 0));
+    m_shelfX      = 0;
+    m_shelfY      = 0;
+    m_shelfHeight = 0;
+    m_dirtyTop    = 0;
+    m_dirtyBottom = m_image.height() - 1;
+}
+
+/*! \brief Return the atlas entry for the given glyph, rasterising it if needed.
+ *
+ * Returns nullptr if the glyph cannot be stored, in which case the caller must
+ * fall back to the generic text path. If the atlas is full it is reset, which
+ * invalidates any quads already generated for the current string.
+*/
+const MythOpenGLGlyphAtlas::Glyph* MythOpenGLGlyphAtlas::GetGlyph(const QRawFont &Font, quint32 Index)
+{
+    QString fontkey = QString("%1-%2-%3-%4").arg(Font.familyName()).arg(Font.styleName())
+                          .arg(Font.pixelSize()).arg(Font.weight());
+    auto fontid = m_fontIds.find(fontkey);
+    if (fontid == m_fontIds.end())
+        fontid = m_fontIds.insert(fontkey, m_fontIds.size());
+    quint64 key = (static_cast<quint64>(fontid.value()) << 32) | Index;
+
+    auto existing = m_glyphs.constFind(key);
+    if (existing != m_glyphs.constEnd())
+        return &existing.value();
+
+    Glyph glyph;
+    QImage alpha = Font.alphaMapForGlyph(Index, QRawFont::PixelAntialiasing);
+    if (alpha.isNull() || alpha.width() < 1 || alpha.height() < 1)
+    {
+        // whitespace
+        return &m_glyphs.insert(key, glyph).value();
+    }
+
+    int width  = alpha.width();
+    int height = alpha.height();
+    if (width > kMaxGlyphSize || height > kMaxGlyphSize)
+        return nullptr;
+
+    // find a home on the current shelf or start a new one
+    if (m_shelfX + width + kGlyphPadding > m_image.width())
+    {
+        m_shelfY += m_shelfHeight + kGlyphPadding;
+        m_shelfX  = 0;
+        m_shelfHeight = 0;
+    }
+    if (m_shelfY + height + kGlyphPadding > m_image.height())
+    {
+        Reset();
+        return nullptr;
+    }
+
+    glyph.m_area = QRect(m_shelfX, m_shelfY, width, height);
+    QRectF bounds = Font.boundingRect(Index);
+    glyph.m_offset = QPoint(static_cast<int>(std::floor(bounds.left())),
+                            static_cast<int>(std::floor(bounds.top())));
+    m_shelfX += width + kGlyphPadding;
+    m_shelfHeight = qMax(m_shelfHeight, height);
+
+    // copy coverage into the alpha channel of the (white) atlas
+    for (int y = 0; y < height; ++y)
+    {
+        uchar *dst = m_image.scanLine(m_shelfY + y) + (glyph.m_area.left() * 4);
+        for (int x = 0; x < width; ++x, dst += 4)
+        {
+            int coverage = 0;
+            switch (alpha.format())
+            {
+                case QImage::Format_Indexed8:
+                    coverage = qGray(alpha.color(alpha.pixelIndex(x, y)));
+                    break;
+                case QImage::Format_Alpha8:
+                case QImage::Format_Grayscale8:
+                    coverage = alpha.constScanLine(y)[x];
+                    break;
+                default:
+                    coverage = qGray(alpha.pixel(x, y));
+                    break;
+            }
+            dst[3] = static_cast<uchar>(coverage);
+        }
+    }
+
+    if (m_dirtyTop < 0 || glyph.m_area.top() < m_dirtyTop)
+        m_dirtyTop = glyph.m_area.top();
+    m_dirtyBottom = qMax(m_dirtyBottom, glyph.m_area.bottom());
+
+    return &m_glyphs.insert(key, glyph).value();
+}
+
+/// \brief Generate (clipped) quads for the given glyph runs.
+bool MythOpenGLGlyphAtlas::AddGlyphRuns(const QList<QGlyphRun> &Runs,
+                                        const QPointF &Origin, const QRect &Clip)
+{
+    auto texwidth  = static_cast<GLfloat>(m_image.width());
+    auto texheight = static_cast<GLfloat>(m_image.height());
+
+    foreach (const QGlyphRun &run, Runs)
+    {
+        QRawFont font = run.rawFont();
+        QVector<quint32> indexes  = run.glyphIndexes();
+        QVector<QPointF> positions = run.positions();
+        for (int i = 0; i < indexes.size() && i < positions.size(); ++i)
+        {
+            const Glyph *glyph = GetGlyph(font, indexes[i]);
+            if (!glyph)
+                return false;
+            if (glyph->m_area.isEmpty())
+                continue;
+
+            QPoint pos(qRound(Origin.x() + positions[i].x()),
+                       qRound(Origin.y() + positions[i].y()));
+            QRect dest(pos + glyph->m_offset, glyph->m_area.size());
+            QRect visible = dest.intersected(Clip);
+            if (visible.isEmpty())
+                continue;
+
+            QRect source = glyph->m_area.adjusted(visible.left() - dest.left(),
+                                                  visible.top() - dest.top(),
+                                                  visible.right() - dest.right(),
+                                                  visible.bottom() - dest.bottom());
+            auto left   = static_cast<GLfloat>(visible.left());
+            auto top    = static_cast<GLfloat>(visible.top());
+            auto right  = static_cast<GLfloat>(visible.left() + visible.width());
+            auto bottom = static_cast<GLfloat>(visible.top() + visible.height());
+            GLfloat s1 = source.left() / texwidth;
+            GLfloat t1 = source.top() / texheight;
+            GLfloat s2 = (source.left() + source.width()) / texwidth;
+            GLfloat t2 = (source.top() + source.height()) / texheight;
+
+            m_vertices << left  << top    << s1 << t1
+                       << right << top    << s2 << t1
+                       << left  << bottom << s1 << t2
+                       << right << top    << s2 << t1
+                       << right << bottom << s2 << t2
+                       << left  << bottom << s1 << t2;
+        }
+    }
+    return true;
+}
+
+void MythOpenGLGlyphAtlas::Render(QOpenGLFramebufferObject *Target, const QColor &Color, int Alpha)
+{
+    if (m_dirtyTop >= 0)
+    {
+        // N.B. QImage rows are contiguous, so upload the full width of the dirty band
+        m_render->glBindTexture(GL_TEXTURE_2D, m_texture->m_texture->textureId());
+        m_render->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_dirtyTop, m_image.width(),
+                                  m_dirtyBottom - m_dirtyTop + 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                                  m_image.constScanLine(m_dirtyTop));
+        m_dirtyTop = m_dirtyBottom = -1;
+    }
+
+    if (!m_vertices.isEmpty())
+        m_render->DrawGlyphs(m_texture, Target, m_vertices.constData(), m_vertices.size() / 4, Color, Alpha);
+    m_vertices.clear();
+}
+
+/*! \brief Draw Message using the layout rules of MythPainter::DrawTextPriv
+ *
+ * Returns false if the text could not be handled, in which case nothing has
+ * been drawn.
+*/
+bool MythOpenGLGlyphAtlas::DrawText(QOpenGLFramebufferObject *Target, const QRect &Area,
+                                    const QString &Message, int Flags,
+                                    const MythFontProperties &Font, int Alpha, const QRect &Clip)
+{
+    if (!CanRender(Font) || !Create())
+        return false;
+
+    QFont font = Font.face();
+    font.setStyleStrategy(QFont::OpenGLCompatible);
+
+    bool wrap = (Flags & Qt::TextWordWrap) != 0;
+    QTextOption option(Qt::Alignment(Flags) & Qt::AlignHorizontal_Mask);
+    option.setWrapMode(wrap ? QTextOption::WordWrap : QTextOption::ManualWrap);
+    QTextLayout layout(Message, font);
+    layout.setTextOption(option);
+
+    qreal height = 0;
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    while (line.isValid())
+    {
+        line.setLineWidth(Area.width());
+        line.setPosition(QPointF(0, height));
+        height += line.height();
+        line = layout.createLine();
+    }
+    layout.endLayout();
+
+    // Match the vertical 'centring' applied by MythPainter::DrawTextPriv
+    QFontMetrics metrics(Font.face());
+    int top = Area.top() + (wrap ? 0 : (Area.height() - metrics.height()) / 2);
+    if (Flags & Qt::AlignBottom)
+        top += Area.height() - qCeil(height);
+    else if (Flags & Qt::AlignVCenter)
+        top += (Area.height() - qCeil(height)) / 2;
+
+    if (!AddGlyphRuns(layout.glyphRuns(), QPointF(Area.left(), top), Clip))
+    {
+        m_vertices.clear();
+        return false;
+    }
+
+    Render(Target, Font.GetBrush().color(), Alpha);
+    return true;
+}
+
+/// \brief Draw pre-laid out text, as used by MythUIText
+bool MythOpenGLGlyphAtlas::DrawTextLayout(QOpenGLFramebufferObject *Target, const LayoutVector &Layouts,
+                                          const QPoint &Origin, const MythFontProperties &Font,
+                                          int Alpha, const QRect &Clip)
+{
+    if (!CanRender(Font) || !Create())
+        return false;
+
+    // Per range formatting (e.g. [font] markup) needs the full QPainter treatment
+    foreach (auto layout, Layouts)
+        if (!layout->formats().isEmpty())
+            return false;
+
+    foreach (auto layout, Layouts)
+    {
+        if (!AddGlyphRuns(layout->glyphRuns(), QPointF(Origin) + layout->position(), Clip))
+        {
+            m_vertices.clear();
+            return false;
+        }
+    }
+
+    Render(Target, Font.GetBrush().color(), Alpha);
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef MYTHOPENGLGLYPHATLAS_H
+#define MYTHOPENGLGLYPHATLAS_H
+
+// Qt
+#include <QHash>
+#include <QImage>
+#include <QVector>
+#include <QGlyphRun>
+#include <QOpenGLFunctions>
+
+// MythTV
+#include "mythpainter.h"
+
+class MythRenderOpenGL;
+class MythGLTexture;
+class MythFontProperties;
+class QOpenGLFramebufferObject;
+
+class MythOpenGLGlyphAtlas
+{
+  public:
+    explicit MythOpenGLGlyphAtlas(MythRenderOpenGL *Render);
+   ~MythOpenGLGlyphAtlas();
+
+    static bool CanRender(const MythFontProperties &Font);
+    bool DrawText(QOpenGLFramebufferObject *Target, const QRect &Area,
+                  const QString &Message, int Flags,
+                  const MythFontProperties &Font, int Alpha, const QRect &Clip);
+    bool DrawTextLayout(QOpenGLFramebufferObject *Target, const LayoutVector &Layouts,
+                        const QPoint &Origin, const MythFontProperties &Font,
+                        int Alpha, const QRect &Clip);
+
+  private:
+    Q_DISABLE_COPY(MythOpenGLGlyphAtlas)
+
+    struct Glyph
+    {
+        QRect  m_area   { };
+        QPoint m_offset { };
+    };
+
+    bool  Create(void);
+    void  Reset(void);
+    bool  AddGlyphRuns(const QList<QGlyphRun> &Runs, const QPointF &Origin, const QRect &Clip);
+    const Glyph* GetGlyph(const QRawFont &Font, quint32 Index);
+    void  Render(QOpenGLFramebufferObject *Target, const QColor &Color, int Alpha);
+
+    MythRenderOpenGL   *m_render      { nullptr };
+    MythGLTexture      *m_texture     { nullptr };
+    QImage              m_image       { };
+    QHash<QString,int>  m_fontIds     { };
+    QHash<quint64,Glyph> m_glyphs     { };
+    int                 m_shelfX      { 0 };
+    int                 m_shelfY      { 0 };
+    int                 m_shelfHeight { 0 };
+    int                 m_dirtyTop    { -1 };
+    int                 m_dirtyBottom { -1 };
+    bool                m_full        { false };
+    QVector<GLfloat>    m_vertices    { };
+};
+
+#endif // MYTHOPENGLGLYPHATLAS_H
@@ -33,7 +33,8 @@ class QOpenGLTimeMonitor
 class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
 {
   public:
-    MythOpenGLPerf(QString Name, QVector<QString> Names, int SampleCount = 30);
+    MythOpenGLPerf(QString Name, QVector<QString> Names, int SampleCount = 30,
+                   uint64_t LogMask = 0);
     void RecordSample    (void);
     void LogSamples      (void);
     int  GetTimersRunning(void);
@@ -46,6 +47,7 @@ class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
     int  m_timersRunning           { 0 };
     QVector<GLuint64> m_timerData  { 0 };
     QVector<QString>  m_timerNames { };
+    uint64_t          m_logMask    { 0 };
 };
 
 #endif // MYTHOPENGLPERF_H
@@ -8,6 +8,8 @@
 // MythTV
 #include "mythmainwindow_internal.h"
 #include "mythrenderopengl.h"
+#include "mythopenglperf.h"
+#include "mythopenglglyphatlas.h"
 #include "mythpainteropengl.h"
 
 using namespace std;
@@ -17,6 +19,8 @@ MythOpenGLPainter::MythOpenGLPainter(MythRenderOpenGL *Render, QWidget *Parent)
     m_render(Render)
 {
     m_mappedTextures.reserve(MAX_BUFFER_POOL);
+    m_allowClipping = qgetenv("MYTHTV_OPENGL_NOCLIP").isEmpty();
+    m_allowGlyphs   = qgetenv("MYTHTV_OPENGL_NOGLYPHS").isEmpty();
 
     if (!m_render)
         LOG(VB_GENERAL, LOG_ERR, "OpenGL painter has no render device");
@@ -52,6 +56,11 @@ void MythOpenGLPainter::FreeResources(void)
     OpenGLLocker locker(m_render);
     ClearCache();
     DeleteTextures();
+    DestroyRetainedFrame();
+    delete m_openGLPerf;
+    m_openGLPerf = nullptr;
+    delete m_glyphAtlas;
+    m_glyphAtlas = nullptr;
     if (m_mappedBufferPoolReady)
     {
         for (auto & buf : m_mappedBufferPool)
@@ -63,6 +72,33 @@ void MythOpenGLPainter::FreeResources(void)
     }
 }
 
+void MythOpenGLPainter::SetTarget(QOpenGLFramebufferObject *NewTarget)
+{
+    m_target = NewTarget;
+    m_retainedValid = false;
+}
+
+void MythOpenGLPainter::SetViewControl(ViewControls Control)
+{
+    // Someone else is drawing to the framebuffer - our retained copy of the
+    // UI will need a full refresh when we get it back
+    if (Control != m_viewControl)
+        m_retainedValid = false;
+    m_viewControl = Control;
+}
+
+/*! \brief Clipped (partial) updates are only supported when we own the
+ * framebuffer and hold a complete copy of the previous UI frame.
+ *
+ * Until the first full frame has been rendered into the retained framebuffer
+ * (and after a resize or playback has taken over the display) this returns
+ * false so that MythMainWindow repaints the whole screen.
+*/
+bool MythOpenGLPainter::SupportsClipping(void)
+{
+    return m_retainedValid && !m_target && m_viewControl.testFlag(Framebuffer);
+}
+
 void MythOpenGLPainter::DeleteTextures(void)
 {
     if (!m_render || m_textureDeleteList.empty())
@@ -149,20 +185,23 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
     DeleteTextures();
     m_render->makeCurrent();
 
+    // If using high DPI then scale the viewport
+    if (m_usingHighDPI)
+        currentsize *= m_pixelRatio;
+
+    m_retainedFrame = false;
     if (m_target || m_viewControl.testFlag(Framebuffer))
     {
-        m_render->BindFramebuffer(m_target);
-        m_render->SetBackground(0, 0, 0, 0);
-        m_render->ClearFramebuffer();
+        if (m_target || !BeginRetainedFrame(currentsize))
+        {
+            m_render->BindFramebuffer(m_target);
+            m_render->SetBackground(0, 0, 0, 0);
+            m_render->ClearFramebuffer();
+        }
     }
 
-    if (m_target || m_viewControl.testFlag(Viewport))
-    {
-        // If using high DPI then scale the viewport
-        if (m_usingHighDPI)
-            currentsize *= m_pixelRatio;
+    if (m_target || m_viewControl.testFlag(Viewport) || m_retainedFrame)
         m_render->SetViewPort(QRect(0, 0, currentsize.width(), currentsize.height()));
-    }
 }
 
 void MythOpenGLPainter::End(void)
@@ -175,7 +214,11 @@ void MythOpenGLPainter::End(void)
 
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_FRAME_END");
-    if (m_target == nullptr && m_viewControl.testFlag(Framebuffer))
+    if (m_retainedFrame)
+    {
+        EndRetainedFrame();
+    }
+    else if (m_target == nullptr && m_viewControl.testFlag(Framebuffer))
     {
         m_render->Flush();
         m_render->swapBuffers();
@@ -186,6 +229,185 @@ void MythOpenGLPainter::End(void)
     MythPainter::End();
 }
 
+/*! \brief Start rendering a frame into the retained UI framebuffer.
+ *
+ * The UI is rendered into an offscreen framebuffer that persists across frames.
+ * MythMainWindow then only needs to redraw the dirty regions, which are cleared
+ * in Clear() and scissored in SetClipRect(), before the result is copied to
+ * the screen in EndRetainedFrame().
+ *
+ * \note Partial presentation (buffer age/swap with damage) is not available via
+ * QOpenGLContext, so the complete framebuffer is still copied and swapped. The
+ * copy is a single textured quad, which is much cheaper than redrawing the
+ * whole screen stack.
+*/
+bool MythOpenGLPainter::BeginRetainedFrame(const QSize &Size)
+{
+    if (!m_allowClipping)
+        return false;
+
+    if (m_uiFramebuffer && (m_uiFramebuffer->size() != Size))
+        DestroyRetainedFrame();
+
+    if (!m_uiFramebuffer)
+    {
+        QSize size = Size;
+        m_uiFramebuffer = m_render->CreateFramebuffer(size);
+        m_uiTexture = m_render->CreateFramebufferTexture(m_uiFramebuffer);
+        if (!m_uiTexture)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, "OpenGL painter: Failed to create UI "
+                "framebuffer - clipped updates disabled");
+            DestroyRetainedFrame();
+            m_allowClipping = false;
+            return false;
+        }
+        LOG(VB_GPU, LOG_INFO, QString("OpenGL painter: Created %1x%2 UI framebuffer")
+            .arg(Size.width()).arg(Size.height()));
+
+        if (!m_openGLPerf && VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
+        {
+            m_openGLPerf = new MythOpenGLPerf("GLUIPerf: ", { "Render:", "Present:", "Swap:" },
+                                              30, VB_GPU);
+            if (!m_openGLPerf->isCreated())
+            {
+                delete m_openGLPerf;
+                m_openGLPerf = nullptr;
+            }
+        }
+    }
+
+    m_retainedFrame = true;
+
+    // start the render timer
+    if (m_openGLPerf)
+        m_openGLPerf->RecordSample();
+
+    m_render->SetScissor(QRect());
+    m_clipRect = QRect();
+    m_render->BindFramebuffer(m_uiFramebuffer);
+    if (!m_retainedValid)
+    {
+        m_render->SetBackground(0, 0, 0, 0);
+        m_render->ClearFramebuffer();
+        m_redrawArea = static_cast<qint64>(m_lastSize.width()) * m_lastSize.height();
+    }
+    else
+    {
+        m_redrawArea = 0;
+    }
+    return true;
+}
+
+/// \brief Copy the retained UI framebuffer to the screen and swap.
+void MythOpenGLPainter::EndRetainedFrame(void)
+{
+    // time rendering
+    if (m_openGLPerf)
+        m_openGLPerf->RecordSample();
+
+    m_render->SetScissor(QRect());
+    m_clipRect = QRect();
+
+    // A straight copy - the framebuffer already holds the blended result
+    QRect full(QPoint(0, 0), m_uiFramebuffer->size());
+    m_render->BindFramebuffer(nullptr);
+    m_render->SetBlend(false);
+    m_render->DrawBitmap(m_uiTexture, nullptr, full, full, nullptr);
+    m_render->SetBlend(true);
+    m_render->Flush();
+
+    // time presentation
+    if (m_openGLPerf)
+        m_openGLPerf->RecordSample();
+
+    m_render->swapBuffers();
+
+    // time buffer swap and log
+    if (m_openGLPerf)
+    {
+        m_openGLPerf->RecordSample();
+        m_openGLPerf->LogSamples();
+    }
+
+    m_retainedFrame = false;
+    m_retainedValid = true;
+
+    // Track how much of the screen we actually redraw
+    static const int s_redrawFrames = 300;
+    m_redrawTotal += m_redrawArea;
+    if (++m_redrawFrames >= s_redrawFrames)
+    {
+        qint64 screen = static_cast<qint64>(m_lastSize.width()) * m_lastSize.height();
+        if (screen > 0)
+        {
+            LOG(VB_GPU, LOG_INFO, QString("OpenGL painter: Redrew %1% of the UI per frame (%2 frames)")
+                .arg(100.0 * m_redrawTotal / (static_cast<double>(screen) * m_redrawFrames), 0, 'f', 1)
+                .arg(m_redrawFrames));
+        }
+        m_redrawTotal  = 0;
+        m_redrawFrames = 0;
+    }
+}
+
+void MythOpenGLPainter::DestroyRetainedFrame(void)
+{
+    if (!m_render)
+        return;
+    m_render->DeleteTexture(m_uiTexture);
+    m_render->DeleteFramebuffer(m_uiFramebuffer);
+    m_uiTexture     = nullptr;
+    m_uiFramebuffer = nullptr;
+    m_retainedValid = false;
+}
+
+/// \brief Convert a UI rect to framebuffer coordinates (high DPI aware)
+QRect MythOpenGLPainter::ToFramebuffer(const QRect &Rect) const
+{
+    if (!m_usingHighDPI)
+        return Rect;
+    return QRect(static_cast<int>(Rect.left()   * m_pixelRatio),
+                 static_cast<int>(Rect.top()    * m_pixelRatio),
+                 static_cast<int>(Rect.width()  * m_pixelRatio),
+                 static_cast<int>(Rect.height() * m_pixelRatio));
+}
+
+void MythOpenGLPainter::SetClipRect(const QRect &ClipRect)
+{
+    if (!m_retainedFrame || ClipRect == m_clipRect)
+        return;
+    m_clipRect = ClipRect;
+    m_render->SetScissor(ToFramebuffer(ClipRect));
+}
+
+/*! \brief Clear the areas of the retained framebuffer that are about to be redrawn.
+ *
+ * \note If the framebuffer was not valid at the start of the frame, it has
+ * already been cleared in its entirety.
+*/
+void MythOpenGLPainter::Clear(QPaintDevice */*Device*/, const QRegion &Region)
+{
+    if (!m_retainedFrame || m_redrawArea)
+        return;
+
+    m_render->SetBackground(0, 0, 0, 0);
+#if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
+    QVector<QRect> rects = Region.rects();
+    for (int i = 0; i < rects.size(); i++)
+    {
+        const QRect& rect = rects[i];
+#else
+    for (const QRect& rect : Region)
+    {
+#endif
+        m_render->SetScissor(ToFramebuffer(rect));
+        m_render->ClearFramebuffer();
+        m_redrawArea += static_cast<qint64>(rect.width()) * rect.height();
+    }
+    m_render->SetScissor(QRect());
+    m_clipRect = QRect();
+}
+
 MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
 {
     if (!m_render)
@@ -278,7 +500,7 @@ void MythOpenGLPainter::DrawImage(const QRect &Dest, MythImage *Image,
             QOpenGLBuffer *vbo = texture->m_vbo;
             texture->m_vbo = m_mappedBufferPool[m_mappedBufferPoolIdx];
             texture->m_destination = QRect();
-            m_render->DrawBitmap(texture, m_target, Source, DEST, nullptr, Alpha, pixelratio);
+            m_render->DrawBitmap(texture, RenderTarget(), Source, DEST, nullptr, Alpha, pixelratio);
             texture->m_destination = QRect();
             texture->m_vbo = vbo;
             if (++m_mappedBufferPoolIdx >= MAX_BUFFER_POOL)
@@ -286,12 +508,53 @@ void MythOpenGLPainter::DrawImage(const QRect &Dest, MythImage *Image,
         }
         else
         {
-            m_render->DrawBitmap(texture, m_target, Source, DEST, nullptr, Alpha, pixelratio);
+            m_render->DrawBitmap(texture, RenderTarget(), Source, DEST, nullptr, Alpha, pixelratio);
             m_mappedTextures.append(texture);
         }
     }
 }
 
+/*! \brief Draw simple text from the glyph atlas
+ *
+ * Falls back to rendering the complete string to an image (and texture) if the
+ * font uses effects that the atlas does not support (outline, shadow etc).
+*/
+void MythOpenGLPainter::DrawText(const QRect &Area, const QString &Message, int Flags,
+                                 const MythFontProperties &Font, int Alpha,
+                                 const QRect &BoundRect)
+{
+    if (m_render && m_allowGlyphs && !m_usingHighDPI)
+    {
+        if (!m_glyphAtlas)
+            m_glyphAtlas = new MythOpenGLGlyphAtlas(m_render);
+        QRect clip = BoundRect.isEmpty() ? Area : Area.intersected(BoundRect);
+        OpenGLLocker locker(m_render);
+        if (m_glyphAtlas->DrawText(RenderTarget(), Area, Message, Flags, Font, Alpha, clip))
+            return;
+    }
+    MythPainter::DrawText(Area, Message, Flags, Font, Alpha, BoundRect);
+}
+
+void MythOpenGLPainter::DrawTextLayout(const QRect &CanvasRect, const LayoutVector &Layouts,
+                                       const FormatVector &Formats, const MythFontProperties &Font,
+                                       int Alpha, const QRect &DestRect)
+{
+    if (m_render && m_allowGlyphs && !m_usingHighDPI && Formats.isEmpty() && !CanvasRect.isNull())
+    {
+        if (!m_glyphAtlas)
+            m_glyphAtlas = new MythOpenGLGlyphAtlas(m_render);
+        // N.B. MythPainter renders the layouts into an image the size of the
+        // canvas, offset by the canvas position, and then crops it to the
+        // destination size.
+        QRect clip(DestRect.topLeft(), DestRect.size().boundedTo(CanvasRect.size()));
+        QPoint origin = DestRect.topLeft() + CanvasRect.topLeft();
+        OpenGLLocker locker(m_render);
+        if (m_glyphAtlas->DrawTextLayout(RenderTarget(), Layouts, origin, Font, Alpha, clip))
+            return;
+    }
+    MythPainter::DrawTextLayout(CanvasRect, Layouts, Formats, Font, Alpha, DestRect);
+}
+
 /*! \brief Draw a rectangle
  *
  * If it is a simple rectangle, then use our own shaders for rendering (which
@@ -307,7 +570,7 @@ void MythOpenGLPainter::DrawRect(const QRect &Area, const QBrush &FillBrush,
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render && !m_usingHighDPI)
     {
-        m_render->DrawRect(m_target, Area, FillBrush, LinePen, Alpha);
+        m_render->DrawRect(RenderTarget(), Area, FillBrush, LinePen, Alpha);
         return;
     }
     MythPainter::DrawRect(Area, FillBrush, LinePen, Alpha);
@@ -320,7 +583,7 @@ void MythOpenGLPainter::DrawRoundRect(const QRect &Area, int CornerRadius,
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render && !m_usingHighDPI)
     {
-        m_render->DrawRoundRect(m_target, Area, CornerRadius, FillBrush,
+        m_render->DrawRoundRect(RenderTarget(), Area, CornerRadius, FillBrush,
                                   LinePen, Alpha);
         return;
     }
@@ -18,6 +18,8 @@ class MythGLTexture;
 class MythRenderOpenGL;
 class QOpenGLBuffer;
 class QOpenGLFramebufferObject;
+class MythOpenGLPerf;
+class MythOpenGLGlyphAtlas;
 
 #define MAX_BUFFER_POOL 70
 
@@ -37,19 +39,26 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     explicit MythOpenGLPainter(MythRenderOpenGL *Render = nullptr, QWidget *Parent = nullptr);
    ~MythOpenGLPainter() override;
 
-    void SetTarget(QOpenGLFramebufferObject* NewTarget) { m_target = NewTarget; }
-    void SetViewControl(ViewControls Control) { m_viewControl = Control; }
+    void SetTarget(QOpenGLFramebufferObject* NewTarget);
+    void SetViewControl(ViewControls Control);
     void DeleteTextures(void);
 
     // MythPainter
     QString GetName(void) override { return QString("OpenGL"); }
     bool SupportsAnimation(void) override { return true; }
     bool SupportsAlpha(void) override { return true; }
-    bool SupportsClipping(void) override { return false; }
+    bool SupportsClipping(void) override;
     void FreeResources(void) override;
     void Begin(QPaintDevice *Parent) override;
     void End() override;
+    void SetClipRect(const QRect &ClipRect) override;
+    void Clear(QPaintDevice *Device, const QRegion &Region) override;
     void DrawImage(const QRect &Dest, MythImage *Image, const QRect &Source, int Alpha) override;
+    void DrawText(const QRect &Area, const QString &Message, int Flags,
+                  const MythFontProperties &Font, int Alpha, const QRect &BoundRect) override;
+    void DrawTextLayout(const QRect &CanvasRect, const LayoutVector &Layouts,
+                        const FormatVector &Formats, const MythFontProperties &Font,
+                        int Alpha, const QRect &DestRect) override;
     void DrawRect(const QRect &Area, const QBrush &FillBrush,
                   const QPen &LinePen, int Alpha) override;
     void DrawRoundRect(const QRect &Area, int CornerRadius,
@@ -63,6 +72,12 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
   protected:
     void  ClearCache(void);
     MythGLTexture* GetTextureFromCache(MythImage *Image);
+    bool  BeginRetainedFrame(const QSize &Size);
+    void  EndRetainedFrame(void);
+    void  DestroyRetainedFrame(void);
+    QRect ToFramebuffer(const QRect &Rect) const;
+    QOpenGLFramebufferObject* RenderTarget(void) const
+        { return m_retainedFrame ? m_uiFramebuffer : m_target; }
 
     // MythPainter
     MythImage* GetFormatImagePriv(void) override { return new MythImage(this); }
@@ -78,6 +93,20 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     MythDisplay*      m_display      { nullptr };
     bool              m_usingHighDPI { false   };
 
+    // Retained UI framebuffer, allowing partial (clipped) updates
+    bool              m_allowClipping  { true    };
+    bool              m_retainedFrame  { false   };
+    bool              m_retainedValid  { false   };
+    QOpenGLFramebufferObject* m_uiFramebuffer { nullptr };
+    MythGLTexture*    m_uiTexture      { nullptr };
+    QRect             m_clipRect       { };
+    MythOpenGLPerf*   m_openGLPerf     { nullptr };
+    qint64            m_redrawArea     { 0 };
+    bool              m_allowGlyphs    { true    };
+    MythOpenGLGlyphAtlas* m_glyphAtlas { nullptr };
+    qint64            m_redrawTotal    { 0 };
+    int               m_redrawFrames   { 0 };
+
     QMap<MythImage *, MythGLTexture*> m_imageToTextureMap;
     std::list<MythImage *>     m_ImageExpireList;
     std::list<MythGLTexture*>  m_textureDeleteList;
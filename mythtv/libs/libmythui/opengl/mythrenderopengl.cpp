@@ -609,6 +609,31 @@ void MythRenderOpenGL::SetBlend(bool Enable)
     doneCurrent();
 }
 
+/*! \brief Restrict drawing and clearing to Rect within the current viewport.
+ *
+ * Rect uses the same top-left origin as the default projection. An empty
+ * rect disables scissoring.
+*/
+void MythRenderOpenGL::SetScissor(const QRect &Rect)
+{
+    makeCurrent();
+    if (Rect.isEmpty())
+    {
+        if (m_scissor)
+            glDisable(GL_SCISSOR_TEST);
+        m_scissor = false;
+    }
+    else
+    {
+        if (!m_scissor)
+            glEnable(GL_SCISSOR_TEST);
+        m_scissor = true;
+        glScissor(Rect.left(), m_viewport.height() - Rect.top() - Rect.height(),
+                  Rect.width(), Rect.height());
+    }
+    doneCurrent();
+}
+
 void MythRenderOpenGL::SetBackground(int Red, int Green, int Blue, int Alpha)
 {
     int32_t tmp = (Red << 24) + (Green << 16) + (Blue << 8) + Alpha;
@@ -916,6 +941,45 @@ void MythRenderOpenGL::DrawBitmap(MythGLTexture **Textures, uint TextureCount,
     doneCurrent();
 }
 
+/*! \brief Draw a batch of textured, single colour quads (as triangles).
+ *
+ * Vertices are interleaved as x, y, s, t and the texture is expected to contain
+ * white texels with coverage in the alpha channel (see MythOpenGLGlyphAtlas).
+*/
+void MythRenderOpenGL::DrawGlyphs(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                                  const GLfloat *Vertices, int VertexCount,
+                                  const QColor &Color, int Alpha)
+{
+    if (!Texture || !Texture->m_texture || !Texture->m_vbo || !Vertices || VertexCount < 3)
+        return;
+
+    makeCurrent();
+    QOpenGLShaderProgram *program = m_defaultPrograms[kShaderDefault];
+    BindFramebuffer(Target);
+    SetShaderProjection(program);
+
+    program->setUniformValue("s_texture0", 0);
+    ActiveTexture(GL_TEXTURE0);
+    Texture->m_texture->bind();
+
+    // Always reallocate (orphan) the buffer to avoid stalling on the previous batch
+    QOpenGLBuffer* buffer = Texture->m_vbo;
+    buffer->bind();
+    buffer->allocate(Vertices, VertexCount * 4 * static_cast<int>(sizeof(GLfloat)));
+
+    glEnableVertexAttribArray(VERTEX_INDEX);
+    glEnableVertexAttribArray(TEXTURE_INDEX);
+    glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    glVertexAttrib4f(COLOR_INDEX, static_cast<GLfloat>(Color.redF()), static_cast<GLfloat>(Color.greenF()),
+                     static_cast<GLfloat>(Color.blueF()), static_cast<GLfloat>(Color.alphaF() * Alpha / 255.0));
+    glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 2 * sizeof(GLfloat));
+    glDrawArrays(GL_TRIANGLES, 0, VertexCount);
+    glDisableVertexAttribArray(TEXTURE_INDEX);
+    glDisableVertexAttribArray(VERTEX_INDEX);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+    doneCurrent();
+}
+
 static const float kLimitedRangeOffset = (16.0F / 255.0F);
 static const float kLimitedRangeScale  = (219.0F / 255.0F);
 
@@ -1182,6 +1246,8 @@ void MythRenderOpenGL::Init2DState(void)
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    m_scissor = false;
     glDepthMask(GL_FALSE);
     glDisable(GL_CULL_FACE);
     glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
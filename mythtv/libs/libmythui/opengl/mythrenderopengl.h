@@ -113,6 +113,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     void  PopTransformation(void);
     void  Flush(void);
     void  SetBlend(bool Enable);
+    void  SetScissor(const QRect &Rect);
     void  SetBackground(int Red, int Green, int Blue, int Alpha);
     QFunctionPointer GetProcAddress(const QString &Proc) const;
 
@@ -148,6 +149,9 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
                      QOpenGLFramebufferObject *Target,
                      const QRect &Source, const QRect &Destination,
                      QOpenGLShaderProgram *Program, int Rotation);
+    void  DrawGlyphs(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                     const GLfloat *Vertices, int VertexCount,
+                     const QColor &Color, int Alpha);
     void  DrawRect(QOpenGLFramebufferObject *Target,
                    const QRect &Area, const QBrush &FillBrush,
                    const QPen &LinePen, int Alpha);
@@ -220,6 +224,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     QRect      m_viewport;
     GLuint     m_activeTexture { 0 };
     bool       m_blend { false };
+    bool       m_scissor { false };
     int32_t    m_background { 0x00000000 };
     bool       m_fullRange { true };
     QMatrix4x4 m_projection;
@@ -22,6 +22,7 @@
 // Mythui headers
 #include "mythmainwindow.h"
 #include "mythuihelper.h"
+#include "mythuithemecache.h"
 
 /* ui type includes */
 #include "mythscreentype.h"
@@ -355,6 +356,8 @@ void XMLParseBase::ClearGlobalObjectStore(void)
 
     // clear any loaded base xml files which will force a reload the next time they are used
     loadedBaseFiles.clear();
+
+    MythUIThemeCache::Clear();
 }
 
 void XMLParseBase::ParseChildren(const QString &filename,
@@ -692,6 +695,22 @@ bool XMLParseBase::LoadWindowFromXML(const QString &xmlfile,
     foreach (const auto & dir, searchpath)
     {
         QString themefile = dir + xmlfile;
+
+        QDomDocument doc;
+        QDomElement window;
+        QStringList includes;
+        if (MythUIThemeCache::LoadWindow(themefile, windowname, includes,
+                                         doc, window))
+        {
+            LOG(VB_GUI, LOG_INFO, LOC +
+                QString("Loading window %1 from compiled %2")
+                    .arg(windowname).arg(themefile));
+            foreach (const auto & include, includes)
+                LoadBaseTheme(include);
+            ParseChildren(themefile, window, parent, showWarnings);
+            return true;
+        }
+
         LOG(VB_GUI, LOG_INFO, LOC + QString("Loading window %1 from %2").arg(windowname).arg(themefile));
         if (doLoad(windowname, parent, themefile,
                    onlyLoadWindows, showWarnings))
@@ -737,6 +756,10 @@ bool XMLParseBase::doLoad(const QString &windowname,
 
     f.close();
 
+    // Base files loaded on the way to the window, replayed when the window
+    // is later loaded from the compiled cache
+    QStringList includes;
+
     QDomElement docElem = doc.documentElement();
     QDomNode n = docElem.firstChild();
     while (!n.isNull())
@@ -749,7 +772,10 @@ bool XMLParseBase::doLoad(const QString &windowname,
                 QString include = getFirstText(e);
 
                 if (!include.isEmpty())
+                {
                      LoadBaseTheme(include);
+                     includes.append(include);
+                }
             }
 
             if (onlyLoadWindows && e.tagName() == "window")
@@ -764,10 +790,15 @@ bool XMLParseBase::doLoad(const QString &windowname,
                 }
 
                 if (!include.isEmpty())
+                {
                     LoadBaseTheme(include);
+                    includes.append(include);
+                }
 
                 if (name == windowname)
                 {
+                    MythUIThemeCache::StoreWindow(filename, windowname,
+                                                  includes, e);
                     ParseChildren(filename, e, parent, showWarnings);
                     return true;
                 }
@@ -18,12 +18,17 @@
 #include <QStringList>
 #include <QCryptographicHash>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
 #include <Qt>
 
 #include "mythconfig.h"
 #if !( CONFIG_DARWIN || CONFIG_CYGWIN || defined(__FreeBSD__) || defined(_WIN32))
 #define USE_SETSOCKOPT
+#define USE_SENDFILE
 #include <sys/sendfile.h>
+#include <poll.h>
 #endif
 #include <cerrno>
 #include <cstdlib>
@@ -54,12 +59,21 @@
 
 #include <unistd.h> // for gethostname
 
+#include <zlib.h>
+#undef Z_NULL
+#define Z_NULL nullptr
+
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
 #endif
 
 using namespace std;
 
+// Responses larger than this are compressed and sent as they are produced,
+// rather than being compressed into a second buffer up front
+static const int kStreamGzipThreshold = 256 * 1024;
+static const int kStreamGzipChunkSize = 64 * 1024;
+
 static MIMETypes g_MIMETypes[] =
 {
     // Image Mime Types
@@ -149,10 +163,14 @@ static QString StaticPage =
     "</HTML>";
 
 #ifdef USE_SETSOCKOPT
-//static const int g_on          = 1;
-//static const int g_off         = 0;
+static const int g_on          = 1;
+static const int g_off         = 0;
 #endif
 
+// Files currently being sent, keyed on the request sending them
+static QMutex                                   s_transferLock;
+static QHash<HTTPRequest *, HttpTransferInfo>   s_transfers;
+
 const char *HTTPRequest::s_szServerHeaders = "Accept-Ranges: bytes\r\n";
 
 /////////////////////////////////////////////////////////////////////////////
@@ -229,7 +247,9 @@ QString HTTPRequest::BuildResponseHeader( long long nSize )
             SetResponseHeader("Content-Disposition", QString("inline; filename=\"%2\"").arg(QString(filename.toLatin1())));
         }
 
-        SetResponseHeader("Content-Length", QString::number(nSize));
+        // A negative size indicates a chunked response (Transfer-Encoding)
+        if (nSize >= 0)
+            SetResponseHeader("Content-Length", QString::number(nSize));
 
         // See DLNA  7.4.1.3.11.4.3 Tolerance to unavailable contentFeatures.dlna.org header
         //
@@ -401,6 +421,15 @@ qint64 HTTPRequest::SendResponse( void )
 
     QBuffer compBuffer;
 
+    if (( nContentLen >= kStreamGzipThreshold ) &&
+        ( m_eType != RequestTypeHead ) &&
+        ( m_nMajor > 1 || ( m_nMajor == 1 && m_nMinor >= 1 )) &&
+        m_mapHeaders[ "accept-encoding" ].contains( "gzip" ))
+    {
+        // HTTP/1.1 client - stream the compressed body out in chunks
+        return SendChunkedGzip( m_response.buffer() );
+    }
+
     if (( nContentLen > 0 ) && m_mapHeaders[ "accept-encoding" ].contains( "gzip" ))
     {
         QByteArray compressed = gzipCompress( m_response.buffer() );
@@ -468,6 +497,116 @@ qint64 HTTPRequest::SendResponse( void )
     return( nBytes );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Compress data with gzip and write it out using chunked transfer encoding
+// as each block is produced. The client starts receiving the body straight
+// away and we avoid holding a second, compressed, copy of a large response.
+/////////////////////////////////////////////////////////////////////////////
+
+qint64 HTTPRequest::SendChunkedGzip( const QByteArray &data )
+{
+    z_stream strm;
+
+    strm.zalloc   = Z_NULL;
+    strm.zfree    = Z_NULL;
+    strm.opaque   = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in  = Z_NULL;
+
+    if (deflateInit2( &strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                      15 + 16, 8, Z_DEFAULT_STRATEGY ) != Z_OK) // gzip encoding
+    {
+        LOG(VB_HTTP, LOG_ERR, "HTTPRequest::SendChunkedGzip(): "
+                              "Failed to initialise compression");
+        return -1;
+    }
+
+    SetResponseHeader( "Content-Encoding" , "gzip"   , true );
+    SetResponseHeader( "Transfer-Encoding", "chunked", true );
+
+    QByteArray sHeader = BuildResponseHeader( -1 ).toUtf8();
+    qint64     nBytes  = WriteBlock( sHeader.constData(), sHeader.length() );
+
+    if (nBytes < sHeader.length())
+    {
+        LOG(VB_HTTP, LOG_ERR, QString("HTTPRequest::SendChunkedGzip(): "
+                                      "Incomplete write of header, "
+                                      "%1 written of %2")
+                                       .arg(nBytes).arg(sHeader.length()));
+        deflateEnd( &strm );
+        return nBytes;
+    }
+
+    QByteArray out( kStreamGzipChunkSize, '\0' );
+    const char *pIn      = data.constData();
+    int         nLeft    = data.length();
+    qint64      nZipped  = 0;
+    bool        bError   = false;
+    int         flush    = Z_NO_FLUSH;
+
+    while (!bError && flush != Z_FINISH)
+    {
+        int nIn = qMin( nLeft, kStreamGzipChunkSize );
+
+        strm.next_in  = (Bytef*)(pIn);
+        strm.avail_in = nIn;
+        pIn   += nIn;
+        nLeft -= nIn;
+        flush  = (nLeft == 0) ? Z_FINISH : Z_NO_FLUSH;
+
+        do
+        {
+            strm.next_out  = (Bytef*)(out.data());
+            strm.avail_out = kStreamGzipChunkSize;
+
+            if (deflate( &strm, flush ) == Z_STREAM_ERROR)
+            {
+                bError = true;
+                break;
+            }
+
+            int nOut = kStreamGzipChunkSize - strm.avail_out;
+
+            if (nOut == 0)
+                continue;
+
+            QByteArray chunk = QByteArray::number( nOut, 16 ) + "\r\n";
+            chunk.append( out.constData(), nOut );
+            chunk.append( "\r\n" );
+
+            qint64 nWritten = WriteBlock( chunk.constData(), chunk.length() );
+
+            if (nWritten != chunk.length())
+            {
+                bError = true;
+                break;
+            }
+
+            nBytes  += nWritten;
+            nZipped += nOut;
+
+        } while (strm.avail_out == 0);
+    }
+
+    deflateEnd( &strm );
+
+    if (bError)
+    {
+        LOG(VB_HTTP, LOG_ERR, "HTTPRequest::SendChunkedGzip(): "
+                              "Error occurred while writing response body.");
+        m_bKeepAlive = false;
+        return nBytes;
+    }
+
+    nBytes += WriteBlock( "0\r\n\r\n", 5 );
+
+    LOG(VB_HTTP, LOG_DEBUG, QString("Response Compressed Content Length: %1 "
+                                    "(%2 uncompressed, chunked)")
+                                    .arg(nZipped).arg(data.length()));
+
+    return nBytes;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -488,17 +627,8 @@ qint64 HTTPRequest::SendResponseFile( const QString& sFileName )
     // Make it so the header is sent with the data
     // ----------------------------------------------------------------------
 
-#ifdef USE_SETSOCKOPT
-//     // Never send out partially complete segments
-//     if (setsockopt(getSocketHandle(), SOL_TCP, TCP_CORK,
-//                    &g_on, sizeof( g_on )) < 0)
-//     {
-//         LOG(VB_HTTP, LOG_INFO,
-//             QString("HTTPRequest::SendResponseFile(%1) "
-//                     "setsockopt error setting TCP_CORK on " ).arg(sFileName) +
-//             ENO);
-//     }
-#endif
+    // Never send out partially complete segments
+    SetCork( true );
 
     QFile tmpFile( sFileName );
     if (tmpFile.exists( ) && tmpFile.open( QIODevice::ReadOnly ))
@@ -625,16 +755,7 @@ qint64 HTTPRequest::SendResponseFile( const QString& sFileName )
     // Turn off the option so any small remaining packets will be sent
     // ----------------------------------------------------------------------
 
-#ifdef USE_SETSOCKOPT
-//     if (setsockopt(getSocketHandle(), SOL_TCP, TCP_CORK,
-//                    &g_off, sizeof( g_off )) < 0)
-//     {
-//         LOG(VB_HTTP, LOG_INFO,
-//             QString("HTTPRequest::SendResponseFile(%1) "
-//                     "setsockopt error setting TCP_CORK off ").arg(sFileName) +
-//             ENO);
-//     }
-#endif
+    SetCork( false );
 
     // -=>TODO: Only returns header length...
     //          should we change to return total bytes?
@@ -687,6 +808,8 @@ qint64 HTTPRequest::SendData( QIODevice *pDevice, qint64 llStart, qint64 llBytes
 
             sent             += llBytesRead;
             llBytesRemaining -= llBytesRead;
+
+            UpdateTransfer( sent );
         }
     }
 
@@ -702,11 +825,196 @@ qint64 HTTPRequest::SendData( QIODevice *pDevice, qint64 llStart, qint64 llBytes
 
 qint64 HTTPRequest::SendFile( QFile &file, qint64 llStart, qint64 llBytes )
 {
-    qint64 sent = SendData( (QIODevice *)(&file), llStart, llBytes );
+    {
+        QMutexLocker locker( &s_transferLock );
+        HttpTransferInfo &info = s_transfers[ this ];
+        info.m_peer    = GetPeerAddress();
+        info.m_file    = file.fileName();
+        info.m_size    = llBytes;
+        info.m_started = MythDate::current();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+#ifdef USE_SENDFILE
+    // Tell the kernel we will be reading through the range, so it reads
+    // ahead aggressively rather than waiting for us to fault pages in
+    if (file.handle() >= 0)
+    {
+        (void)posix_fadvise( file.handle(), llStart, llBytes,
+                             POSIX_FADV_SEQUENTIAL );
+        (void)posix_fadvise( file.handle(), llStart,
+                             std::min( llBytes, (qint64)(4 * 1024 * 1024) ),
+                             POSIX_FADV_WILLNEED );
+    }
+#endif
+
+    // Let the kernel copy straight from the page cache to the socket when
+    // we can. SSL connections have to pass through QSslSocket to be
+    // encrypted, so always use the copy loop.
+    qint64 sent      = -2;
+    bool   bZeroCopy = false;
+
+    if (!m_bEncrypted)
+    {
+        sent      = SendFileDirect( file, llStart, llBytes );
+        bZeroCopy = (sent != -2);
+    }
+
+    if (sent == -2)
+        sent = SendData( (QIODevice *)(&file), llStart, llBytes );
+
+    qint64 elapsed = std::max( timer.elapsed(), (qint64)1 );
+
+    LOG(VB_HTTP, LOG_INFO,
+        QString("HTTPRequest::SendFile(%1) - %2 bytes to %3 in %4ms "
+                "(%5 KB/s%6)")
+            .arg(file.fileName()).arg(sent).arg(GetPeerAddress())
+            .arg(elapsed).arg((std::max(sent, (qint64)0) * 1000 / 1024) / elapsed)
+            .arg(bZeroCopy ? ", sendfile" : ""));
+
+    UpdateTransfer( sent, true );
 
     return( sent );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Send part of a file using sendfile(2), which avoids copying the data
+// through user space. Returns -2 if sendfile is not usable, in which case
+// nothing has been sent and the caller should fall back to SendData.
+/////////////////////////////////////////////////////////////////////////////
+
+qint64 HTTPRequest::SendFileDirect( QFile &file, qint64 llStart, qint64 llBytes )
+{
+#ifdef USE_SENDFILE
+    static constexpr qint64 kMaxSendFileChunk = 4 * 1024 * 1024;
+    static constexpr int    kWriteTimeoutMs   = 10000;
+
+    int nSocket = getSocketHandle();
+    int nFile   = file.handle();
+
+    if (nSocket < 0 || nFile < 0)
+        return -2;
+
+    // The response header may still be sitting in the socket's buffer
+    if (!FlushBlock( kWriteTimeoutMs ))
+        return -2;
+
+    {
+        QMutexLocker locker( &s_transferLock );
+        if (s_transfers.contains( this ))
+            s_transfers[ this ].m_zeroCopy = true;
+    }
+
+    off_t  offset = llStart;
+    qint64 sent   = 0;
+
+    while (sent < llBytes)
+    {
+        size_t  count = std::min( llBytes - sent, kMaxSendFileChunk );
+        ssize_t nRet  = sendfile( nSocket, nFile, &offset, count );
+
+        if (nRet > 0)
+        {
+            sent += nRet;
+            UpdateTransfer( sent );
+            continue;
+        }
+
+        if (nRet == 0) // File shorter than expected
+            break;
+
+        if (errno == EINTR)
+            continue;
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            // The socket is non-blocking, wait for the client to catch up
+            struct pollfd pfd {};
+            pfd.fd     = nSocket;
+            pfd.events = POLLOUT;
+
+            int nPoll = poll( &pfd, 1, kWriteTimeoutMs );
+            if (nPoll > 0 && !(pfd.revents & (POLLERR | POLLHUP)))
+                continue;
+
+            LOG(VB_HTTP, LOG_WARNING,
+                QString("HTTPRequest::SendFileDirect(%1) - timed out writing "
+                        "to %2 after %3 bytes")
+                    .arg(file.fileName()).arg(GetPeerAddress()).arg(sent));
+            return -1;
+        }
+
+        // Not supported for this file/socket, fall back to copying
+        if ((errno == EINVAL || errno == ENOSYS) && sent == 0)
+            return -2;
+
+        return -1;
+    }
+
+    return sent;
+#else
+    Q_UNUSED(file);
+    Q_UNUSED(llStart);
+    Q_UNUSED(llBytes);
+    return -2;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HTTPRequest::SetCork( bool bOn )
+{
+#ifdef USE_SETSOCKOPT
+    int nSocket = getSocketHandle();
+
+    if (nSocket < 0)
+        return;
+
+    // Anything already queued in QTcpSocket must be flushed for corking to
+    // include the header; uncorking always pushes out any partial segment
+    if (!bOn || FlushBlock( 5000 ))
+    {
+        if (setsockopt( nSocket, SOL_TCP, TCP_CORK,
+                        bOn ? &g_on : &g_off, sizeof( g_on )) < 0)
+        {
+            LOG(VB_HTTP, LOG_INFO,
+                QString("HTTPRequest::SetCork() setsockopt error setting "
+                        "TCP_CORK %1 ").arg(bOn ? "on" : "off") + ENO);
+        }
+    }
+#else
+    Q_UNUSED(bOn);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HTTPRequest::UpdateTransfer( qint64 nSent, bool bDone )
+{
+    QMutexLocker locker( &s_transferLock );
+
+    if (bDone)
+        s_transfers.remove( this );
+    else if (s_transfers.contains( this ))
+        s_transfers[ this ].m_sent = nSent;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QList<HttpTransferInfo> HTTPRequest::GetActiveTransfers( void )
+{
+    QMutexLocker locker( &s_transferLock );
+    return s_transfers.values();
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -2437,6 +2745,24 @@ qint64 BufferedSocketDeviceRequest::WriteBlock(const char *pData, qint64 nLen)
 //
 /////////////////////////////////////////////////////////////////////////////
 
+bool BufferedSocketDeviceRequest::FlushBlock( int msecs )
+{
+    if (!m_pSocket)
+        return false;
+
+    while (m_pSocket->bytesToWrite() > 0)
+    {
+        if (!m_pSocket->waitForBytesWritten( msecs ))
+            return false;
+    }
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 QString BufferedSocketDeviceRequest::GetHostAddress()
 {
     return( m_pSocket->localAddress().toString() );
@@ -19,6 +19,7 @@
 #include <QBuffer>
 #include <QDateTime>
 #include <QFile>
+#include <QList>
 #include <QRegExp>
 #include <QTcpSocket>
 #include <QTextStream>
@@ -84,6 +85,20 @@ enum HttpResponseType
     ResponseTypeHeader   =  9
 };
 
+/////////////////////////////////////////////////////////////////////////////
+// A file currently being streamed, for the status page
+/////////////////////////////////////////////////////////////////////////////
+
+struct UPNP_PUBLIC HttpTransferInfo
+{
+    QString   m_peer;
+    QString   m_file;
+    qint64    m_sent    {0};
+    qint64    m_size    {0};
+    QDateTime m_started;
+    bool      m_zeroCopy {false};
+};
+
 struct MIMETypes
 {
     const char *pszExtension;
@@ -190,7 +205,11 @@ class UPNP_PUBLIC HTTPRequest
         QString         BuildResponseHeader ( long long nSize );
 
         qint64          SendData            ( QIODevice *pDevice, qint64 llStart, qint64 llBytes );
+        qint64          SendChunkedGzip     ( const QByteArray &data );
         qint64          SendFile            ( QFile &file, qint64 llStart, qint64 llBytes );
+        qint64          SendFileDirect      ( QFile &file, qint64 llStart, qint64 llBytes );
+        void            SetCork             ( bool bOn );
+        void            UpdateTransfer      ( qint64 nSent, bool bDone = false );
 
         bool            IsProtected         () const { return m_bProtected; }
         bool            IsEncrypted         () const { return m_bEncrypted; }
@@ -251,6 +270,8 @@ class UPNP_PUBLIC HTTPRequest
         static QString  Decode          ( const QString &sIn );
         static QString  GetETagHash     ( const QByteArray &data );
 
+        static QList<HttpTransferInfo> GetActiveTransfers( void );
+
         void            SetKeepAliveTimeout ( int nTimeout ) { m_nKeepAliveTimeout = nTimeout; }
 
         static bool            IsUrlProtected      ( const QString &sBaseUrl );
@@ -266,6 +287,9 @@ class UPNP_PUBLIC HTTPRequest
         virtual quint16  GetHostPort     () = 0;
         virtual QString  GetPeerAddress  () = 0;
         virtual int      getSocketHandle () = 0;
+        // Wait for buffered output to reach the socket before writing to it
+        // directly, returns false if data is still pending
+        virtual bool     FlushBlock      ( int /*msecs*/ ) { return true; }
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -292,6 +316,7 @@ class BufferedSocketDeviceRequest : public HTTPRequest
         QString  GetPeerAddress  () override; // HTTPRequest
         int      getSocketHandle () override // HTTPRequest
             {return( m_pSocket->socketDescriptor() ); }
+        bool     FlushBlock      ( int msecs ) override; // HTTPRequest
 
 };
 
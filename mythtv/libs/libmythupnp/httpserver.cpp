@@ -21,6 +21,12 @@
 // POSIX headers
 #ifndef _WIN32
 #include <sys/utsname.h> 
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif
 
 // Qt headers
@@ -30,6 +36,7 @@
 #include <QSslCipher>
 #include <QSslCertificate>
 #include <QUuid>
+#include <QElapsedTimer>
 
 // MythTV headers
 #include "upnputil.h"
@@ -40,11 +47,18 @@
 #include "htmlserver.h"
 #include "mythversion.h"
 #include "mythcorecontext.h"
+#include "mythdate.h"
 
 #include "serviceHosts/rttiServiceHost.h"
 
 using namespace std;
 
+#ifdef MSG_NOSIGNAL
+static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int kSendFlags = 0;
+#endif
+
 
 /**
  * \brief Handle an OPTIONS request
@@ -128,6 +142,27 @@ HttpServer::HttpServer() :
     LOG(VB_HTTP, LOG_NOTICE, QString("HttpServer(): Max Thread Count %1")
                                 .arg(m_threadPool.maxThreadCount()));
 
+    // Total connections, including idle keep-alive connections which (with
+    // the connection monitor) no longer occupy a worker thread
+    m_maxConnections = gCoreContext->GetNumSetting("HTTP/MaxConnections", 256);
+
+    m_monitor = new HttpConnectionMonitor(*this);
+    if (m_monitor->IsAvailable() &&
+        !gCoreContext->GetBoolSetting("HTTP/DisableConnectionMonitor", false))
+    {
+        m_monitor->start();
+    }
+    else
+    {
+        delete m_monitor;
+        m_monitor = nullptr;
+    }
+
+    LOG(VB_HTTP, LOG_NOTICE, QString("HttpServer(): Max Connections %1, "
+                                     "idle connection monitor %2")
+                                .arg(m_maxConnections)
+                                .arg(m_monitor ? "enabled" : "disabled"));
+
     // ----------------------------------------------------------------------
     // Build Platform String
     // ----------------------------------------------------------------------
@@ -173,8 +208,14 @@ HttpServer::~HttpServer()
     m_running = false;
     m_rwlock.unlock();
 
+    if (m_monitor)
+        m_monitor->Stop();
+
     m_threadPool.Stop();
 
+    delete m_monitor;
+    m_monitor = nullptr;
+
     while (!m_extensions.empty())
     {
         delete m_extensions.takeFirst();
@@ -305,6 +346,37 @@ void HttpServer::newTcpConnection(qt_socket_fd_t socket)
     if (server)
         type = server->GetServerType();
 
+    {
+        QMutexLocker locker(&m_statsLock);
+
+        if (m_maxConnections > 0 && m_stats.m_connections >= m_maxConnections)
+        {
+            m_stats.m_rejected++;
+            locker.unlock();
+
+            LOG(VB_HTTP, LOG_WARNING,
+                QString("HttpServer: Connection limit (%1) reached, "
+                        "refusing connection").arg(m_maxConnections));
+#ifndef _WIN32
+            // Best effort - the socket is non-blocking and this fits
+            // comfortably in the send buffer of a new connection
+            static const char kBusy[] =
+                "HTTP/1.1 503 Service Unavailable\r\n"
+                "Retry-After: 5\r\n"
+                "Content-Length: 0\r\n"
+                "Connection: close\r\n\r\n";
+            if (type != kSSLServer)
+                (void)::send(socket, kBusy, sizeof(kBusy) - 1, kSendFlags);
+            ::close(socket);
+#else
+            closesocket(socket);
+#endif
+            return;
+        }
+
+        m_stats.m_connections++;
+    }
+
     m_threadPool.startReserved(
         new HttpWorker(*this, socket, type
 #ifndef QT_NO_OPENSSL
@@ -421,6 +493,91 @@ void HttpServer::DelegateRequest(HTTPRequest *pRequest)
     }
 }
 
+/**
+ * \brief Hand an idle keep-alive connection to the connection monitor
+ *
+ * The socket is owned by the monitor on success, otherwise it remains the
+ * responsibility of the caller.
+ */
+bool HttpServer::ParkConnection(qt_socket_fd_t socket, PoolServerType type,
+                                int timeoutMs)
+{
+    if (!m_monitor || !IsRunning())
+        return false;
+
+    return m_monitor->Add(static_cast<int>(socket), type, timeoutMs);
+}
+
+/**
+ * \brief A parked connection has data waiting, start a worker for it
+ */
+void HttpServer::ResumeConnection(qt_socket_fd_t socket, PoolServerType type)
+{
+    if (!IsRunning())
+    {
+#ifndef _WIN32
+        ::close(socket);
+#endif
+        ConnectionClosed();
+        return;
+    }
+
+    m_threadPool.startReserved(
+        new HttpWorker(*this, socket, type
+#ifndef QT_NO_OPENSSL
+                       , m_sslConfig
+#endif
+                       , true),
+        QString("HttpServer%1").arg(socket));
+}
+
+void HttpServer::ConnectionClosed(void)
+{
+    QMutexLocker locker(&m_statsLock);
+    if (m_stats.m_connections > 0)
+        m_stats.m_connections--;
+}
+
+/**
+ * \brief Record the time taken to handle a single request
+ */
+void HttpServer::RecordRequest(qint64 elapsedMs)
+{
+    QMutexLocker locker(&m_statsLock);
+
+    auto elapsed = static_cast<quint64>(max(elapsedMs, static_cast<qint64>(0)));
+
+    m_stats.m_requests++;
+    m_stats.m_totalMs += elapsed;
+    m_stats.m_maxMs    = max(m_stats.m_maxMs, elapsed);
+    if (elapsed > 1000)
+        m_stats.m_slowRequests++;
+
+    if ((m_stats.m_requests % 1000) == 0)
+    {
+        LOG(VB_HTTP, LOG_INFO,
+            QString("HttpServer: %1 requests, average %2ms, max %3ms, "
+                    "%4 over 1s, %5 connections (%6 idle), %7 refused")
+                .arg(m_stats.m_requests)
+                .arg(m_stats.m_totalMs / m_stats.m_requests)
+                .arg(m_stats.m_maxMs)
+                .arg(m_stats.m_slowRequests)
+                .arg(m_stats.m_connections)
+                .arg(m_monitor ? m_monitor->IdleCount() : 0)
+                .arg(m_stats.m_rejected));
+    }
+}
+
+HttpServerStats HttpServer::GetStats(void)
+{
+    int idle = m_monitor ? m_monitor->IdleCount() : 0;
+
+    QMutexLocker locker(&m_statsLock);
+    HttpServerStats stats = m_stats;
+    stats.m_idle = idle;
+    return stats;
+}
+
 uint HttpServer::GetSocketTimeout(HTTPRequest* pRequest) const
 {
     int timeout = -1;
@@ -450,14 +607,17 @@ HttpWorker::HttpWorker(HttpServer &httpServer, qt_socket_fd_t sock,
 #ifndef QT_NO_OPENSSL
                        , const QSslConfiguration& sslConfig
 #endif
+                       , bool resumed
 )
            : m_httpServer(httpServer), m_socket(sock),
-             m_socketTimeout(5 * 1000), m_connectionType(type)
+             m_socketTimeout(5 * 1000), m_connectionType(type),
+             m_resumed(resumed)
 #ifndef QT_NO_OPENSSL
              , m_sslConfig(sslConfig)
 #endif
 {
-    LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): New connection")
+    if (!m_resumed)
+        LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): New connection")
                                         .arg(m_socket));
 }                  
 
@@ -477,6 +637,7 @@ void HttpWorker::run(void)
     HTTPRequest            *pRequest   = nullptr;
     QTcpSocket             *pSocket    = nullptr;
     bool                    bEncrypted = false;
+    bool                    bParked    = false;
 
     if (m_connectionType == kSSLServer)
     {
@@ -510,8 +671,12 @@ void HttpWorker::run(void)
         if (pSslSocket)
             pSocket = dynamic_cast<QTcpSocket *>(pSslSocket);
         else
+        {
+            m_httpServer.ConnectionClosed();
             return;
+        }
 #else
+        m_httpServer.ConnectionClosed();
         return;
 #endif
     }
@@ -519,10 +684,12 @@ void HttpWorker::run(void)
     {
         pSocket = new QTcpSocket();
         pSocket->setSocketDescriptor(m_socket);
-        if (!gCoreContext->CheckSubnet(pSocket))
+        // Resumed connections were checked when they were first accepted
+        if (!m_resumed && !gCoreContext->CheckSubnet(pSocket))
         {
             delete pSocket;
             pSocket = nullptr;
+            m_httpServer.ConnectionClosed();
             return;
         }
 
@@ -536,6 +703,36 @@ void HttpWorker::run(void)
         while (m_httpServer.IsRunning() && bKeepAlive && pSocket->isValid() &&
                pSocket->state() == QAbstractSocket::ConnectedState)
         {
+            // Once a request has been answered, rather than holding on to
+            // this thread while the client decides whether to send another,
+            // hand the connection to the monitor which will start a new
+            // worker when there is something to read. SSL connections keep
+            // their encryption state in the QSslSocket, so stay here.
+            if (nRequestsHandled > 0 && m_connectionType == kTCPServer &&
+                pSocket->bytesAvailable() == 0)
+            {
+                while (pSocket->bytesToWrite() > 0 &&
+                       pSocket->waitForBytesWritten(5000))
+                    ;
+
+                if (pSocket->bytesToWrite() == 0)
+                {
+#ifndef _WIN32
+                    int fd = dup(static_cast<int>(pSocket->socketDescriptor()));
+                    if (fd >= 0)
+                    {
+                        if (m_httpServer.ParkConnection(fd, m_connectionType,
+                                                        m_socketTimeout))
+                        {
+                            bParked = true;
+                            break;
+                        }
+                        ::close(fd);
+                    }
+#endif
+                }
+            }
+
             // We set a timeout on keep-alive connections to avoid blocking
             // new clients from connecting - Default at time of writing was
             // 5 seconds for initial connection, then up to 10 seconds of idle
@@ -551,6 +748,9 @@ void HttpWorker::run(void)
 
             if ( nBytes > 0)
             {
+                QElapsedTimer requestTimer;
+                requestTimer.start();
+
                 // ----------------------------------------------------------
                 // See if this is a valid request
                 // ----------------------------------------------------------
@@ -601,6 +801,15 @@ void HttpWorker::run(void)
                                 .arg(pSocket->socketDescriptor()));
                     }
 
+                    m_httpServer.RecordRequest(requestTimer.elapsed());
+
+                    LOG(VB_HTTP, LOG_DEBUG,
+                        QString("HttpWorker(%1): %2 %3 handled in %4ms")
+                            .arg(m_socket)
+                            .arg(pRequest->m_nResponseStatus)
+                            .arg(pRequest->m_sBaseUrl)
+                            .arg(requestTimer.elapsed()));
+
                     // -------------------------------------------------------
                     // Check to see if a PostProcess was registered
                     // -------------------------------------------------------
@@ -631,6 +840,18 @@ void HttpWorker::run(void)
 
     delete pRequest;
 
+    if (bParked)
+    {
+        // The monitor holds a duplicate of the descriptor, so closing ours
+        // leaves the connection open
+        LOG(VB_HTTP, LOG_DEBUG, QString("HttpWorker(%1): Connection idle "
+                                        "after %2 requests, released thread")
+                                            .arg(m_socket)
+                                            .arg(nRequestsHandled));
+        delete pSocket;
+        return;
+    }
+
     if ((pSocket->error() != QAbstractSocket::UnknownSocketError) &&
         !(bKeepAlive && pSocket->error() == QAbstractSocket::SocketTimeoutError)) // This 'error' isn't an error when keep-alive is active
     {
@@ -691,9 +912,242 @@ void HttpWorker::run(void)
     delete pSocket;
     pSocket = nullptr;
 
+    m_httpServer.ConnectionClosed();
+
 #if 0
     LOG(VB_HTTP, LOG_DEBUG, "HttpWorkerThread::run() -- end");
 #endif
 }
 
 
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpConnectionMonitor Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+HttpConnectionMonitor::HttpConnectionMonitor(HttpServer &httpServer)
+    : MThread("HttpConnectionMonitor"), m_httpServer(httpServer)
+{
+#ifdef __linux__
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, "HttpConnectionMonitor: Failed to create "
+                                 "epoll instance " + ENO);
+        return;
+    }
+
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd >= 0)
+    {
+        struct epoll_event event {};
+        event.events  = EPOLLIN;
+        event.data.fd = m_wakeFd;
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) == 0)
+            return;
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+
+    LOG(VB_GENERAL, LOG_ERR, "HttpConnectionMonitor: Failed to create "
+                             "wakeup event " + ENO);
+    close(m_epollFd);
+    m_epollFd = -1;
+#endif
+}
+
+HttpConnectionMonitor::~HttpConnectionMonitor()
+{
+    Stop();
+
+#ifndef _WIN32
+    // Anything still idle is simply closed
+    QMutexLocker locker(&m_lock);
+    foreach (int socket, m_idle.keys())
+    {
+        close(socket);
+        m_httpServer.ConnectionClosed();
+    }
+    m_idle.clear();
+
+    if (m_wakeFd >= 0)
+        close(m_wakeFd);
+    if (m_epollFd >= 0)
+        close(m_epollFd);
+#endif
+}
+
+/**
+ * \brief Start watching an idle connection
+ *
+ * Takes ownership of the socket if successful.
+ */
+bool HttpConnectionMonitor::Add(int socket, PoolServerType type, int timeoutMs)
+{
+#ifdef __linux__
+    QMutexLocker locker(&m_lock);
+
+    if (m_stopping || m_epollFd < 0)
+        return false;
+
+    IdleConnection conn;
+    conn.m_type    = type;
+    conn.m_expires = MythDate::current().toMSecsSinceEpoch() + timeoutMs;
+    m_idle.insert(socket, conn);
+
+    struct epoll_event event {};
+    event.events  = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = socket;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socket, &event) != 0)
+    {
+        LOG(VB_HTTP, LOG_ERR, QString("HttpConnectionMonitor: Failed to "
+                                      "watch socket %1 ").arg(socket) + ENO);
+        m_idle.remove(socket);
+        return false;
+    }
+
+    return true;
+#else
+    Q_UNUSED(socket);
+    Q_UNUSED(type);
+    Q_UNUSED(timeoutMs);
+    return false;
+#endif
+}
+
+int HttpConnectionMonitor::IdleCount(void)
+{
+    QMutexLocker locker(&m_lock);
+    return m_idle.size();
+}
+
+void HttpConnectionMonitor::Stop(void)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_stopping = true;
+    }
+
+    Wake();
+    wait();
+}
+
+void HttpConnectionMonitor::Wake(void)
+{
+#ifdef __linux__
+    if (m_wakeFd >= 0)
+    {
+        uint64_t one = 1;
+        if (write(m_wakeFd, &one, sizeof(one)) != sizeof(one))
+            LOG(VB_HTTP, LOG_ERR, "HttpConnectionMonitor: Wake failed " + ENO);
+    }
+#endif
+}
+
+/**
+ * \brief Close connections that have passed their keep-alive timeout.
+ *        Must be called with m_lock held.
+ */
+void HttpConnectionMonitor::CloseExpired(void)
+{
+#ifdef __linux__
+    qint64 now = MythDate::current().toMSecsSinceEpoch();
+
+    auto it = m_idle.begin();
+    while (it != m_idle.end())
+    {
+        if (it->m_expires > now)
+        {
+            ++it;
+            continue;
+        }
+
+        LOG(VB_HTTP, LOG_INFO, QString("HttpConnectionMonitor: Closing idle "
+                                       "connection %1").arg(it.key()));
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, it.key(), nullptr);
+        close(it.key());
+        m_httpServer.ConnectionClosed();
+        it = m_idle.erase(it);
+    }
+#endif
+}
+
+void HttpConnectionMonitor::run(void)
+{
+    RunProlog();
+
+#ifdef __linux__
+    static constexpr int kMaxEvents = 64;
+    struct epoll_event events[kMaxEvents];
+
+    while (true)
+    {
+        {
+            QMutexLocker locker(&m_lock);
+            if (m_stopping)
+                break;
+        }
+
+        // Wake at least once a second to expire idle connections
+        int count = epoll_wait(m_epollFd, events, kMaxEvents, 1000);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            LOG(VB_GENERAL, LOG_ERR, "HttpConnectionMonitor: epoll_wait "
+                                     "failed " + ENO);
+            break;
+        }
+
+        QList<QPair<int, PoolServerType> > ready;
+
+        {
+            QMutexLocker locker(&m_lock);
+
+            for (int i = 0; i < count; ++i)
+            {
+                int socket = events[i].data.fd;
+
+                if (socket == m_wakeFd)
+                {
+                    uint64_t value = 0;
+                    (void)read(m_wakeFd, &value, sizeof(value));
+                    continue;
+                }
+
+                auto it = m_idle.find(socket);
+                if (it == m_idle.end())
+                    continue;
+
+                epoll_ctl(m_epollFd, EPOLL_CTL_DEL, socket, nullptr);
+
+                // Readable (possibly with a final request before the client
+                // half closed) goes back to a worker, otherwise just close
+                if (events[i].events & EPOLLIN)
+                {
+                    ready.append(qMakePair(socket, it->m_type));
+                }
+                else
+                {
+                    close(socket);
+                    m_httpServer.ConnectionClosed();
+                }
+
+                m_idle.erase(it);
+            }
+
+            CloseExpired();
+        }
+
+        // Outside the lock, starting a worker may block on the thread pool
+        for (const auto &conn : qAsConst(ready))
+            m_httpServer.ResumeConnection(conn.first, conn.second);
+    }
+#endif
+
+    RunEpilog();
+}
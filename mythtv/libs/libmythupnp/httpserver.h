@@ -28,6 +28,7 @@
 #include <QRunnable>
 #include <QPointer>
 #include <QMutex>
+#include <QHash>
 #include <QList>
 #include <QSslConfiguration>
 #include <QSslError>
@@ -39,12 +40,14 @@
 #include "serverpool.h"
 #include "httprequest.h"
 #include "mthreadpool.h"
+#include "mthread.h"
 #include "upnputil.h"
 #include "compat.h"
 
 using TaskTime = struct timeval;
 
 class HttpWorkerThread;
+class HttpConnectionMonitor;
 class QScriptEngine;
 class HttpServer;
 #ifndef QT_NO_OPENSSL
@@ -101,6 +104,22 @@ class UPNP_PUBLIC HttpServerExtension : public QObject
 
 using HttpServerExtensionList = QList<QPointer<HttpServerExtension> >;
 
+/////////////////////////////////////////////////////////////////////////////
+// Aggregate request statistics, measured from the arrival of a request to
+// the response having been written to the socket.
+/////////////////////////////////////////////////////////////////////////////
+
+struct UPNP_PUBLIC HttpServerStats
+{
+    quint64 m_requests      {0};
+    quint64 m_totalMs       {0};
+    quint64 m_maxMs         {0};
+    quint64 m_slowRequests  {0}; // Took longer than one second
+    quint64 m_rejected      {0}; // Connections refused, over the limit
+    int     m_connections   {0}; // Currently open, including idle
+    int     m_idle          {0}; // Idle keep-alive, not holding a thread
+};
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -141,6 +160,13 @@ class UPNP_PUBLIC HttpServer : public ServerPool
     static QString GetPlatform(void);
     static QString GetServerVersion(void);
 
+    bool ParkConnection(qt_socket_fd_t socket, PoolServerType type,
+                        int timeoutMs);
+    void ResumeConnection(qt_socket_fd_t socket, PoolServerType type);
+    void ConnectionClosed(void);
+    void RecordRequest(qint64 elapsedMs);
+    HttpServerStats GetStats(void);
+
   protected:
     mutable QReadWriteLock  m_rwlock;
     HttpServerExtensionList m_extensions;
@@ -150,6 +176,11 @@ class UPNP_PUBLIC HttpServer : public ServerPool
     MThreadPool             m_threadPool;
     bool                    m_running    { true }; // protected by m_rwlock
 
+    HttpConnectionMonitor  *m_monitor    { nullptr };
+    int                     m_maxConnections { 0 };
+    QMutex                  m_statsLock;
+    HttpServerStats         m_stats;
+
     static QMutex           s_platformLock;
     static QString          s_platform;
 
@@ -188,6 +219,7 @@ class HttpWorker : public QRunnable
 #ifndef QT_NO_OPENSSL
                , const QSslConfiguration& sslConfig
 #endif
+               , bool resumed = false
     );
 
     void run(void) override; // QRunnable
@@ -197,11 +229,60 @@ class HttpWorker : public QRunnable
     qt_socket_fd_t m_socket;
     int         m_socketTimeout;
     PoolServerType m_connectionType;
+    bool        m_resumed; // Returning from the connection monitor
 
 #ifndef QT_NO_OPENSSL
     QSslConfiguration       m_sslConfig;
 #endif
 };
 
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpConnectionMonitor Class Definition
+//
+// Watches idle keep-alive connections so that they do not tie up a worker
+// thread while waiting for the next request. When a connection becomes
+// readable it is handed back to the HttpServer thread pool, and idle
+// connections are closed once their keep-alive timeout expires.
+//
+// Uses epoll, so is only available on Linux. Elsewhere workers wait for
+// the next request themselves, as before.
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class HttpConnectionMonitor : public MThread
+{
+  public:
+    explicit HttpConnectionMonitor(HttpServer &httpServer);
+    ~HttpConnectionMonitor() override;
+
+    bool IsAvailable(void) const { return m_epollFd >= 0; }
+    bool Add(int socket, PoolServerType type, int timeoutMs);
+    void Stop(void);
+    int  IdleCount(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    struct IdleConnection
+    {
+        PoolServerType m_type    {kTCPServer};
+        qint64         m_expires {0};
+    };
+
+    void Wake(void);
+    void CloseExpired(void);
+
+    HttpServer                 &m_httpServer;
+    int                         m_epollFd   {-1};
+    int                         m_wakeFd    {-1};
+    QMutex                      m_lock;
+    QHash<int, IdleConnection>  m_idle;     // protected by m_lock
+    bool                        m_stopping  {false}; // protected by m_lock
+};
+
 
 #endif
@@ -230,26 +230,50 @@ QString JSONSerializer::Encode(const QString &sIn)
     if (sIn.isEmpty())
         return sIn;
 
-    QString sStr = sIn;
-
-    // -=>TODO: Would it be better to just loop through string once and build 
-    // new string with encoded chars instead of calling replace multiple times?
-    // It might perform better.
-
-    sStr.replace( '\\', "\\\\" ); // This must be first
-    sStr.replace( '"' , "\\\"" ); 
-
-    sStr.replace( '\b', "\\b"  );
-    sStr.replace( '\f', "\\f"  );
-    sStr.replace( '\n', "\\n"  );
-    sStr.replace( "\r", "\\r"  );
-    sStr.replace( "\t", "\\t"  );
-    sStr.replace(  "/", "\\/"  );
-
-    // we don't handle hex values yet...
-    /*
-    if(ch>='\u0000' && ch<='\u001F')
-        sb.append("\\u####"); 
-    */
+    // Single pass - the common case is that nothing needs escaping
+
+    int nLen = sIn.length();
+    int nIdx = 0;
+
+    for (; nIdx < nLen; ++nIdx)
+    {
+        ushort ch = sIn.at( nIdx ).unicode();
+
+        if (ch < 0x20 || ch == '\\' || ch == '"' || ch == '/')
+            break;
+    }
+
+    if (nIdx == nLen)
+        return sIn;
+
+    QString sStr;
+    sStr.reserve( nLen + 16 );
+    sStr.append( sIn.constData(), nIdx );
+
+    for (; nIdx < nLen; ++nIdx)
+    {
+        QChar ch = sIn.at( nIdx );
+
+        switch (ch.unicode())
+        {
+            case '\\': sStr += "\\\\"; break;
+            case '"' : sStr += "\\\""; break;
+            case '\b': sStr += "\\b";  break;
+            case '\f': sStr += "\\f";  break;
+            case '\n': sStr += "\\n";  break;
+            case '\r': sStr += "\\r";  break;
+            case '\t': sStr += "\\t";  break;
+            case '/' : sStr += "\\/";  break;
+            default:
+            {
+                if (ch.unicode() < 0x20)
+                    sStr += QString( "\\u%1" ).arg( ch.unicode(), 4, 16, QChar('0') );
+                else
+                    sStr += ch;
+                break;
+            }
+        }
+    }
+
     return sStr;
 }
@@ -12,8 +12,10 @@
 
 #include "serializer.h"
 
+#include <QHash>
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QMutex>
 
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -106,41 +108,82 @@ void Serializer::SerializeObjectProperties( const QObject *pObject )
     {
         const QMetaObject *pMetaObject = pObject->metaObject();
 
-        int nCount = pMetaObject->propertyCount();
+        const QVector< PropertyInfo > properties = GetProperties( pMetaObject );
 
-        for (int nIdx=0; nIdx < nCount; ++nIdx ) 
+        for (const auto & prop : properties)
         {
-            QMetaProperty metaProperty = pMetaObject->property( nIdx );
+            // N.B. Designable may be a per instance method (e.g. SerializeDetails)
+            if (!prop.m_metaProp.isDesignable( pObject ))
+                continue;
 
-            if (metaProperty.isDesignable( pObject ))
+            QVariant value( prop.m_metaProp.read( pObject ) );
+
+            if (!prop.m_bTransient)
             {
-                const char *pszPropName = metaProperty.name();
-                QString     sPropName( pszPropName );
+                m_hash.addData( prop.m_sName.toUtf8() );
 
-                if ( sPropName.compare( "objectName" ) == 0)
-                    continue;
-                
-                bool bHash = false;
+                if (!value.canConvert< QObject* >())
+                    m_hash.addData( value.toString().toUtf8() );
+            }
 
-                if (ReadPropertyMetadata( pObject, 
-                                          sPropName,
-                                          "transient").toLower() != "true" )
-                {
-                    bHash = true;
-                    m_hash.addData( sPropName.toUtf8() );
-                }
+            AddProperty( prop.m_sName, value, pMetaObject, &prop.m_metaProp );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+QVector< Serializer::PropertyInfo > Serializer::GetProperties( const QMetaObject *pMetaObject )
+{
+    static QMutex s_lock;
+    static QHash< const QMetaObject*, QVector< PropertyInfo > > s_properties;
+
+    QMutexLocker locker( &s_lock );
 
-                QVariant value( pObject->property( pszPropName ) );
+    auto it = s_properties.constFind( pMetaObject );
+    if (it != s_properties.constEnd())
+        return it.value();
 
-                if (bHash && !value.canConvert< QObject* >()) 
+    QVector< PropertyInfo > properties;
+
+    int nCount = pMetaObject->propertyCount();
+
+    for (int nIdx=0; nIdx < nCount; ++nIdx )
+    {
+        PropertyInfo prop;
+
+        prop.m_metaProp = pMetaObject->property( nIdx );
+        prop.m_sName    = prop.m_metaProp.name();
+
+        if ( prop.m_sName.compare( "objectName" ) == 0)
+            continue;
+
+        // Same lookup as ReadPropertyMetadata( pObject, sName, "transient" )
+        int nInfo = pMetaObject->indexOfClassInfo( prop.m_metaProp.name() );
+
+        if (nInfo >= 0)
+        {
+            QStringList sOptions = QString( pMetaObject->classInfo( nInfo ).value() )
+                                       .split( ';' );
+
+            foreach (const QString &sOption, sOptions)
+            {
+                if (sOption.startsWith( "transient=" ))
                 {
-                    m_hash.addData( value.toString().toUtf8() );
+                    prop.m_bTransient = sOption.mid( 10 ).toLower() == "true";
+                    break;
                 }
-
-                AddProperty( sPropName, value, pMetaObject, &metaProperty );
             }
         }
+
+        properties.append( prop );
     }
+
+    s_properties.insert( pMetaObject, properties );
+
+    return properties;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -17,7 +17,9 @@
 #include "upnputil.h"
 
 #include <QList>
+#include <QVector>
 #include <QMetaType>
+#include <QMetaProperty>
 #include <QCryptographicHash>
 
 //////////////////////////////////////////////////////////////////////////////
@@ -50,6 +52,18 @@ class UPNP_PUBLIC Serializer
         void SerializeObject          ( const QObject *pObject, const QString &sName );
         void SerializeObjectProperties( const QObject *pObject );
 
+        // Per class property details, built once and cached, so that we
+        // don't have to look up names and parse metadata for every object.
+
+        struct PropertyInfo
+        {
+            QMetaProperty m_metaProp;
+            QString       m_sName;
+            bool          m_bTransient { false };
+        };
+
+        static QVector< PropertyInfo > GetProperties( const QMetaObject *pMetaObject );
+
         static QString    ReadPropertyMetadata  ( const QObject *pObject, 
                                                  const QString&  sPropName,
                                                  const QString&  sKey );
@@ -13,7 +13,9 @@
 #include "xmlSerializer.h"
 #include "mythdate.h"
 
+#include <QHash>
 #include <QMetaClassInfo>
+#include <QMutex>
 
 // --------------------------------------------------------------------------
 // This version should be bumped if the serializer code is changed in a way
@@ -321,6 +323,34 @@ QString XmlSerializer::GetItemName( const QString &sName )
 QString XmlSerializer::GetContentName( const QString        &sName, 
                                        const QMetaObject   *pMetaObject,
                                        const QMetaProperty */*pMetaProp*/ )
+{
+    // The result only depends on the class and property name, so cache it
+    // rather than parsing the classinfo for every property of every object.
+
+    static QMutex s_lock;
+    static QHash< const QMetaObject*, QHash< QString, QString > > s_cache;
+
+    QMutexLocker locker( &s_lock );
+
+    QHash< QString, QString > &names = s_cache[ pMetaObject ];
+
+    auto it = names.constFind( sName );
+    if (it != names.constEnd())
+        return it.value();
+
+    QString sContentName = ReadContentName( sName, pMetaObject );
+
+    names.insert( sName, sContentName );
+
+    return sContentName;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+QString XmlSerializer::ReadContentName( const QString     &sName,
+                                        const QMetaObject *pMetaObject )
 {
     // Try to read Name or TypeName from classinfo metadata.
 
@@ -66,6 +66,9 @@ class UPNP_PUBLIC XmlSerializer : public Serializer
                                          const QMetaObject   *pMetaObject,
                                          const QMetaProperty *pMetaProp );
 
+        static QString ReadContentName ( const QString        &sName,
+                                         const QMetaObject   *pMetaObject );
+
         static QString FindOptionValue ( const QStringList &sOptions, 
                                   const QString &sName );
 
@@ -28,6 +28,8 @@ using namespace std;
 // MythTV headers
 #include "filesysteminfo.h"
 #include "autoexpire.h"
+#include "expireforecast.h"
+#include "scheduler.h"
 #include "programinfo.h"
 #include "mythcorecontext.h"
 #include "mythdb.h"
@@ -116,6 +118,38 @@ uint64_t AutoExpire::GetDesiredSpace(int fsID) const
     return 0;
 }
 
+/**
+ *  \brief Projects the free space of each file system over the hours
+ *         of the forecast.
+ *
+ *  \note Must not be called with m_instanceLock or TVRec::s_inputsLock
+ *        held, since this takes the scheduler's lock.
+ */
+void AutoExpire::CalcForecast(ExpireForecast &forecast)
+{
+    RecList pending;
+    auto *sched = dynamic_cast<Scheduler*>(gCoreContext->GetScheduler());
+    if (sched)
+        sched->GetAllPending(pending);
+
+    QList<FileSystemInfo> fsInfos;
+    QMap<int, int64_t> desiredSpace;
+
+    m_instanceLock.lock();
+    if (m_mainServer)
+        m_mainServer->GetFilesystemInfos(fsInfos, true);
+    desiredSpace = m_desiredSpace;
+    m_instanceLock.unlock();
+
+    forecast.Calculate(fsInfos, pending, desiredSpace);
+
+    while (!pending.empty())
+    {
+        delete pending.back();
+        pending.pop_back();
+    }
+}
+
 /** \fn AutoExpire::CalcParams()
  *   Calculates how much space needs to be cleared, and how often.
  */
@@ -263,6 +297,11 @@ void AutoExpire::CalcParams()
  *   maintain enough free space on all directories in MythTV Storage Groups.
  *   The thread deletes short LiveTV programs every 2 minutes and long
  *   LiveTV and regular programs as needed every "desired_freq" minutes.
+ *
+ *   If "AutoExpireForecastHours" is set, recordings are also expired while
+ *   nothing is recording to make room for what the scheduled recordings
+ *   of the next hours are expected to write, so that the deletes do not
+ *   happen in the middle of those recordings.
  */
 void AutoExpire::RunExpirer(void)
 {
@@ -279,6 +318,20 @@ void AutoExpire::RunExpirer(void)
 
     while (m_expireThreadRun)
     {
+        // The forecast takes the scheduler's lock, so it is made before
+        // taking the inputs lock.
+        uint forecastHours =
+            gCoreContext->GetNumSetting("AutoExpireForecastHours", 0);
+        ExpireForecast forecast(m_encoderList, forecastHours);
+        if (forecastHours && (MythDate::current() >= next_expire))
+        {
+            locker.unlock();
+            CalcForecast(forecast);
+            locker.relock();
+            if (!m_expireThreadRun)
+                break;
+        }
+
         TVRec::s_inputsLock.lockForRead();
 
         curTime = MythDate::current();
@@ -325,7 +378,24 @@ void AutoExpire::RunExpirer(void)
 
             ExpireEpisodesOverMax();
 
-            ExpireRecordings();
+            QMap<int, int64_t> desiredSpace = m_desiredSpace;
+            if (forecast.GetStartTime().isValid() && IsIdle())
+            {
+                for (const auto &fc : forecast.GetFileSystems())
+                {
+                    if (fc.m_neededKB <= 0)
+                        continue;
+                    LOG(VB_FILE, LOG_INFO, LOC +
+                        QString("Nothing is recording, making room for "
+                                "%1 MB on fsID #%2 for %3 recordings in the "
+                                "next %4 hours")
+                            .arg(fc.m_neededKB / 1024).arg(fc.m_fsID)
+                            .arg(fc.m_recordings).arg(forecast.GetHours()));
+                    desiredSpace[fc.m_fsID] += fc.m_neededKB;
+                }
+            }
+
+            ExpireRecordings(desiredSpace);
         }
 
         TVRec::s_inputsLock.unlock();
@@ -354,6 +424,20 @@ void AutoExpire::Sleep(int sleepTime)
     }
 }
 
+/// True if none of the recorders are busy.
+bool AutoExpire::IsIdle(void) const
+{
+    if (!m_encoderList)
+        return false;
+
+    for (auto *enc : qAsConst(*m_encoderList))
+    {
+        if (enc->IsConnected() && enc->IsBusy())
+            return false;
+    }
+    return true;
+}
+
 /** \fn AutoExpire::ExpireLiveTV(int type)
  *  \brief This expires LiveTV programs.
  */
@@ -393,11 +477,12 @@ void AutoExpire::ExpireQuickDeleted(void)
     ClearExpireList(expireList);
 }
 
-/** \fn AutoExpire::ExpireRecordings()
+/** \fn AutoExpire::ExpireRecordings(const QMap<int, int64_t>&)
  *  \brief This expires normal recordings.
  *
+ *  \param desiredSpace The free space to reach on each file system, in KB.
  */
-void AutoExpire::ExpireRecordings(void)
+void AutoExpire::ExpireRecordings(const QMap<int, int64_t> &desiredSpace)
 {
     pginfolist_t expireList;
     pginfolist_t deleteList;
@@ -499,12 +584,12 @@ void AutoExpire::ExpireRecordings(void)
             continue;
         }
 
-        if (max((int64_t)0LL, fsit->getFreeSpace()) <
-            m_desiredSpace[fsit->getFSysID()])
+        int64_t wantedSpace = desiredSpace.value(fsit->getFSysID(), 0);
+        if (max((int64_t)0LL, fsit->getFreeSpace()) < wantedSpace)
         {
             LOG(VB_FILE, LOG_INFO,
                 QString("    Not Enough Free Space!  We want %1 MB")
-                    .arg(m_desiredSpace[fsit->getFSysID()] / 1024));
+                    .arg(wantedSpace / 1024));
 
             QMap<QString, int> dirList;
             QList<FileSystemInfo>::iterator fsit2;
@@ -528,8 +613,7 @@ void AutoExpire::ExpireRecordings(void)
             QString myHostName = gCoreContext->GetHostName();
             auto it = expireList.begin();
             while ((it != expireList.end()) &&
-                   (max((int64_t)0LL, fsit->getFreeSpace()) <
-                    m_desiredSpace[fsit->getFSysID()]))
+                   (max((int64_t)0LL, fsit->getFreeSpace()) < wantedSpace))
             {
                 ProgramInfo *p = *it;
                 ++it;
@@ -21,6 +21,7 @@ class ProgramInfo;
 class EncoderLink;
 class FileSystemInfo;
 class MainServer;
+class ExpireForecast;
 
 using pginfolist_t  = vector<ProgramInfo*>;
 using enclinklist_t = vector<EncoderLink*>;
@@ -72,6 +73,7 @@ class AutoExpire : public QObject
     void PrintExpireList(const QString& expHost = "ALL");
 
     uint64_t GetDesiredSpace(int fsID) const;
+    void CalcForecast(ExpireForecast &forecast);
 
     void GetAllExpiring(QStringList &strList);
     void GetAllExpiring(pginfolist_t &list);
@@ -95,13 +97,14 @@ class AutoExpire : public QObject
     void ExpireLiveTV(int type);
     void ExpireOldDeleted(void);
     void ExpireQuickDeleted(void);
-    void ExpireRecordings(void);
+    void ExpireRecordings(const QMap<int, int64_t> &desiredSpace);
     void ExpireEpisodesOverMax(void);
 
     void FillExpireList(pginfolist_t &expireList);
     void FillDBOrdered(pginfolist_t &expireList, int expMethod);
     static void SendDeleteMessages(pginfolist_t &deleteList);
     void Sleep(int sleepTime /*ms*/);
+    bool IsIdle(void) const;
 
     void UpdateDontExpireSet(void);
     bool IsInDontExpireSet(uint chanid, const QDateTime &recstartts) const;
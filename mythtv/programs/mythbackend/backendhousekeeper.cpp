@@ -25,6 +25,7 @@
 #include "mythcorecontext.h"
 #include "mythdownloadmanager.h"
 #include "musicmetadata.h"
+#include "programsearchindex.h"
 
 #include "enums/recStatus.h"
 
@@ -360,6 +361,15 @@ void CleanupTask::CleanupProgramListings(void)
     if (!query.exec())
         MythDB::DBError("HouseKeeper Cleaning Program Listings", query);
 
+    query.prepare("DELETE FROM programterm WHERE starttime <= "
+                  "DATE_SUB(CURRENT_DATE, INTERVAL :OFFSET DAY);");
+    query.bindValue(":OFFSET", offset);
+    if (!query.exec())
+        MythDB::DBError("HouseKeeper Cleaning Program Listings", query);
+
+    // Index the listings which were there before the index existed
+    ProgramSearchIndex::BuildIfNeeded();
+
     query.prepare("DELETE FROM record WHERE (type = :SINGLE "
                   "OR type = :OVERRIDE OR type = :DONTRECORD) "
                   "AND enddate < CURDATE();");
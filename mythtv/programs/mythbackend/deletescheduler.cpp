@@ -0,0 +1,354 @@
+// System headers
+#include <sys/stat.h>
+#include <fcntl.h>
+#ifdef __linux__
+#  include <linux/falloc.h>
+#endif
+
+// POSIX headers
+#include <unistd.h>
+
+// C headers
+#include <cerrno>
+
+// C++ headers
+#include <algorithm>
+
+// MythTV headers
+#include "deletescheduler.h"
+#include "encoderlink.h"
+#include "programinfo.h"
+#include "mythdb.h"
+#include "mythlogging.h"
+
+#define LOC QString("DeleteScheduler: ")
+
+DeleteScheduler::DeleteScheduler(QMap<int, EncoderLink *> *tvList) :
+    MThread("DeleteScheduler"), m_tvList(tvList)
+{
+}
+
+DeleteScheduler::~DeleteScheduler()
+{
+    Stop();
+}
+
+/** \fn DeleteScheduler::Enqueue(int,const QString&,off_t,const ProgramInfo*)
+ *  \brief Queues an unlinked file to be shrunk and closed.
+ *
+ *  The scheduler takes over the file descriptor. If a recording is
+ *  given it is marked as in use by a truncating delete until the
+ *  file is gone.
+ */
+void DeleteScheduler::Enqueue(int fd, const QString &filename, off_t size,
+                              const ProgramInfo *pginfo)
+{
+    DeleteEntry entry;
+    entry.m_fd       = fd;
+    entry.m_filename = filename;
+    entry.m_size     = size;
+    if (pginfo)
+    {
+        entry.m_pginfo = new ProgramInfo(*pginfo);
+        entry.m_pginfo->SetPathname(filename);
+        entry.m_pginfo->MarkAsInUse(true, kTruncatingDeleteInUseID);
+    }
+
+    QMutexLocker locker(&m_lock);
+
+    if (m_stop)
+    {
+        locker.unlock();
+        if (entry.m_pginfo)
+            entry.m_pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
+        delete entry.m_pginfo;
+        close(fd);
+        return;
+    }
+
+    m_queue.enqueue(entry);
+    m_queuedBytes += std::max(size, off_t(0));
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("Queued '%1' (%2 MB), %3 files with %4 MB to delete")
+            .arg(filename)
+            .arg(size / (1024.0 * 1024.0), 0, 'f', 1)
+            .arg(m_queue.size())
+            .arg(m_queuedBytes / (1024.0 * 1024.0), 0, 'f', 1));
+
+    if (!isRunning())
+        start();
+    m_wait.wakeAll();
+}
+
+/** \fn DeleteScheduler::Stop(void)
+ *  \brief Stops the delete thread.
+ *
+ *  Files still in the queue are closed right away, which leaves freeing
+ *  their space to the filesystem in one go.
+ */
+void DeleteScheduler::Stop(void)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_stop = true;
+        m_wait.wakeAll();
+    }
+    wait();
+
+    QMutexLocker locker(&m_lock);
+    while (!m_queue.isEmpty())
+    {
+        DeleteEntry entry = m_queue.dequeue();
+        if (entry.m_pginfo)
+            entry.m_pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
+        delete entry.m_pginfo;
+        close(entry.m_fd);
+    }
+    m_queuedBytes = 0;
+}
+
+void DeleteScheduler::run(void)
+{
+    RunProlog();
+
+    QMutexLocker locker(&m_lock);
+    while (!m_stop)
+    {
+        if (m_queue.isEmpty())
+        {
+            m_wait.wait(&m_lock);
+            continue;
+        }
+
+        // Leave the entry queued while it is shrunk, so that Stop()
+        // closes it if the thread is stopped half way.
+        DeleteEntry entry = m_queue.head();
+        locker.unlock();
+
+        GetMythDB()->GetDBManager()->PurgeIdleConnections(false);
+        bool finished = Truncate(entry);
+
+        locker.relock();
+        if (!finished)
+            continue;
+
+        m_queue.dequeue();
+        if (entry.m_pginfo)
+            entry.m_pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
+        delete entry.m_pginfo;
+
+        if (!m_queue.isEmpty())
+        {
+            LOG(VB_FILE, LOG_INFO, LOC +
+                QString("%1 files with %2 MB left to delete")
+                    .arg(m_queue.size())
+                    .arg(m_queuedBytes / (1024.0 * 1024.0), 0, 'f', 1));
+        }
+    }
+
+    RunEpilog();
+}
+
+/**
+ *  \brief Shrinks one file step by step and closes it.
+ *
+ *   Each step releases as much as the current rate allows in one step
+ *   time, rounded to whole extents. Steps end on extent boundaries so
+ *   the filesystem never has to zero a partial block.
+ *
+ *  \return false if the thread was stopped before the file was closed.
+ */
+bool DeleteScheduler::Truncate(DeleteEntry &entry)
+{
+    off_t size = entry.m_size;
+    off_t align = kExtentSize;
+
+    struct stat st {};
+    if (fstat(entry.m_fd, &st) == 0)
+    {
+        if (st.st_size > 0)
+            size = st.st_size;
+        if (st.st_blksize > align)
+            align = st.st_blksize;
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("Deleting '%1' (%2 MB)")
+            .arg(entry.m_filename)
+            .arg(size / (1024.0 * 1024.0), 0, 'f', 1));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool punch = true;
+    off_t remaining = size;
+    uint count = 0;
+    int lastPercent = 0;
+    while (remaining > 0)
+    {
+        // Keep ahead of what is being recorded, but no faster than
+        // that while recording.
+        uint64_t rate = GetWriteRate() * 6 / 5;
+        if (!m_recording)
+            rate = kIdleRate;
+        else if (rate < kMinRate)
+            rate = kMinRate;
+
+        auto increment = static_cast<off_t>(rate * kStepTime / 1000);
+        increment = std::max(align, increment - (increment % align));
+
+        off_t newsize = std::max(off_t(0), remaining - increment);
+        newsize -= newsize % align;
+
+        if (!ShrinkTo(entry, remaining, newsize, punch))
+            break;
+
+        {
+            QMutexLocker locker(&m_lock);
+            m_queuedBytes -= std::min(
+                m_queuedBytes, static_cast<uint64_t>(remaining - newsize));
+        }
+        remaining = newsize;
+
+        int percent = size ? static_cast<int>(100 * (size - remaining) / size)
+                           : 100;
+        if (percent / 10 != lastPercent / 10)
+        {
+            LOG(VB_FILE, LOG_DEBUG, LOC +
+                QString("'%1' %2% deleted, %3 MB every %4 ms")
+                    .arg(entry.m_filename).arg(percent)
+                    .arg(increment / (1024.0 * 1024.0), 0, 'f', 2)
+                    .arg(kStepTime));
+        }
+        lastPercent = percent;
+
+        if (entry.m_pginfo && ((++count % 100) == 0))
+            entry.m_pginfo->UpdateInUseMark(true);
+
+        if (remaining <= 0)
+            break;
+
+        QMutexLocker locker(&m_lock);
+        QElapsedTimer step;
+        step.start();
+        while (!m_stop && step.elapsed() < kStepTime)
+            m_wait.wait(&m_lock, static_cast<ulong>(kStepTime - step.elapsed()));
+        if (m_stop)
+            return false;
+    }
+
+    {
+        // Whatever was not released by the steps goes with the close
+        QMutexLocker locker(&m_lock);
+        m_queuedBytes -= std::min(m_queuedBytes,
+                                  static_cast<uint64_t>(remaining));
+    }
+
+    if (close(entry.m_fd))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error closing '%1'")
+                .arg(entry.m_filename) + ENO);
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("Finished deleting '%1' in %2 seconds")
+            .arg(entry.m_filename).arg(timer.elapsed() / 1000));
+
+    return true;
+}
+
+/**
+ *  \brief Releases the blocks of a file between two offsets at its end.
+ *
+ *   Where the filesystem supports it the blocks are released by punching
+ *   a hole, otherwise, or once punching has failed, the file is truncated.
+ */
+bool DeleteScheduler::ShrinkTo(DeleteEntry &entry, off_t from, off_t to,
+                               bool &punch)
+{
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+    if (punch)
+    {
+        if (fallocate(entry.m_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      to, from - to) == 0)
+            return true;
+
+        if (errno != EOPNOTSUPP && errno != ENOSYS)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Error punching hole in '%1'")
+                    .arg(entry.m_filename) + ENO);
+            return false;
+        }
+
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("Hole punching not supported for '%1', truncating")
+                .arg(entry.m_filename));
+        punch = false;
+    }
+#else
+    Q_UNUSED(from);
+    punch = false;
+#endif
+
+    if (ftruncate(entry.m_fd, to))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error truncating '%1'")
+                .arg(entry.m_filename) + ENO);
+        return false;
+    }
+    return true;
+}
+
+/**
+ *  \brief Returns the rate at which the local recorders are writing,
+ *         in bytes per second, or 0 if nothing is being recorded.
+ *
+ *   The rate is taken from the growth of the recorders' file positions
+ *   between samples and smoothed over a few samples.
+ */
+uint64_t DeleteScheduler::GetWriteRate(void)
+{
+    if (!m_tvList)
+        return 0;
+
+    if (m_sampleTimer.isValid() && m_sampleTimer.elapsed() < kSampleTime)
+        return m_writeRate;
+
+    qint64 elapsed = m_sampleTimer.isValid() ? m_sampleTimer.restart() : 0;
+    if (!elapsed)
+        m_sampleTimer.start();
+
+    QMap<int, long long> positions;
+    uint64_t written = 0;
+    bool recording = false;
+    for (auto it = m_tvList->cbegin(); it != m_tvList->cend(); ++it)
+    {
+        EncoderLink *enc = *it;
+        if (!enc->IsLocal() || !enc->IsBusyRecording())
+            continue;
+
+        recording = true;
+        long long pos = enc->GetFilePosition();
+        if (pos < 0)
+            continue;
+
+        positions[it.key()] = pos;
+        auto last = m_lastPosition.constFind(it.key());
+        if (last != m_lastPosition.constEnd() && pos > *last)
+            written += pos - *last;
+    }
+    m_lastPosition = positions;
+    m_recording = recording;
+
+    if (!recording)
+        m_writeRate = 0;
+    else if (elapsed > 0)
+    {
+        uint64_t rate = written * 1000 / elapsed;
+        m_writeRate = m_writeRate ? (m_writeRate * 3 + rate) / 4 : rate;
+    }
+
+    return m_writeRate;
+}
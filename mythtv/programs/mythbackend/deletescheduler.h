@@ -0,0 +1,83 @@
+#ifndef DELETESCHEDULER_H_
+#define DELETESCHEDULER_H_
+
+#include <cstdint>
+#include <sys/types.h>
+
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QString>
+#include <QMutex>
+#include <QQueue>
+#include <QMap>
+
+#include "mthread.h"
+
+class ProgramInfo;
+class EncoderLink;
+
+/** \class DeleteScheduler
+ *  \brief Releases the space of deleted recordings in the background.
+ *
+ *   Files are handed over already unlinked, as an open file descriptor.
+ *   They are shrunk one at a time from the end in steps, so that the
+ *   filesystem never has to free the extents of a whole recording at once
+ *   while recordings are being written. The rate follows the bandwidth the
+ *   local recorders are actually writing, instead of assuming every tuner
+ *   records a full rate HD stream.
+ */
+class DeleteScheduler : public MThread
+{
+  public:
+    explicit DeleteScheduler(QMap<int, EncoderLink *> *tvList);
+    ~DeleteScheduler() override;
+
+    void Enqueue(int fd, const QString &filename, off_t size,
+                 const ProgramInfo *pginfo = nullptr);
+    void Stop(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    class DeleteEntry
+    {
+      public:
+        int          m_fd     {-1};
+        QString      m_filename;
+        off_t        m_size   {0};
+        ProgramInfo *m_pginfo {nullptr};
+    };
+
+    bool Truncate(DeleteEntry &entry);
+    static bool ShrinkTo(DeleteEntry &entry, off_t from, off_t to,
+                         bool &punch);
+    uint64_t GetWriteRate(void);
+
+    QMap<int, EncoderLink *> *m_tvList;
+
+    QMutex              m_lock;
+    QWaitCondition      m_wait;
+    QQueue<DeleteEntry> m_queue;
+    uint64_t            m_queuedBytes {0};
+    bool                m_stop        {false};
+
+    // Only touched by the delete thread
+    QMap<int, long long> m_lastPosition;
+    QElapsedTimer        m_sampleTimer;
+    bool                 m_recording  {false};
+    uint64_t             m_writeRate  {0}; ///< bytes per second
+
+    /// Time between truncation steps in milliseconds
+    static const int      kStepTime     {500};
+    /// Recorder write rate is sampled at most this often, in milliseconds
+    static const int      kSampleTime   {2000};
+    /// Slowest rate of deletion while recording, in bytes per second
+    static const uint64_t kMinRate      {8ULL * 1024 * 1024};
+    /// Rate of deletion while nothing is recording, in bytes per second
+    static const uint64_t kIdleRate     {128ULL * 1024 * 1024};
+    /// Steps are whole multiples of this, so every step frees whole extents
+    static const off_t    kExtentSize   {1024 * 1024};
+};
+
+#endif // DELETESCHEDULER_H_
@@ -0,0 +1,260 @@
+// C++ headers
+#include <algorithm>
+
+// MythTV headers
+#include "expireforecast.h"
+#include "filesysteminfo.h"
+#include "recordinginfo.h"
+#include "encoderlink.h"
+#include "storagegroup.h"
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "mythdate.h"
+#include "mythdb.h"
+
+#define LOC QString("ExpireForecast: ")
+
+ExpireForecast::ExpireForecast(QMap<int, EncoderLink *> *tvList, uint hours) :
+    m_tvList(tvList), m_hours(std::min(hours, 7U * 24U))
+{
+}
+
+/** \fn ExpireForecast::Calculate(const QList<FileSystemInfo>&,const RecList&,const QMap<int, int64_t>&)
+ *  \brief Projects the space the pending recordings will use on each
+ *         file system from now until the end of the forecast.
+ *
+ *  \param fsInfos      The recording file systems, with their free space.
+ *  \param pending      The scheduler's list of recordings.
+ *  \param desiredSpace The free space AutoExpire keeps on each file system.
+ */
+void ExpireForecast::Calculate(const QList<FileSystemInfo> &fsInfos,
+                               const RecList &pending,
+                               const QMap<int, int64_t> &desiredSpace)
+{
+    m_startTime = MythDate::current();
+    m_endTime   = m_startTime.addSecs(m_hours * 60 * 60);
+    m_fileSystems.clear();
+    m_writes.clear();
+
+    for (const auto &fs : fsInfos)
+    {
+        if ((fs.getTotalSpace() < 0) || (fs.getUsedSpace() < 0))
+            continue;
+
+        FileSystemForecast &fc = m_fileSystems[fs.getFSysID()];
+        if (fc.m_fsID < 0)
+        {
+            fc.m_fsID      = fs.getFSysID();
+            fc.m_totalKB   = fs.getTotalSpace();
+            fc.m_freeKB    = std::max(int64_t(0), fs.getFreeSpace());
+            fc.m_desiredKB = desiredSpace.value(fc.m_fsID, 0);
+        }
+        fc.m_dirs << fs.getHostname() + ":" + fs.getPath();
+    }
+
+    LoadChannelRates();
+
+    // Place the recordings in the order they start, so that the free
+    // space compared for the ones without a directory includes the
+    // recordings before them.
+    RecList recs(pending.begin(), pending.end());
+    std::stable_sort(recs.begin(), recs.end(),
+                     [](const RecordingInfo *a, const RecordingInfo *b)
+                     { return a->GetRecordingStartTime() <
+                              b->GetRecordingStartTime(); });
+
+    for (const auto *rec : recs)
+    {
+        RecStatus::Type status = rec->GetRecordingStatus();
+        if (status != RecStatus::WillRecord && status != RecStatus::Pending &&
+            status != RecStatus::Recording  && status != RecStatus::Tuning)
+            continue;
+
+        QDateTime start = std::max(rec->GetRecordingStartTime(), m_startTime);
+        QDateTime end   = std::min(rec->GetRecordingEndTime(),   m_endTime);
+        if (start >= end)
+            continue;
+
+        int fsID = FindFileSystem(fsInfos, rec);
+        if (!m_fileSystems.contains(fsID))
+        {
+            LOG(VB_FILE, LOG_DEBUG, LOC +
+                QString("No file system found for %1")
+                    .arg(rec->toString(ProgramInfo::kRecordingKey)));
+            continue;
+        }
+
+        int64_t kbPerSec = GetRate(rec) / 1024;
+        FileSystemForecast &fc = m_fileSystems[fsID];
+        fc.m_neededKB += kbPerSec * start.secsTo(end);
+        fc.m_recordings++;
+
+        m_writes.push_back({fsID, start, end, kbPerSec});
+    }
+
+    FindFullTimes();
+
+    for (const auto &fc : qAsConst(m_fileSystems))
+    {
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("fsID #%1: %2 recordings will write %3 GB in the next "
+                    "%4 hours, %5 GB free, %6 GB wanted%7")
+                .arg(fc.m_fsID).arg(fc.m_recordings)
+                .arg(fc.m_neededKB / 1024.0 / 1024.0, 0, 'f', 1)
+                .arg(m_hours)
+                .arg(fc.m_freeKB / 1024.0 / 1024.0, 0, 'f', 1)
+                .arg(fc.m_desiredKB / 1024.0 / 1024.0, 0, 'f', 1)
+                .arg(fc.m_fullTime.isValid() ?
+                     ", full at " + fc.m_fullTime.toString(Qt::ISODate) : ""));
+    }
+}
+
+/**
+ *  \brief Loads the average rate at which each channel has been recorded.
+ *
+ *   Transcoded recordings are left out, since they say nothing about
+ *   the rate of the broadcast.
+ */
+void ExpireForecast::LoadChannelRates(void)
+{
+    if (!m_channelRates.isEmpty())
+        return;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "SELECT chanid, SUM(filesize) / "
+        "       SUM(TIMESTAMPDIFF(SECOND, starttime, endtime)) "
+        "FROM recorded "
+        "WHERE filesize > 0 AND transcoded = 0 AND "
+        "      endtime > starttime AND "
+        "      starttime > DATE_SUB(NOW(), INTERVAL 60 DAY) "
+        "GROUP BY chanid");
+
+    if (!query.exec())
+    {
+        MythDB::DBError(LOC + "LoadChannelRates", query);
+        return;
+    }
+
+    while (query.next())
+    {
+        auto rate = static_cast<int64_t>(query.value(1).toDouble());
+        if (rate > 0)
+            m_channelRates[query.value(0).toUInt()] = rate;
+    }
+}
+
+/// Returns the bytes per second a recording is expected to write.
+int64_t ExpireForecast::GetRate(const RecordingInfo *rec)
+{
+    auto it = m_channelRates.constFind(rec->GetChanID());
+    if (it != m_channelRates.constEnd())
+        return *it;
+
+    uint inputid = rec->GetInputID();
+    auto iit = m_inputRates.constFind(inputid);
+    if (iit != m_inputRates.constEnd())
+        return *iit;
+
+    int64_t rate = 0;
+    EncoderLink *enc = m_tvList ? m_tvList->value(inputid, nullptr) : nullptr;
+    if (enc && enc->IsConnected())
+        rate = enc->GetMaxBitrate() / 8;
+    if (rate <= 0)
+        rate = 19500000LL / 8; // same default as AutoExpire::CalcParams()
+
+    m_inputRates[inputid] = rate;
+    return rate;
+}
+
+/**
+ *  \brief Returns the file system a recording will be written to.
+ *
+ *   That is the directory the scheduler has chosen already, or else the
+ *   file system of the recording's storage group on the recorder's host
+ *   with the most projected free space.
+ */
+int ExpireForecast::FindFileSystem(const QList<FileSystemInfo> &fsInfos,
+                                   const RecordingInfo *rec)
+{
+    QString host = rec->GetHostname();
+    EncoderLink *enc = m_tvList ?
+        m_tvList->value(rec->GetInputID(), nullptr) : nullptr;
+    if (enc)
+        host = enc->IsLocal() ? gCoreContext->GetHostName() : enc->GetHostName();
+
+    QString dir = rec->GetPathname();
+    if (!dir.isEmpty())
+    {
+        for (const auto &fs : fsInfos)
+        {
+            if ((fs.getHostname() == host) &&
+                ((dir == fs.getPath()) || dir.startsWith(fs.getPath() + "/")))
+                return fs.getFSysID();
+        }
+    }
+
+    QString key = rec->GetStorageGroup() + ":" + host;
+    auto git = m_groupDirs.find(key);
+    if (git == m_groupDirs.end())
+    {
+        StorageGroup sgroup(rec->GetStorageGroup(), host);
+        git = m_groupDirs.insert(key, sgroup.GetDirList());
+    }
+
+    int fsID = -1;
+    int64_t fsFree = 0;
+    for (const auto &fs : fsInfos)
+    {
+        if ((fs.getHostname() != host) || !git->contains(fs.getPath()))
+            continue;
+
+        auto fit = m_fileSystems.constFind(fs.getFSysID());
+        if (fit == m_fileSystems.constEnd())
+            continue;
+
+        int64_t projected = fit->m_freeKB - fit->m_neededKB;
+        if ((fsID < 0) || (projected > fsFree))
+        {
+            fsID   = fs.getFSysID();
+            fsFree = projected;
+        }
+    }
+
+    return fsID;
+}
+
+/// Finds when each file system will fall below the free space wanted.
+void ExpireForecast::FindFullTimes(void)
+{
+    for (auto &fc : m_fileSystems)
+    {
+        if (fc.m_freeKB < fc.m_desiredKB)
+        {
+            fc.m_fullTime = m_startTime;
+            continue;
+        }
+
+        if (fc.m_freeKB - fc.m_neededKB >= fc.m_desiredKB)
+            continue;
+
+        QDateTime t = m_startTime;
+        while (t < m_endTime)
+        {
+            t = std::min(t.addSecs(kStep), m_endTime);
+
+            int64_t written = 0;
+            for (const auto &w : qAsConst(m_writes))
+            {
+                if ((w.m_fsID == fc.m_fsID) && (w.m_start < t))
+                    written += w.m_kbPerSec * w.m_start.secsTo(std::min(t, w.m_end));
+            }
+
+            if (fc.m_freeKB - written < fc.m_desiredKB)
+            {
+                fc.m_fullTime = t;
+                break;
+            }
+        }
+    }
+}
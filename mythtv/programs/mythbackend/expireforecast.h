@@ -0,0 +1,93 @@
+#ifndef EXPIREFORECAST_H_
+#define EXPIREFORECAST_H_
+
+#include <cstdint>
+
+#include <QStringList>
+#include <QDateTime>
+#include <QString>
+#include <QList>
+#include <QMap>
+
+#include "mythscheduler.h" // for RecList
+
+class EncoderLink;
+class FileSystemInfo;
+
+/** \class FileSystemForecast
+ *  \brief Projected use of one recording file system.
+ *
+ *  All sizes are in KB, like FileSystemInfo.
+ */
+class FileSystemForecast
+{
+  public:
+    int         m_fsID       {-1};
+    QStringList m_dirs;            ///< host:path of the storage directories
+    int64_t     m_totalKB    {0};
+    int64_t     m_freeKB     {0};  ///< free space now
+    int64_t     m_desiredKB  {0};  ///< free space AutoExpire keeps now
+    int64_t     m_neededKB   {0};  ///< written by recordings until the end
+    uint        m_recordings {0};  ///< recordings writing to it until the end
+    QDateTime   m_fullTime;        ///< when free space falls below desired
+};
+
+/** \class ExpireForecast
+ *  \brief Projects the free space of every recording file system over
+ *         the next hours from the scheduler's upcoming recordings.
+ *
+ *   Each recording is assumed to write at the average rate of the earlier
+ *   recordings of its channel, or the maximum bitrate of its input when
+ *   there are none. A recording whose directory has not been chosen yet
+ *   is placed on the file system of its storage group with the most
+ *   projected free space, as the BalancedFreeSpace storage scheduler
+ *   would do. Expiring is not simulated, so the projection shows what
+ *   AutoExpire will have to free.
+ */
+class ExpireForecast
+{
+  public:
+    ExpireForecast(QMap<int, EncoderLink *> *tvList, uint hours);
+
+    void Calculate(const QList<FileSystemInfo> &fsInfos,
+                   const RecList &pending,
+                   const QMap<int, int64_t> &desiredSpace);
+
+    uint      GetHours(void)     const { return m_hours; }
+    QDateTime GetStartTime(void) const { return m_startTime; }
+    QDateTime GetEndTime(void)   const { return m_endTime; }
+    const QMap<int, FileSystemForecast> &GetFileSystems(void) const
+        { return m_fileSystems; }
+
+  private:
+    class Write
+    {
+      public:
+        int       m_fsID;
+        QDateTime m_start;
+        QDateTime m_end;
+        int64_t   m_kbPerSec;
+    };
+
+    void LoadChannelRates(void);
+    int64_t GetRate(const RecordingInfo *rec);
+    int FindFileSystem(const QList<FileSystemInfo> &fsInfos,
+                       const RecordingInfo *rec);
+    void FindFullTimes(void);
+
+    QMap<int, EncoderLink *> *m_tvList;
+    uint                      m_hours;
+    QDateTime                 m_startTime;
+    QDateTime                 m_endTime;
+
+    QMap<int, FileSystemForecast> m_fileSystems;
+    QList<Write>                  m_writes;
+    QMap<uint, int64_t>           m_channelRates;  ///< bytes per second
+    QMap<uint, int64_t>           m_inputRates;    ///< bytes per second
+    QMap<QString, QStringList>    m_groupDirs;
+
+    /// Resolution of the projected free space, in seconds
+    static const int kStep {5 * 60};
+};
+
+#endif // EXPIREFORECAST_H_
@@ -15,10 +15,12 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
 
 // Qt headers
 #include <QTextStream>
 #include <QRegExp>
+#include <QFileInfo>
 
 // MythTV headers
 #include "httpstatus.h"
@@ -40,6 +42,7 @@
 #include "upnp.h"
 #include "mythdate.h"
 #include "tv_rec.h"
+#include "tuningtimeline.h"
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -312,6 +315,65 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         }
     }
 
+    // Files being streamed over HTTP
+
+    QDomElement streams = pDoc->createElement("Streams");
+    root.appendChild(streams);
+
+    QList<HttpTransferInfo> transfers = HTTPRequest::GetActiveTransfers();
+    streams.setAttribute("count", transfers.size());
+    foreach (const auto & transfer, transfers)
+    {
+        qint64 secs = std::max(transfer.m_started.secsTo(MythDate::current()),
+                               static_cast<qint64>(1));
+
+        QDomElement stream = pDoc->createElement("Stream");
+        streams.appendChild(stream);
+        stream.setAttribute("peer",     transfer.m_peer);
+        stream.setAttribute("file",     QFileInfo(transfer.m_file).fileName());
+        stream.setAttribute("sent",     transfer.m_sent);
+        stream.setAttribute("size",     transfer.m_size);
+        stream.setAttribute("rate",     transfer.m_sent / secs); // Bytes/sec
+        stream.setAttribute("zerocopy", transfer.m_zeroCopy ? 1 : 0);
+    }
+
+    // Recent tuning timelines, summarised per input
+
+    QDomElement tuning = pDoc->createElement("Tuning");
+    root.appendChild(tuning);
+
+    static const TuningTimeline::Event kTuningEvents[] =
+    {
+        TuningTimeline::kSignalLock,    TuningTimeline::kFirstPMT,
+        TuningTimeline::kFirstKeyframe, TuningTimeline::kFirstWrite,
+    };
+
+    QMap<uint, QList<TuningTimelineData> > timelines;
+    foreach (const auto & data, TuningTimeline::GetHistory())
+        timelines[data.m_inputId].push_back(data);
+
+    tuning.setAttribute("count", timelines.size());
+    for (auto it = timelines.cbegin(); it != timelines.cend(); ++it)
+    {
+        QDomElement input = pDoc->createElement("Input");
+        tuning.appendChild(input);
+        input.setAttribute("id",    it.key());
+        input.setAttribute("count", it.value().size());
+
+        for (auto event : kTuningEvents)
+        {
+            QDomElement phase = pDoc->createElement("Event");
+            input.appendChild(phase);
+            phase.setAttribute("name", TuningTimeline::EventName(event));
+            phase.setAttribute("p50",
+                TuningTimeline::Percentile(it.value(), event, 50));
+            phase.setAttribute("p90",
+                TuningTimeline::Percentile(it.value(), event, 90));
+            phase.setAttribute("p99",
+                TuningTimeline::Percentile(it.value(), event, 99));
+        }
+    }
+
     // Other backends
 
     QDomElement backends = pDoc->createElement("Backends");
@@ -666,6 +728,20 @@ void HttpStatus::PrintStatus( QTextStream &os, QDomDocument *pDoc )
     if (!node.isNull())
         PrintFrontends (os, node.toElement());
 
+    // HTTP streams
+
+    node = docElem.namedItem( "Streams" );
+
+    if (!node.isNull())
+        PrintStreams (os, node.toElement());
+
+    // Tuning timelines
+
+    node = docElem.namedItem( "Tuning" );
+
+    if (!node.isNull())
+        PrintTuning (os, node.toElement());
+
     // Backends
 
     node = docElem.namedItem( "Backends" );
@@ -1017,6 +1093,110 @@ int HttpStatus::PrintFrontends( QTextStream &os, const QDomElement& frontends )
 //
 /////////////////////////////////////////////////////////////////////////////
 
+int HttpStatus::PrintStreams( QTextStream &os, const QDomElement& streams )
+{
+    if (streams.isNull())
+        return( 0 );
+
+    int nNumStreams = streams.attribute( "count", "0" ).toInt();
+
+    if (nNumStreams < 1)
+        return( 0 );
+
+    os << "  <div class=\"content\">\r\n"
+       << "    <h2 class=\"status\">HTTP Streams</h2>\r\n";
+
+    QDomNode node = streams.firstChild();
+    while (!node.isNull())
+    {
+        QDomElement e = node.toElement();
+
+        if (!e.isNull())
+        {
+            qint64 sent = e.attribute( "sent", "0" ).toLongLong();
+            qint64 size = e.attribute( "size", "0" ).toLongLong();
+            qint64 rate = e.attribute( "rate", "0" ).toLongLong();
+
+            os << e.attribute( "peer", "" ) << " - "
+               << e.attribute( "file", "" ) << ": "
+               << QString("%1 of %2 MB at %3 KB/s")
+                      .arg(sent / (1024 * 1024)).arg(size / (1024 * 1024))
+                      .arg(rate / 1024);
+
+            if (e.attribute( "zerocopy", "0" ).toInt())
+                os << " (sendfile)";
+
+            os << "<br />\r\n";
+        }
+
+        node = node.nextSibling();
+    }
+
+    os << "  </div>\r\n\r\n";
+
+    return nNumStreams;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+int HttpStatus::PrintTuning( QTextStream &os, const QDomElement& tuning )
+{
+    if (tuning.isNull())
+        return( 0 );
+
+    int nNumInputs = tuning.attribute( "count", "0" ).toInt();
+
+    if (nNumInputs < 1)
+        return( 0 );
+
+    os << "  <div class=\"content\">\r\n"
+       << "    <h2 class=\"status\">Tuning Times</h2>\r\n"
+       << "    Milliseconds from the tuning request, as p50 / p90 / p99 "
+       << "of recent tunes.<br />\r\n";
+
+    QDomNode node = tuning.firstChild();
+    while (!node.isNull())
+    {
+        QDomElement e = node.toElement();
+
+        if (!e.isNull())
+        {
+            os << "    Input " << e.attribute( "id", "" ) << " ("
+               << e.attribute( "count", "0" ) << " tunes)";
+
+            QDomNode eventNode = e.firstChild();
+            while (!eventNode.isNull())
+            {
+                QDomElement event = eventNode.toElement();
+
+                if (!event.isNull() && event.attribute( "p50", "-1" ).toInt() >= 0)
+                {
+                    os << ", " << event.attribute( "name", "" ) << " "
+                       << event.attribute( "p50", "" ) << " / "
+                       << event.attribute( "p90", "" ) << " / "
+                       << event.attribute( "p99", "" );
+                }
+
+                eventNode = eventNode.nextSibling();
+            }
+
+            os << "<br />\r\n";
+        }
+
+        node = node.nextSibling();
+    }
+
+    os << "  </div>\r\n\r\n";
+
+    return nNumInputs;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 int HttpStatus::PrintBackends( QTextStream &os, const QDomElement& backends )
 {
     if (backends.isNull())
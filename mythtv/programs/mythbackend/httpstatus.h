@@ -64,6 +64,8 @@ class HttpStatus : public HttpServerExtension
         static int     PrintEncoderStatus( QTextStream &os, const QDomElement& encoders );
         static int     PrintScheduled    ( QTextStream &os, const QDomElement& scheduled );
         static int     PrintFrontends    ( QTextStream &os, const QDomElement& frontends );
+        static int     PrintStreams      ( QTextStream &os, const QDomElement& streams );
+        static int     PrintTuning       ( QTextStream &os, const QDomElement& tuning );
         static int     PrintBackends     ( QTextStream &os, const QDomElement& backends );
         static int     PrintJobQueue     ( QTextStream &os, const QDomElement& jobs );
         static int     PrintMachineInfo  ( QTextStream &os, const QDomElement& info );
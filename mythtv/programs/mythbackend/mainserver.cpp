@@ -53,6 +53,7 @@ using namespace std;
 #include "server.h"
 #include "mthread.h"
 #include "scheduler.h"
+#include "deletescheduler.h"
 #include "requesthandler/fileserverutil.h"
 #include "programinfo.h"
 #include "mythtimezone.h"
@@ -134,7 +135,6 @@ bool delete_file_immediately(const QString &filename,
 
 };
 
-QMutex MainServer::s_truncate_and_close_lock;
 const uint MainServer::kMasterServerReconnectTimeout = 1000; //ms
 
 class ProcessRequestRunnable : public QRunnable
@@ -249,6 +249,8 @@ MainServer::MainServer(bool master, int port,
 
     m_threadPool.setMaxThreadCount(PRT_STARTUP_THREAD_COUNT);
 
+    m_deleteScheduler = new DeleteScheduler(m_encoderList);
+
     m_masterBackendOverride =
         gCoreContext->GetBoolSetting("MasterBackendOverride", false);
 
@@ -354,6 +356,8 @@ MainServer::~MainServer()
 {
     if (!m_stopped)
         Stop();
+
+    delete m_deleteScheduler;
 }
 
 void MainServer::Stop()
@@ -395,6 +399,9 @@ void MainServer::Stop()
     if (m_expirer)
         m_expirer->SetMainServer(nullptr);
 
+    if (m_deleteScheduler)
+        m_deleteScheduler->Stop();
+
     {
         QMutexLocker locker(&m_masterFreeSpaceListLock);
         while (m_masterFreeSpaceListUpdater)
@@ -2484,7 +2491,7 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     m_deletelock.unlock();
 
     if (slowDeletes && fd >= 0)
-        TruncateAndClose(&pginfo, fd, ds->m_filename, size);
+        m_deleteScheduler->Enqueue(fd, ds->m_filename, size, &pginfo);
 }
 
 void MainServer::DeleteRecordedFiles(DeleteStruct *ds)
@@ -2615,14 +2622,38 @@ void MainServer::DoDeleteInDB(DeleteStruct *ds)
             QString("Error deleting recordedseek for %1.")
                 .arg(logInfo));
     }
+
+    query.prepare("DELETE FROM recordedtuning "
+                  "WHERE recordedid = :RECORDEDID;");
+    query.bindValue(":RECORDEDID", ds->m_recordedid);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("Recorded program delete recordedtuning", query);
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Error deleting recordedtuning for %1.")
+                .arg(logInfo));
+    }
+
+    query.prepare("DELETE FROM recordedcaption "
+                  "WHERE recordedid = :RECORDEDID;");
+    query.bindValue(":RECORDEDID", ds->m_recordedid);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("Recorded program delete recordedcaption", query);
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Error deleting recordedcaption for %1.")
+                .arg(logInfo));
+    }
 }
 
 /**
  *  \brief Deletes links and unlinks the main file and returns the descriptor.
  *
- *  This is meant to be used with TruncateAndClose() to slowly shrink a
- *  large file and then eventually delete the file by closing the file
- *  descriptor.
+ *  This is meant to be used with DeleteScheduler::Enqueue() to slowly
+ *  shrink a large file and then eventually delete the file by closing the
+ *  file descriptor.
  *
  *  \return fd for success, -1 for error, -2 for only a symlink deleted.
  */
@@ -2705,87 +2736,6 @@ int MainServer::OpenAndUnlink(const QString &filename)
     return fd;
 }
 
-/**
- *  \brief Repeatedly truncate an open file in small increments.
- *
- *   When the file is small enough this closes the file and returns.
- *
- *   NOTE: This acquires a lock so that only one instance of TruncateAndClose()
- *         is running at a time.
- */
-bool MainServer::TruncateAndClose(ProgramInfo *pginfo, int fd,
-                                  const QString &filename, off_t fsize)
-{
-    QMutexLocker locker(&s_truncate_and_close_lock);
-
-    if (pginfo)
-    {
-        pginfo->SetPathname(filename);
-        pginfo->MarkAsInUse(true, kTruncatingDeleteInUseID);
-    }
-
-    int cards = 5;
-    {
-        MSqlQuery query(MSqlQuery::InitCon());
-        query.prepare("SELECT COUNT(cardid) FROM capturecard;");
-        if (query.exec() && query.next())
-            cards = query.value(0).toInt();
-    }
-
-    // Time between truncation steps in milliseconds
-    const size_t sleep_time = 500;
-    const size_t min_tps    = 8 * 1024 * 1024;
-    const auto calc_tps     = (size_t) (cards * 1.2 * (22200000LL / 8.0));
-    const size_t tps = max(min_tps, calc_tps);
-    const auto increment    = (size_t) (tps * (sleep_time * 0.001F));
-
-    LOG(VB_FILE, LOG_INFO, LOC +
-        QString("Truncating '%1' by %2 MB every %3 milliseconds")
-            .arg(filename)
-            .arg(increment / (1024.0 * 1024.0), 0, 'f', 2)
-            .arg(sleep_time));
-
-    GetMythDB()->GetDBManager()->PurgeIdleConnections(false);
-
-    int count = 0;
-    while (fsize > 0)
-    {
-#if 0
-        LOG(VB_FILE, LOG_DEBUG, LOC + QString("Truncating '%1' to %2 MB")
-                .arg(filename).arg(fsize / (1024.0 * 1024.0), 0, 'f', 2));
-#endif
-
-        int err = ftruncate(fd, fsize);
-        if (err)
-        {
-            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error truncating '%1'")
-                    .arg(filename) + ENO);
-            if (pginfo)
-                pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
-            return 0 == close(fd);
-        }
-
-        fsize -= increment;
-
-        if (pginfo && ((count % 100) == 0))
-            pginfo->UpdateInUseMark(true);
-
-        count++;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
-    }
-
-    bool ok = (0 == close(fd));
-
-    if (pginfo)
-        pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
-
-    LOG(VB_FILE, LOG_INFO, LOC +
-        QString("Finished truncating '%1'").arg(filename));
-
-    return ok;
-}
-
 void MainServer::HandleCheckRecordingActive(QStringList &slist,
                                             PlaybackSock *pbs)
 {
@@ -5503,7 +5453,7 @@ void MainServer::DoTruncateThread(DeleteStruct *ds)
 {
     if (gCoreContext->GetBoolSetting("TruncateDeletesSlowly", false))
     {
-        TruncateAndClose(nullptr, ds->m_fd, ds->m_filename, ds->m_size);
+        m_deleteScheduler->Enqueue(ds->m_fd, ds->m_filename, ds->m_size);
     }
     else
     {
@@ -38,6 +38,7 @@ class QTimer;
 class FileSystemInfo;
 class MetadataFactory;
 class FreeSpaceUpdater;
+class DeleteScheduler;
 
 class DeleteStruct 
 {
@@ -305,9 +306,6 @@ class MainServer : public QObject, public MythSocketCBs
     static int  DeleteFile(const QString &filename, bool followLinks,
                            bool deleteBrokenSymlinks = false);
     static int  OpenAndUnlink(const QString &filename);
-    static bool TruncateAndClose(ProgramInfo *pginfo,
-                                 int fd, const QString &filename,
-                                 off_t fsize);
 
     vector<LiveTVChain*> m_liveTVChains;
     QMutex               m_liveTVChainsLock;
@@ -335,6 +333,7 @@ class MainServer : public QObject, public MythSocketCBs
 
     QMutex m_deletelock;
     MThreadPool m_threadPool;
+    DeleteScheduler *m_deleteScheduler       {nullptr};
 
     bool m_masterBackendOverride             {false};
 
@@ -353,7 +352,6 @@ class MainServer : public QObject, public MythSocketCBs
     MythDeque<DeferredDeleteStruct> m_deferredDeleteList;
 
     QTimer *m_autoexpireUpdateTimer          {nullptr}; // audited ref #5318
-    static QMutex s_truncate_and_close_lock;
 
     QMap<QString, int>    m_fsIDcache;
     QMutex                m_fsIDcacheLock;
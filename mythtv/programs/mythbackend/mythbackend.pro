@@ -29,7 +29,8 @@ HEADERS += autoexpire.h encoderlink.h filetransfer.h httpstatus.h mainserver.h
 HEADERS += playbacksock.h scheduler.h server.h backendhousekeeper.h
 HEADERS += upnpcdstv.h upnpcdsmusic.h upnpcdsvideo.h mediaserver.h
 HEADERS += internetContent.h main_helpers.h backendcontext.h
-HEADERS += httpconfig.h mythsettings.h commandlineparser.h
+HEADERS += httpconfig.h mythsettings.h commandlineparser.h deletescheduler.h
+HEADERS += expireforecast.h
 
 HEADERS += serviceHosts/mythServiceHost.h    serviceHosts/guideServiceHost.h
 HEADERS += serviceHosts/contentServiceHost.h serviceHosts/dvrServiceHost.h
@@ -40,6 +41,7 @@ HEADERS += serviceHosts/musicServiceHost.h
 HEADERS += services/myth.h services/guide.h services/content.h services/dvr.h
 HEADERS += services/serviceUtil.h services/channel.h services/video.h
 HEADERS += services/capture.h services/image.h services/music.h
+HEADERS += services/guideCache.h
 
 
 SOURCES += autoexpire.cpp encoderlink.cpp filetransfer.cpp httpstatus.cpp
@@ -48,11 +50,13 @@ SOURCES += backendhousekeeper.cpp
 SOURCES += upnpcdstv.cpp upnpcdsmusic.cpp upnpcdsvideo.cpp mediaserver.cpp
 SOURCES += internetContent.cpp main_helpers.cpp backendcontext.cpp
 SOURCES += httpconfig.cpp mythsettings.cpp commandlineparser.cpp
+SOURCES += deletescheduler.cpp expireforecast.cpp
 
 SOURCES += services/myth.cpp services/guide.cpp services/content.cpp 
 SOURCES += services/dvr.cpp services/channel.cpp services/video.cpp
 SOURCES += services/serviceUtil.cpp services/capture.cpp
 SOURCES += services/image.cpp services/music.cpp
+SOURCES += services/guideCache.cpp
 
 using_oss:DEFINES += USING_OSS
 
@@ -30,6 +30,7 @@
 
 #include "servicehost.h"
 #include "services/guide.h"
+#include "services/guideCache.h"
 
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
@@ -49,9 +50,32 @@ class GuideServiceHost : public ServiceHost
                                "/Guide",
                                sSharePath )
         {
+            // Create the cache on this (the main) thread so it receives events
+            GuideCache::Instance();
         }
 
         ~GuideServiceHost() override = default;
+
+        bool ProcessRequest( HTTPRequest *pRequest ) override // ServiceHost
+        {
+            if (!pRequest || pRequest->m_sBaseUrl != m_sBaseUrl ||
+                !GuideCache::IsCacheable( pRequest ))
+                return ServiceHost::ProcessRequest( pRequest );
+
+            GuideCache *pCache      = GuideCache::Instance();
+            QString     sKey        = GuideCache::GetKey( pRequest );
+            uint        nGeneration = pCache->Generation();
+
+            if (pCache->Lookup( sKey, pRequest ))
+                return true;
+
+            bool bHandled = ServiceHost::ProcessRequest( pRequest );
+
+            if (bHandled)
+                pCache->Insert( sKey, pRequest, nGeneration );
+
+            return bHandled;
+        }
 };
 
 #endif
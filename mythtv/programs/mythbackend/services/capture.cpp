@@ -355,3 +355,29 @@ bool Capture::UpdateCardInput    ( int              nCardInputId,
 
     return set_on_input(sSetting, nCardInputId, sValue);
 }
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+DTC::TuningTimelineList* Capture::GetTuningTimelineList ( int nCardId,
+                                                          int nCount )
+{
+    QList<TuningTimelineData> history =
+        TuningTimeline::GetHistory(nCardId > 0 ? nCardId : 0);
+
+    // Newest first, limited to the requested count
+    int nStart = 0;
+    if (nCount > 0 && nCount < history.size())
+        nStart = history.size() - nCount;
+
+    auto *pList = new DTC::TuningTimelineList();
+
+    for (int n = history.size() - 1; n >= nStart; --n)
+    {
+        DTC::TuningTimeline *pTimeline = pList->AddNewTuningTimeline();
+        FillTuningTimeline(pTimeline, history[n]);
+    }
+
+    return pList;
+}
@@ -100,6 +100,9 @@ class Capture : public CaptureServices
                                                          const QString    &Setting,
                                                          const QString    &Value ) override; // CaptureServices
 
+        DTC::TuningTimelineList*    GetTuningTimelineList ( int           CardId,
+                                                            int           Count      ) override; // CaptureServices
+
 };
 
 // --------------------------------------------------------------------------
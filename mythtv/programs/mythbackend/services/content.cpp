@@ -28,6 +28,7 @@
 #include <QDir>
 #include <QImage>
 #include <QImageWriter>
+#include <QSaveFile>
 
 #include <cmath>
 #include "compat.h"
@@ -35,6 +36,7 @@
 #include "mythcorecontext.h"
 #include "storagegroup.h"
 #include "programinfo.h"
+#include "recordinginfo.h"
 #include "previewgenerator.h"
 #include "requesthandler/fileserverutil.h"
 #include "httprequest.h"
@@ -708,6 +710,106 @@ QFileInfo Content::GetRecording( int              nRecordedId,
     return QFileInfo();
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// HLS playlist which serves the recording file as is, using byte ranges
+// (see HTTPLiveStream::GetPassthroughPlaylist). No transcoding is needed,
+// so playback can start immediately.
+/////////////////////////////////////////////////////////////////////////////
+
+QFileInfo Content::GetRecordingPlaylist( int              nRecordedId,
+                                         int              nChanId,
+                                         const QDateTime &recstarttsRaw,
+                                         int              nSegmentSize )
+{
+    if ((nRecordedId <= 0) &&
+        (nChanId <= 0 || !recstarttsRaw.isValid()))
+        throw QString("Recorded ID or Channel ID and StartTime appears invalid.");
+
+    RecordingInfo pginfo = (nRecordedId > 0) ?
+        RecordingInfo(nRecordedId) :
+        RecordingInfo(nChanId, recstarttsRaw.toUTC());
+
+    if (!pginfo.GetChanID())
+    {
+        LOG(VB_UPNP, LOG_ERR, QString("GetRecordingPlaylist - for '%1' failed")
+            .arg(nRecordedId));
+
+        return QFileInfo();
+    }
+
+    if (pginfo.GetHostname().toLower() != gCoreContext->GetHostName().toLower())
+    {
+        // We only handle requests for local resources
+
+        QString sMsg =
+            QString("GetRecordingPlaylist: Wrong Host '%1' request from '%2'.")
+                          .arg( gCoreContext->GetHostName())
+                          .arg( pginfo.GetHostname() );
+
+        LOG(VB_UPNP, LOG_ERR, sMsg);
+
+        throw HttpRedirectException( pginfo.GetHostname() );
+    }
+
+    QString sFileName( GetPlaybackURL(&pginfo) );
+
+    if (!QFile::exists( sFileName ))
+        return QFileInfo();
+
+    if (nSegmentSize <= 0 || nSegmentSize > 60)
+        nSegmentSize = 6;
+
+    // Segment URLs are relative to this playlist, i.e. /Content/
+    QString sMediaURL = QString("GetRecording?RecordedId=%1")
+                            .arg(pginfo.GetRecordingID());
+
+    QString sPlaylist = HTTPLiveStream::GetPassthroughPlaylist(
+        pginfo, sFileName, sMediaURL, nSegmentSize);
+
+    if (sPlaylist.isEmpty())
+        throw QString("Recording can not be streamed without transcoding, "
+                      "use AddRecordingLiveStream");
+
+    // ----------------------------------------------------------------------
+    // Write to the Streaming storage group, so it's served like any other
+    // HLS playlist. The file is only needed while it is being sent, so the
+    // ones left by earlier requests are removed once they are an hour old.
+    // ----------------------------------------------------------------------
+
+    StorageGroup sgroup("Streaming", gCoreContext->GetHostName());
+    QString sOutDir = sgroup.GetFirstDir();
+    QDir outDir(sOutDir);
+
+    if (!outDir.exists() && !outDir.mkpath(sOutDir))
+        throw QString("Unable to create Streaming directory");
+
+    QString sOutFile = QString("%1/%2.%3s.passthrough.m3u8")
+                           .arg(sOutDir)
+                           .arg(QFileInfo(sFileName).fileName())
+                           .arg(nSegmentSize);
+
+    QDateTime expired = MythDate::current().addSecs(-60 * 60);
+    QFileInfoList playlists = outDir.entryInfoList(
+        QStringList("*.passthrough.m3u8"), QDir::Files);
+    for (const auto &playlist : playlists)
+    {
+        if (playlist.lastModified() < expired)
+            QFile::remove(playlist.absoluteFilePath());
+    }
+
+    // Written to a unique temporary file and renamed, so that concurrent
+    // requests never see each other's partial playlists
+    QSaveFile file(sOutFile);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(sPlaylist.toUtf8()) < 0 ||
+        !file.commit())
+    {
+        throw QString("Unable to write %1").arg(sOutFile);
+    }
+
+    return QFileInfo( sOutFile );
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -82,6 +82,11 @@ class Content : public ContentServices
                                                   int              ChanId,
                                                   const QDateTime &recstarttsRaw ) override; // ContentServices
 
+        QFileInfo           GetRecordingPlaylist( int              RecordedId,
+                                                  int              ChanId,
+                                                  const QDateTime &recstarttsRaw,
+                                                  int              SegmentSize ) override; // ContentServices
+
         QFileInfo           GetMusic            ( int Id ) override; // ContentServices
         QFileInfo           GetVideo            ( int Id ) override; // ContentServices
 
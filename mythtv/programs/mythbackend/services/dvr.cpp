@@ -24,7 +24,6 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <QMap>
-#include <QRegExp>
 
 #include "dvr.h"
 
@@ -34,6 +33,7 @@
 #include "mythevent.h"
 #include "scheduler.h"
 #include "autoexpire.h"
+#include "expireforecast.h"
 #include "jobqueue.h"
 #include "encoderlink.h"
 #include "remoteutil.h"
@@ -70,13 +70,40 @@ DTC::ProgramList* Dvr::GetRecordedList( bool           bDescending,
                                         const QString &sSort
                                       )
 {
-    QMap< QString, ProgramInfo* > recMap;
+    // ----------------------------------------------------------------------
+    // Push the filters down to the database so that only the requested
+    // page of recordings is loaded, along with just its in-use, job and
+    // recording state
+    // ----------------------------------------------------------------------
+
+    QStringList  clause;
+    MSqlBindings bindings;
+
+    clause << "r.deletepending = 0";
+
+    if (!sTitleRegEx.isEmpty())
+    {
+        clause << "r.title REGEXP :TITLEREGEX";
+        bindings[":TITLEREGEX"] = sTitleRegEx;
+    }
+
+    if (!sRecGroup.isEmpty())
+    {
+        clause << "r.recgroup = :RECGROUP";
+        bindings[":RECGROUP"] = sRecGroup;
+    }
 
-    if (gCoreContext->GetScheduler())
-        recMap = gCoreContext->GetScheduler()->GetRecording();
+    if (!sStorageGroup.isEmpty())
+    {
+        clause << "r.storagegroup = :STORAGEGROUP";
+        bindings[":STORAGEGROUP"] = sStorageGroup;
+    }
 
-    QMap< QString, uint32_t > inUseMap    = ProgramInfo::QueryInUseMap();
-    QMap< QString, bool >     isJobRunning= ProgramInfo::QueryJobsRunning(JOB_COMMFLAG);
+    if (!sCategory.isEmpty())
+    {
+        clause << "r.category = :CATEGORY";
+        bindings[":CATEGORY"] = sCategory;
+    }
 
     ProgramList progList;
 
@@ -84,51 +111,29 @@ DTC::ProgramList* Dvr::GetRecordedList( bool           bDescending,
     if (bDescending)
         desc = -1;
 
-    LoadFromRecorded( progList, false, inUseMap, isJobRunning, recMap, desc, sSort );
-
-    QMap< QString, ProgramInfo* >::iterator mit = recMap.begin();
+    nStartIndex     = (nStartIndex > 0) ? nStartIndex : 0;
+    uint nLimit     = (nCount > 0) ? nCount : 0;
+    uint nAvailable = 0;
 
-    for (; mit != recMap.end(); mit = recMap.erase(mit))
-        delete *mit;
+    if (!LoadFromRecorded( progList, false, desc, sSort, clause.join(" AND "),
+                           bindings, nStartIndex, nLimit, nAvailable ))
+        throw QString("Unable to load the recorded programs");
 
     // ----------------------------------------------------------------------
     // Build Response
     // ----------------------------------------------------------------------
 
     auto *pPrograms = new DTC::ProgramList();
-    int nAvailable = 0;
-
-    int nMax      = (nCount > 0) ? nCount : progList.size();
-
-    nAvailable = 0;
-    nCount = 0;
-
-    QRegExp rTitleRegEx        = QRegExp(sTitleRegEx, Qt::CaseInsensitive);
 
     for (auto *pInfo : progList)
     {
-        if (pInfo->IsDeletePending() ||
-            (!sTitleRegEx.isEmpty() && !pInfo->GetTitle().contains(rTitleRegEx)) ||
-            (!sRecGroup.isEmpty() && sRecGroup != pInfo->GetRecordingGroup()) ||
-            (!sStorageGroup.isEmpty() && sStorageGroup != pInfo->GetStorageGroup()) ||
-            (!sCategory.isEmpty() && sCategory != pInfo->GetCategory()))
-            continue;
-
-        if ((nAvailable < nStartIndex) ||
-            (nCount >= nMax))
-        {
-            ++nAvailable;
-            continue;
-        }
-
-        ++nAvailable;
-        ++nCount;
-
         DTC::Program *pProgram = pPrograms->AddNewProgram();
 
         FillProgramInfo( pProgram, pInfo, true );
     }
 
+    nCount = progList.size();
+
     // ----------------------------------------------------------------------
 
     pPrograms->setStartIndex    ( nStartIndex     );
@@ -626,6 +631,88 @@ DTC::CutList* Dvr::GetRecordedSeek ( int RecordedId,
 //
 /////////////////////////////////////////////////////////////////////////////
 
+DTC::TuningTimeline* Dvr::GetRecordedTuningTimeline ( int RecordedId )
+{
+    if (RecordedId <= 0)
+        throw QString("Recorded ID appears invalid.");
+
+    TuningTimelineData data;
+    if (!TuningTimeline::LoadFromDB(RecordedId, data))
+        throw QString("No tuning timeline for this recording.");
+
+    auto *pTimeline = new DTC::TuningTimeline();
+    FillTuningTimeline(pTimeline, data);
+
+    return pTimeline;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Subtitles extracted while recording.  With Text, the captions matching it
+// are returned best match first, otherwise all captions in time order.
+/////////////////////////////////////////////////////////////////////////////
+
+DTC::RecordedCaptionList* Dvr::GetRecordedCaptionList ( int RecordedId,
+                                                        const QString &Text,
+                                                        int Count )
+{
+    if (RecordedId <= 0 && Text.trimmed().isEmpty())
+        throw QString("Recorded ID or Text is required.");
+
+    if (Count <= 0 || Count > 1000)
+        Count = 1000;
+
+    QString sql = "SELECT recordedid, page, language, starttime, duration, "
+                  "       caption "
+                  "FROM recordedcaption ";
+    QStringList where;
+    if (RecordedId > 0)
+        where << "recordedid = :RECORDEDID";
+    if (!Text.trimmed().isEmpty())
+        where << "MATCH (caption) AGAINST (:TEXT IN BOOLEAN MODE)";
+    sql += "WHERE " + where.join(" AND ") + " ";
+    if (!Text.trimmed().isEmpty())
+        sql += "ORDER BY MATCH (caption) AGAINST (:TEXT2) DESC, ";
+    else
+        sql += "ORDER BY ";
+    sql += "recordedid, starttime LIMIT :COUNT";
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(sql);
+    if (RecordedId > 0)
+        query.bindValue(":RECORDEDID", RecordedId);
+    if (!Text.trimmed().isEmpty())
+    {
+        query.bindValue(":TEXT",  Text.trimmed());
+        query.bindValue(":TEXT2", Text.trimmed());
+    }
+    query.bindValue(":COUNT", Count);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("Dvr::GetRecordedCaptionList", query);
+        throw QString("Database Error executing query.");
+    }
+
+    auto *pList = new DTC::RecordedCaptionList();
+
+    while (query.next())
+    {
+        DTC::RecordedCaption *pCaption = pList->AddNewCaption();
+        pCaption->setRecordedId( query.value(0).toInt()      );
+        pCaption->setPage      ( query.value(1).toInt()      );
+        pCaption->setLanguage  ( query.value(2).toString()   );
+        pCaption->setOffset    ( query.value(3).toLongLong() );
+        pCaption->setDuration  ( query.value(4).toInt()      );
+        pCaption->setText      ( query.value(5).toString()   );
+    }
+
+    return pList;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 DTC::ProgramList* Dvr::GetExpiringList( int nStartIndex,
                                         int nCount      )
 {
@@ -670,6 +757,45 @@ DTC::ProgramList* Dvr::GetExpiringList( int nStartIndex,
     return pPrograms;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Free space of each recording file system projected from the upcoming
+// recordings.  Without Hours, the AutoExpireForecastHours setting or a day.
+/////////////////////////////////////////////////////////////////////////////
+
+DTC::StorageForecastList* Dvr::GetExpireForecast( int Hours )
+{
+    if (!expirer)
+        throw QString("AutoExpire is not running on this backend.");
+
+    if (Hours <= 0)
+        Hours = gCoreContext->GetNumSetting("AutoExpireForecastHours", 0);
+    if (Hours <= 0)
+        Hours = 24;
+
+    ExpireForecast forecast(expirer->m_encoderList, Hours);
+    expirer->CalcForecast(forecast);
+
+    auto *pList = new DTC::StorageForecastList();
+    pList->setStartTime( forecast.GetStartTime() );
+    pList->setEndTime  ( forecast.GetEndTime()   );
+
+    for (const auto &fc : forecast.GetFileSystems())
+    {
+        DTC::StorageForecast *pFS = pList->AddNewFileSystem();
+        pFS->setId           ( fc.m_fsID                            );
+        pFS->setDirectories  ( fc.m_dirs.join(", ")                 );
+        pFS->setTotalSpace   ( fc.m_totalKB / 1024                  );
+        pFS->setFreeSpace    ( fc.m_freeKB / 1024                   );
+        pFS->setDesiredSpace ( fc.m_desiredKB / 1024                );
+        pFS->setNeededSpace  ( fc.m_neededKB / 1024                 );
+        pFS->setProjectedFree( (fc.m_freeKB - fc.m_neededKB) / 1024 );
+        pFS->setRecordings   ( fc.m_recordings                      );
+        pFS->setFullTime     ( fc.m_fullTime                        );
+    }
+
+    return pList;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -43,6 +43,8 @@ class Dvr : public DvrServices
         DTC::ProgramList* GetExpiringList     ( int              StartIndex,
                                                 int              Count      ) override; // DvrServices
 
+        DTC::StorageForecastList* GetExpireForecast ( int        Hours      ) override; // DvrServices
+
         DTC::ProgramList* GetRecordedList     ( bool             Descending,
                                                 int              StartIndex,
                                                 int              Count,
@@ -120,6 +122,12 @@ class Dvr : public DvrServices
         DTC::CutList*     GetRecordedSeek      ( int              RecordedId,
                                                  const QString   &OffsetType ) override; // DvrServices
 
+        DTC::TuningTimeline* GetRecordedTuningTimeline ( int      RecordedId ) override; // DvrServices
+
+        DTC::RecordedCaptionList* GetRecordedCaptionList ( int      RecordedId,
+                                                           const QString &Text,
+                                                           int      Count ) override; // DvrServices
+
         DTC::ProgramList* GetConflictList     ( int              StartIndex,
                                                 int              Count,
                                                 int              RecordId ) override; // DvrServices
@@ -334,6 +342,13 @@ class ScriptableDvr : public QObject
             )
         }
 
+        QObject* GetExpireForecast   ( int              Hours      )
+        {
+            SCRIPT_CATCH_EXCEPTION( nullptr,
+                return m_obj.GetExpireForecast( Hours );
+            )
+        }
+
         QObject* GetRecordedList     ( bool             Descending,
                                        int              StartIndex,
                                        int              Count,
@@ -35,6 +35,7 @@
 #include "channelutil.h"
 #include "channelgroup.h"
 #include "storagegroup.h"
+#include "programsearchindex.h"
 
 #include "mythlogging.h"
 
@@ -340,6 +341,127 @@ DTC::ProgramList* Guide::GetProgramList(int              nStartIndex,
     return pPrograms;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Each word of the query must match the beginning of a word in the title,
+// subtitle or description (see ProgramSearchIndex). Until the index has
+// been built the query is matched anywhere in those fields instead.
+/////////////////////////////////////////////////////////////////////////////
+
+DTC::ProgramList* Guide::SearchProgramList(int              nStartIndex,
+                                           int              nCount,
+                                           const QString   &sQuery,
+                                           const QDateTime &rawStartTime,
+                                           const QDateTime &rawEndTime,
+                                           int              nChanId,
+                                           bool             bDetails,
+                                           bool             bWithInvisible)
+{
+    if (sQuery.trimmed().isEmpty())
+        throw QString( "Query is required" );
+
+    if (!rawStartTime.isNull() && !rawStartTime.isValid())
+        throw QString( "StartTime is invalid" );
+
+    if (!rawEndTime.isNull() && !rawEndTime.isValid())
+        throw QString( "EndTime is invalid" );
+
+    QDateTime dtStartTime = rawStartTime;
+    if (dtStartTime.isNull())
+        dtStartTime = QDateTime::currentDateTimeUtc();
+
+    if (!rawEndTime.isNull() && rawEndTime < dtStartTime)
+        throw QString( "EndTime is before StartTime");
+
+    // ----------------------------------------------------------------------
+    // Build SQL statement, ranked by relevance when the search index
+    // is available and by start time otherwise
+    // ----------------------------------------------------------------------
+
+    ProgramList  progList;
+    ProgramList  schedList;
+    MSqlBindings bindings;
+
+    QString sSQL;
+    QString sRank;
+
+    bool bIndexed = ProgramSearchIndex::IsReady() &&
+        ProgramSearchIndex::BuildJoin(sQuery, ProgramSearchIndex::kAllFields,
+                                      "sq", sSQL, sRank, bindings);
+
+    sSQL += "WHERE deleted IS NULL AND ";
+
+    if (!bWithInvisible)
+        sSQL += "visible > 0 AND ";
+
+    sSQL += "program.manualid = 0 ";
+
+    if (nChanId > 0)
+    {
+        sSQL += "AND program.chanid = :ChanId ";
+        bindings[":ChanId"] = nChanId;
+    }
+
+    sSQL += "AND program.endtime >= :StartDate ";
+    bindings[":StartDate"] = dtStartTime;
+
+    if (!rawEndTime.isNull())
+    {
+        sSQL += "AND program.starttime <= :EndDate ";
+        bindings[":EndDate"] = rawEndTime;
+    }
+
+    if (bIndexed)
+    {
+        sSQL += QString("GROUP BY program.chanid, program.starttime "
+                        "ORDER BY %1 DESC, program.starttime ").arg(sRank);
+    }
+    else
+    {
+        sSQL += "AND (program.title LIKE :Keyword1 "
+                "OR   program.subtitle LIKE :Keyword2 "
+                "OR   program.description LIKE :Keyword3) "
+                "GROUP BY program.chanid, program.starttime "
+                "ORDER BY program.starttime ";
+
+        QString filter = QString("%%1%").arg(sQuery);
+        bindings[":Keyword1"] = filter;
+        bindings[":Keyword2"] = filter;
+        bindings[":Keyword3"] = filter;
+    }
+
+    auto *scheduler = dynamic_cast<Scheduler*>(gCoreContext->GetScheduler());
+    if (scheduler)
+        scheduler->GetAllPending(schedList);
+
+    uint nTotalAvailable = 0;
+    LoadFromProgram( progList, sSQL, bindings, schedList,
+                     (uint)nStartIndex, (uint)nCount, nTotalAvailable);
+
+    // ----------------------------------------------------------------------
+    // Build Response
+    // ----------------------------------------------------------------------
+
+    auto *pPrograms = new DTC::ProgramList();
+
+    nCount = (int)progList.size();
+
+    for (int n = 0; n < nCount; n++)
+    {
+        DTC::Program *pProgram = pPrograms->AddNewProgram();
+
+        FillProgramInfo( pProgram, progList[ n ], true, bDetails, false );
+    }
+
+    pPrograms->setStartIndex    ( nStartIndex     );
+    pPrograms->setCount         ( nCount          );
+    pPrograms->setTotalAvailable( nTotalAvailable );
+    pPrograms->setAsOf          ( MythDate::current() );
+    pPrograms->setVersion       ( MYTH_BINARY_VERSION );
+    pPrograms->setProtoVer      ( MYTH_PROTO_VERSION  );
+
+    return pPrograms;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
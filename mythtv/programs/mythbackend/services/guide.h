@@ -71,6 +71,15 @@ class Guide : public GuideServices
                                                   bool             Descending,
                                                   bool             WithInvisible) override; // GuideServices
 
+        DTC::ProgramList*   SearchProgramList   ( int              StartIndex,
+                                                  int              Count,
+                                                  const QString   &Query,
+                                                  const QDateTime &StartTime,
+                                                  const QDateTime &EndTime,
+                                                  int              ChanId,
+                                                  bool             Details,
+                                                  bool             WithInvisible) override; // GuideServices
+
         DTC::Program*       GetProgramDetails   ( int              ChanId,
                                                   const QDateTime &StartTime ) override; // GuideServices
 
@@ -164,6 +173,22 @@ class ScriptableGuide : public QObject
             )
         }
 
+        QObject* SearchProgramList(int              StartIndex,
+                                   int              Count,
+                                   const QString   &Query,
+                                   const QDateTime &StartTime,
+                                   const QDateTime &EndTime,
+                                   int              ChanId,
+                                   bool             Details,
+                                   bool             WithInvisible)
+        {
+            SCRIPT_CATCH_EXCEPTION( nullptr,
+                return m_obj.SearchProgramList( StartIndex, Count, Query,
+                                                StartTime, EndTime, ChanId,
+                                                Details, WithInvisible );
+            )
+        }
+
         QObject* GetProgramDetails( int ChanId, const QDateTime &StartTime )
         {
             SCRIPT_CATCH_EXCEPTION( nullptr,
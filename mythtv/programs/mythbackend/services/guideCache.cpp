@@ -0,0 +1,268 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: guideCache.cpp
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "guideCache.h"
+
+#include <QMutexLocker>
+
+#include "httprequest.h"
+#include "mythcorecontext.h"
+#include "mythevent.h"
+#include "mythlogging.h"
+#include "mythdate.h"
+
+#define LOC QString("GuideCache: ")
+
+// Limits - a full guide for a large lineup can run to several MB
+static const int    kMaxEntries = 64;
+static const qint64 kMaxSize    = 64LL * 1024 * 1024;
+
+// Changes that do not trigger a reschedule (e.g. channel edits) are
+// picked up when the entry expires
+static const int    kMaxAgeSecs = 15 * 60;
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+GuideCache *GuideCache::Instance( void )
+{
+    static QMutex      s_lock;
+    static GuideCache *s_instance = nullptr;
+
+    QMutexLocker locker( &s_lock );
+
+    if (s_instance == nullptr)
+        s_instance = new GuideCache();
+
+    return s_instance;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+GuideCache::GuideCache()
+{
+    gCoreContext->addListener( this );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+GuideCache::~GuideCache()
+{
+    gCoreContext->removeListener( this );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Only plain (non SOAP) GetProgramGuide requests are cached
+/////////////////////////////////////////////////////////////////////////////
+
+bool GuideCache::IsCacheable( const HTTPRequest *pRequest )
+{
+    if (!pRequest || pRequest->m_bSOAPRequest)
+        return false;
+
+    if (( pRequest->m_eType & (RequestTypeGet | RequestTypeHead | RequestTypePost)) == 0)
+        return false;
+
+    return (pRequest->m_sMethod == "GetProgramGuide" ||
+            pRequest->m_sMethod == "ProgramGuide");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// The key covers the parameters (source/channel group, time window, detail
+// level, paging) and the Accept header, which selects the serializer.
+/////////////////////////////////////////////////////////////////////////////
+
+QString GuideCache::GetKey( const HTTPRequest *pRequest )
+{
+    QString sKey = pRequest->m_mapHeaders.value( "accept", "*/*" );
+
+    // QStringMap is ordered, so the key does not depend on parameter order
+    QStringMap::const_iterator it;
+    for (it = pRequest->m_mapParams.constBegin();
+         it != pRequest->m_mapParams.constEnd(); ++it)
+    {
+        sKey += '&' + it.key().toLower() + '=' + it.value();
+    }
+
+    return sKey;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+uint GuideCache::Generation( void )
+{
+    QMutexLocker locker( &m_lock );
+    return m_generation;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Fill in the response from the cache. The If-None-Match check (and 304)
+// is then handled by HTTPRequest::SendResponse as for any other response.
+/////////////////////////////////////////////////////////////////////////////
+
+bool GuideCache::Lookup( const QString &sKey, HTTPRequest *pRequest )
+{
+    QMutexLocker locker( &m_lock );
+
+    auto it = m_entries.find( sKey );
+
+    if (it == m_entries.end())
+    {
+        m_misses++;
+        return false;
+    }
+
+    if (it->m_generation != m_generation ||
+        it->m_created.secsTo( MythDate::current() ) > kMaxAgeSecs)
+    {
+        m_size -= it->m_body.size();
+        m_entries.erase( it );
+        m_misses++;
+        return false;
+    }
+
+    m_hits++;
+
+    pRequest->m_eResponseType     = ResponseTypeOther;
+    pRequest->m_sResponseTypeText = it->m_contentType;
+    pRequest->m_nResponseStatus   = 200;
+
+    pRequest->m_mapRespHeaders[ "ETag"          ] = it->m_eTag;
+    pRequest->m_mapRespHeaders[ "Cache-Control" ] = it->m_cacheControl;
+
+    pRequest->m_response.buffer() = it->m_body;
+
+    LOG(VB_HTTP, LOG_DEBUG, LOC + QString("Hit (%1 hits, %2 misses)")
+                                  .arg(m_hits).arg(m_misses));
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Store a freshly serialized response. nGeneration must be read before the
+// response was built, so that one built from data invalidated part way
+// through is discarded rather than cached.
+/////////////////////////////////////////////////////////////////////////////
+
+void GuideCache::Insert( const QString &sKey, const HTTPRequest *pRequest,
+                         uint nGeneration )
+{
+    if (pRequest->m_nResponseStatus != 200 ||
+        pRequest->m_eResponseType   != ResponseTypeOther)
+        return;
+
+    const QByteArray &body = pRequest->m_response.buffer();
+
+    if (body.isEmpty() || body.size() > kMaxSize / 4)
+        return;
+
+    QMutexLocker locker( &m_lock );
+
+    if (nGeneration != m_generation)
+        return;
+
+    Entry entry;
+    entry.m_body         = body;
+    entry.m_contentType  = pRequest->m_sResponseTypeText;
+    entry.m_eTag         = pRequest->m_mapRespHeaders.value( "ETag" );
+    entry.m_cacheControl = pRequest->m_mapRespHeaders.value( "Cache-Control" );
+    entry.m_created      = MythDate::current();
+    entry.m_generation   = nGeneration;
+
+    auto it = m_entries.find( sKey );
+    if (it != m_entries.end())
+    {
+        m_size -= it->m_body.size();
+        m_entries.erase( it );
+    }
+
+    m_size += body.size();
+    m_entries.insert( sKey, entry );
+
+    Evict();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Drop the oldest entries until we are back under the limits.
+// Must be called with m_lock held.
+/////////////////////////////////////////////////////////////////////////////
+
+void GuideCache::Evict( void )
+{
+    while (!m_entries.isEmpty() &&
+           (m_entries.size() > kMaxEntries || m_size > kMaxSize))
+    {
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->m_created < oldest->m_created)
+                oldest = it;
+        }
+
+        m_size -= oldest->m_body.size();
+        m_entries.erase( oldest );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void GuideCache::Invalidate( const QString &sReason )
+{
+    QMutexLocker locker( &m_lock );
+
+    m_generation++;
+
+    if (m_entries.isEmpty())
+        return;
+
+    LOG(VB_HTTP, LOG_INFO, LOC + QString("Invalidating %1 entries (%2)")
+                                 .arg(m_entries.size()).arg(sReason));
+    m_entries.clear();
+    m_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// mythfilldatabase and EIT updates both finish with a reschedule, which
+// (like any other schedule change) is announced with SCHEDULE_CHANGE.
+/////////////////////////////////////////////////////////////////////////////
+
+void GuideCache::customEvent( QEvent *pEvent )
+{
+    if (pEvent->type() != MythEvent::MythEventMessage)
+        return;
+
+    auto *me = dynamic_cast<MythEvent *>(pEvent);
+    if (me == nullptr)
+        return;
+
+    QString sMessage = me->Message();
+
+    if (sMessage == "SCHEDULE_CHANGE" ||
+        sMessage.startsWith( "RESCHEDULE_RECORDINGS" ))
+    {
+        Invalidate( sMessage.section( ' ', 0, 0 ));
+    }
+}
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: guideCache.h
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GUIDECACHE_H
+#define GUIDECACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QMutex>
+#include <QHash>
+
+class HTTPRequest;
+
+/////////////////////////////////////////////////////////////////////////////
+// Cache of serialized Guide/GetProgramGuide responses.
+//
+// Guide clients tend to poll the same time windows over and over. The
+// serialized response (and its ETag) is kept until the guide data or the
+// schedule changes, so a repeated request costs a hash lookup and, when the
+// client sends If-None-Match, an empty 304 response.
+/////////////////////////////////////////////////////////////////////////////
+
+class GuideCache : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        static GuideCache *Instance( void );
+
+        static bool IsCacheable( const HTTPRequest *pRequest );
+        static QString GetKey  ( const HTTPRequest *pRequest );
+
+        bool   Lookup    ( const QString &sKey, HTTPRequest *pRequest );
+        void   Insert    ( const QString &sKey, const HTTPRequest *pRequest,
+                           uint nGeneration );
+        void   Invalidate( const QString &sReason );
+        uint   Generation( void );
+
+    protected:
+
+        void customEvent( QEvent *pEvent ) override; // QObject
+
+    private:
+
+        GuideCache();
+       ~GuideCache() override;
+
+        struct Entry
+        {
+            QByteArray m_body;
+            QString    m_contentType;
+            QString    m_eTag;
+            QString    m_cacheControl;
+            QDateTime  m_created;
+            uint       m_generation { 0 };
+        };
+
+        void Evict( void );
+
+        QMutex                 m_lock;
+        QHash<QString, Entry>  m_entries;
+        qint64                 m_size       { 0 };
+        uint                   m_generation { 0 };
+        uint                   m_hits       { 0 };
+        uint                   m_misses     { 0 };
+};
+
+#endif // GUIDECACHE_H
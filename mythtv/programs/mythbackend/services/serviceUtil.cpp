@@ -724,3 +724,27 @@ void FillSeek(DTC::CutList* pCutList, RecordingInfo* rInfo, MarkTypes marktype)
         }
     }
 }
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void FillTuningTimeline( DTC::TuningTimeline *pTimeline,
+                         const TuningTimelineData &data )
+{
+    pTimeline->setCardId           ( data.m_inputId           );
+    pTimeline->setRecordedId       ( data.m_recordedId        );
+    pTimeline->setChanId           ( data.m_chanId            );
+    pTimeline->setStartTime        ( data.m_startTime         );
+    pTimeline->setFastChannelChange( data.m_fastChannelChange );
+
+    for (int i = 0; i < data.m_offsets.size(); ++i)
+    {
+        if (data.m_offsets[i] < 0)
+            continue;
+
+        DTC::TuningEvent *pEvent = pTimeline->AddNewEvent();
+        pEvent->setName(TuningTimeline::EventName(TuningTimeline::Event(i)));
+        pEvent->setOffset(data.m_offsets[i]);
+    }
+}
@@ -36,6 +36,7 @@
 #include "datacontracts/castMemberList.h"
 #include "datacontracts/cutList.h"
 #include "datacontracts/genreList.h"
+#include "datacontracts/tuningTimeline.h"
 
 #include "programinfo.h"
 #include "recordingrule.h"
@@ -45,6 +46,7 @@
 #include "channelinfo.h"
 #include "recordinginfo.h"
 #include "musicmetadata.h"
+#include "tuningtimeline.h"
 
 #define ADD_SQL(settings_var, bindvar, col, api_param, val) { \
     (settings_var) += QString("%1=:%2, ").arg(col).arg(api_param); \
@@ -101,5 +103,8 @@ void FillCommBreak( DTC::CutList* pCutList, RecordingInfo* rInfo, int marktype);
 
 void FillSeek(DTC::CutList* pCutList, RecordingInfo* rInfo, MarkTypes marktype);
 
+void FillTuningTimeline( DTC::TuningTimeline *pTimeline,
+                         const TuningTimelineData &data );
+
 
 #endif
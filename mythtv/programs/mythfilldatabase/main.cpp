@@ -26,6 +26,7 @@ using namespace std;
 #include "remoteutil.h"
 #include "videosource.h" // for is_grabber..
 #include "dbcheck.h"
+#include "programsearchindex.h"
 #include "mythsystemevent.h"
 #include "loggingserver.h"
 #include "mythlogging.h"
@@ -657,6 +658,10 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    // New listings are indexed as they are inserted, but the ones from
+    // before the search index existed have to be indexed once
+    ProgramSearchIndex::BuildIfNeeded();
+
     LOG(VB_GENERAL, LOG_INFO, "\n"
             "===============================================================\n"
             "| Attempting to contact the master backend for rescheduling.  |\n"
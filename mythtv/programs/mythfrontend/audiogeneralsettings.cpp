@@ -161,6 +161,9 @@ AudioConfigSettings::AudioConfigSettings()
 
     advancedSettings->addChild(HBRPassthrough());
 
+    advancedSettings->addChild(AudioUpmixBlockSize());
+    advancedSettings->addChild(AudioUpmixThreaded());
+
     advancedSettings->addChild(m_mpcm = MPCM());
 
     addChild(m_audioTest = new AudioTest());
@@ -468,6 +471,40 @@ HostComboBoxSetting *AudioConfigSettings::AudioUpmixType()
     return gc;
 }
 
+HostComboBoxSetting *AudioConfigSettings::AudioUpmixBlockSize()
+{
+    auto *gc = new HostComboBoxSetting("AudioUpmixBlockSize", false);
+
+    gc->setLabel(tr("Upmix block size"));
+
+    gc->addSelection(tr("1024 samples"), "1024");
+    gc->addSelection(tr("2048 samples"), "2048");
+    gc->addSelection(tr("4096 samples"), "4096");
+    gc->addSelection(tr("8192 samples"), "8192", true);  // default
+
+    gc->setHelpText(tr("Size of the blocks the Good and Best upmixers work "
+                       "on. Smaller blocks reduce the audio latency and "
+                       "the work done at once, larger blocks give a "
+                       "better frequency resolution. (default is 8192)"));
+
+    return gc;
+}
+
+HostCheckBoxSetting *AudioConfigSettings::AudioUpmixThreaded()
+{
+    auto *gc = new HostCheckBoxSetting("AudioUpmixThreaded");
+
+    gc->setLabel(tr("Upmix on a separate thread"));
+
+    gc->setValue(false);
+
+    gc->setHelpText(tr("If enabled, the Good and Best upmixers run on their "
+                       "own thread so that the audio output thread never "
+                       "waits for them. This adds half a block of latency. "
+                       "(default is unchecked)"));
+    return gc;
+}
+
 HostCheckBoxSetting *AudioConfigSettings::AC3PassThrough()
 {
     auto *gc = new HostCheckBoxSetting("AC3PassThru");
@@ -63,6 +63,8 @@ class AudioConfigSettings : public GroupSetting
     static HostComboBoxSetting *MaxAudioChannels();
     static HostCheckBoxSetting *AudioUpmix();
     static HostComboBoxSetting *AudioUpmixType();
+    static HostComboBoxSetting *AudioUpmixBlockSize();
+    static HostCheckBoxSetting *AudioUpmixThreaded();
     static HostCheckBoxSetting *AC3PassThrough();
     static HostCheckBoxSetting *DTSPassThrough();
     static HostCheckBoxSetting *EAC3PassThrough();
@@ -447,6 +447,23 @@ static GlobalSpinBoxSetting *AutoExpireExtraSpace()
     return bs;
 };
 
+static GlobalSpinBoxSetting *AutoExpireForecastHours()
+{
+    auto *bs = new GlobalSpinBoxSetting("AutoExpireForecastHours", 0, 48, 1);
+
+    bs->setLabel(GeneralSettings::tr("Make room in advance (hours)"));
+
+    bs->setHelpText(GeneralSettings::tr("While nothing is recording, expire "
+                                        "what the recordings scheduled in "
+                                        "this many hours are expected to "
+                                        "need, instead of expiring while "
+                                        "they record. Set to 0 to disable."));
+
+    bs->setValue(0);
+
+    return bs;
+};
+
 #if 0
 static GlobalCheckBoxSetting *AutoExpireInsteadOfDelete()
 {
@@ -4422,6 +4439,7 @@ GeneralSettings::GeneralSettings()
     autoexp->addChild(AutoExpireLiveTVMaxAge());
     autoexp->addChild(AutoExpireDayPriority());
     autoexp->addChild(AutoExpireExtraSpace());
+    autoexp->addChild(AutoExpireForecastHours());
 
 //    autoexp->addChild(new DeletedExpireOptions());
     autoexp->addChild(DeletedMaxAge());
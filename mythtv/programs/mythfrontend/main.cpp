@@ -412,6 +412,16 @@ static void startSearchKeyword(void)
         delete pl;
 }
 
+static void startSearchWord(void)
+{
+    MythScreenStack *mainStack = GetMythMainWindow()->GetMainStack();
+    auto *pl = new ProgLister(mainStack, plWordSearch, "", "");
+    if (pl->Create())
+        mainStack->AddScreen(pl);
+    else
+        delete pl;
+}
+
 static void startSearchPeople(void)
 {
     MythScreenStack *mainStack = GetMythMainWindow()->GetMainStack();
@@ -917,6 +927,8 @@ static void TVMenuCallback(void *data, QString &selection)
         startSearchTitle();
     else if (sel == "tv_search_keyword")
         startSearchKeyword();
+    else if (sel == "tv_search_word")
+        startSearchWord();
     else if (sel == "tv_search_people")
         startSearchPeople();
     else if (sel == "tv_search_power")
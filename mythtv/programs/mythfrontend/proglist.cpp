@@ -29,6 +29,7 @@ using namespace std;
 #include "tv_actions.h"                 // for ACTION_CHANNELSEARCH
 #include "mythdb.h"
 #include "mythdate.h"
+#include "programsearchindex.h"
 
 #define LOC      QString("ProgLister: ")
 #define LOC_WARN QString("ProgLister, Warning: ")
@@ -64,7 +65,8 @@ ProgLister::ProgLister(MythScreenStack *parent, ProgListType pltype,
     switch (pltype)
     {
         case plTitleSearch:   m_searchType = kTitleSearch;   break;
-        case plKeywordSearch: m_searchType = kKeywordSearch; break;
+        case plKeywordSearch:
+        case plWordSearch:    m_searchType = kKeywordSearch; break;
         case plPeopleSearch:  m_searchType = kPeopleSearch;  break;
         case plPowerSearch:
         case plSQLSearch:
@@ -145,6 +147,7 @@ bool ProgLister::Create()
         case plNewListings:        value = tr("New Title Search"); break;
         case plTitleSearch:        value = tr("Title Search");     break;
         case plKeywordSearch:      value = tr("Keyword Search");   break;
+        case plWordSearch:         value = tr("Word Search");      break;
         case plPeopleSearch:       value = tr("People Search");    break;
         case plStoredSearch:       value = tr("Stored Search");    break;
         case plPowerSearch:
@@ -452,6 +455,7 @@ void ProgLister::ShowChooseViewMenu(void)
         }
         case plTitleSearch:
         case plKeywordSearch:
+        case plWordSearch:
         case plPeopleSearch:
             screen = new PhrasePopup(
                 popupStack, this, m_searchType, m_viewTextList,
@@ -817,7 +821,8 @@ void ProgLister::FillViewList(const QString &view)
             m_curView = m_viewList.indexOf(view);
     }
     else if (m_type == plTitleSearch || m_type == plKeywordSearch ||
-             m_type == plPeopleSearch || m_type == plPowerSearch)
+             m_type == plWordSearch || m_type == plPeopleSearch ||
+             m_type == plPowerSearch)
     {
         MSqlQuery query(MSqlQuery::InitCon());
         query.prepare("SELECT phrase FROM keyword "
@@ -1168,6 +1173,35 @@ void ProgLister::FillItemList(bool restorePosition, bool updateDisp)
         bindings[":PGILLIKEPHRASE2"] = QString("%") + qphrase + '%';
         bindings[":PGILLIKEPHRASE3"] = QString("%") + qphrase + '%';
     }
+    else if (m_type == plWordSearch) // word search
+    {
+        // Each word of the phrase must start a word of the title, subtitle
+        // or description. The search index finds those without scanning
+        // every program; until it has been built the whole phrase is
+        // matched anywhere, like the keyword search.
+        QString rank;
+        if (ProgramSearchIndex::IsReady() &&
+            ProgramSearchIndex::BuildJoin(qphrase,
+                                          ProgramSearchIndex::kAllFields,
+                                          "pw", where, rank, bindings))
+        {
+            where += "WHERE channel.deleted IS NULL "
+                "  AND channel.visible > 0 "
+                "  AND program.endtime > :PGILSTART ";
+        }
+        else
+        {
+            where = "WHERE channel.deleted IS NULL "
+                "  AND channel.visible > 0 "
+                "  AND program.endtime > :PGILSTART "
+                "  AND (program.title LIKE :PGILLIKEPHRASE1 "
+                "    OR program.subtitle LIKE :PGILLIKEPHRASE2 "
+                "    OR program.description LIKE :PGILLIKEPHRASE3 ) ";
+            bindings[":PGILLIKEPHRASE1"] = QString("%") + qphrase + '%';
+            bindings[":PGILLIKEPHRASE2"] = QString("%") + qphrase + '%';
+            bindings[":PGILLIKEPHRASE3"] = QString("%") + qphrase + '%';
+        }
+    }
     else if (m_type == plPeopleSearch) // people search
     {
         where = ", people, credits "
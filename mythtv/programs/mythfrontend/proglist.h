@@ -25,7 +25,8 @@ enum ProgListType {
     plTime,
     plRecordid,
     plStoredSearch,
-    plPreviouslyRecorded
+    plPreviouslyRecorded,
+    plWordSearch
 };
 
 class ProgLister : public ScheduleCommon
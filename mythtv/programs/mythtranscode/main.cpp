@@ -21,6 +21,7 @@ using namespace std;
 #include "mythdate.h"
 #include "transcode.h"
 #include "mpeg2fix.h"
+#include "smartcut.h"
 #include "remotefile.h"
 #include "mythtranslation.h"
 #include "loggingserver.h"
@@ -635,7 +636,44 @@ int main(int argc, char *argv[])
     }
 
     int exitcode = GENERIC_EXIT_OK;
-    if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
+    if (result == REENCODE_SMARTCUT)
+    {
+        void (*update_func)(float) = nullptr;
+        int (*check_func)() = nullptr;
+        LOG(VB_GENERAL, LOG_INFO, "Honoring the cutlist while smart cutting");
+        if (deleteMap.isEmpty())
+            pginfo->QueryCutList(deleteMap);
+        if (jobID >= 0)
+        {
+           glbl_jobID = jobID;
+           update_func = &UpdateJobQueue;
+           check_func = &CheckJobQueue;
+        }
+
+        SmartCutter cutter(infile, outfile, &deleteMap, showprogress,
+                           update_func, check_func);
+        result = cutter.Start();
+        if (result == REENCODE_OK)
+        {
+            if (jobID >= 0)
+                JobQueue::ChangeJobComment(jobID,
+                                    QObject::tr("Generating Keyframe Index"));
+            result = cutter.BuildKeyframeIndex(posMap, durMap);
+            if (result == REENCODE_OK)
+            {
+                if (update_index)
+                    UpdatePositionMap(posMap, durMap, nullptr, pginfo);
+                else
+                    UpdatePositionMap(posMap, durMap, outfile + QString(".map"),
+                                      pginfo);
+            }
+            RecordingInfo recInfo(*pginfo);
+            RecordingFile *recFile = recInfo.GetRecordingFile();
+            recFile->m_containerFormat = formatMPEG2_TS;
+            recFile->Save();
+        }
+    }
+    else if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
     {
         void (*update_func)(float) = nullptr;
         int (*check_func)() = nullptr;
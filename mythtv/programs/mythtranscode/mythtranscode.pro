@@ -18,12 +18,12 @@ macx: QMAKE_CFLAGS -= -O3 -O2 -O1 -Os
 # Input
 SOURCES += main.cpp transcode.cpp mpeg2fix.cpp
 SOURCES += audioreencodebuffer.cpp cutter.cpp videodecodebuffer.cpp
-SOURCES += commandlineparser.cpp
+SOURCES += commandlineparser.cpp smartcut.cpp
 SOURCES += external/replex/element.c external/replex/mpg_common.c
 SOURCES += external/replex/multiplex.c external/replex/pes.c
 SOURCES += external/replex/ringbuffer.c external/replex/ts.c
 
-HEADERS += mpeg2fix.h transcodedefs.h commandlineparser.h
+HEADERS += mpeg2fix.h transcodedefs.h commandlineparser.h smartcut.h
 HEADERS += audioreencodebuffer.h cutter.h videodecodebuffer.h
 HEADERS += external/replex/element.h external/replex/mpg_common.h
 HEADERS += external/replex/multiplex.h external/replex/pes.h
@@ -43,3 +43,5 @@ DEPENDPATH += ../../libs/libmythtv/recorders
 }
 
 INCLUDEPATH += $$DEPENDPATH
+
+using_ffmpeg_threads:DEFINES += USING_FFMPEG_THREADS
@@ -0,0 +1,719 @@
+#include "smartcut.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <QFileInfo>
+
+#include "mythlogging.h"
+#include "mythdate.h"
+#include "transcodedefs.h"
+
+extern "C" {
+#include "libavutil/opt.h"
+}
+
+#define LOC QString("SmartCut: ")
+
+// Quality of the re-encoded boundary GOPs. These are short and sit right
+// next to copied video, so they are encoded close to transparently.
+static const char *kEncoderCRF    = "18";
+static const char *kEncoderPreset = "fast";
+
+SmartCutter::SmartCutter(QString inf, QString outf,
+                         const frm_dir_map_t *deleteMap, bool showprog,
+                         void (*update_func)(float), int (*check_func)())
+  : m_infile(std::move(inf)), m_outfile(std::move(outf)),
+    m_showProgress(showprog), m_updateStatus(update_func),
+    m_checkAbort(check_func)
+{
+    BuildCutList(deleteMap);
+
+    if (m_showProgress || m_updateStatus)
+    {
+        if (m_updateStatus)
+        {
+            m_statusUpdateTime = 20;
+            m_updateStatus(0);
+        }
+        m_statusTime = MythDate::current().addSecs(m_statusUpdateTime);
+
+        const QFileInfo finfo(m_infile);
+        m_fileSize = finfo.size();
+    }
+}
+
+SmartCutter::~SmartCutter()
+{
+    FreePackets(m_gop);
+    FreePackets(m_prevGop);
+    CloseEncoder();
+    avcodec_free_context(&m_decoder);
+    av_frame_free(&m_frame);
+    avformat_close_input(&m_inputFC);
+    if (m_outputFC)
+    {
+        if (m_outputFC->pb)
+            avio_closep(&m_outputFC->pb);
+        avformat_free_context(m_outputFC);
+    }
+}
+
+/// \brief Returns true if \a inputfile is a recording SmartCutter can cut.
+bool SmartCutter::IsSupported(const QString &inputfile)
+{
+    QByteArray ifarray = inputfile.toLocal8Bit();
+    AVFormatContext *fc = nullptr;
+    if (avformat_open_input(&fc, ifarray.constData(), nullptr, nullptr) != 0)
+        return false;
+
+    bool supported = false;
+    if (avformat_find_stream_info(fc, nullptr) >= 0 &&
+        strcmp(fc->iformat->name, "mpegts") == 0)
+    {
+        int vidId = av_find_best_stream(fc, AVMEDIA_TYPE_VIDEO,
+                                        -1, -1, nullptr, 0);
+        if (vidId >= 0)
+        {
+            AVCodecID id = fc->streams[vidId]->codecpar->codec_id;
+            supported = (id == AV_CODEC_ID_H264 || id == AV_CODEC_ID_HEVC) &&
+                        avcodec_find_decoder(id) && avcodec_find_encoder(id);
+        }
+    }
+
+    avformat_close_input(&fc);
+    return supported;
+}
+
+/// Converts the MythTV cutlist into a sorted list of removed frame ranges.
+void SmartCutter::BuildCutList(const frm_dir_map_t *deleteMap)
+{
+    if (!deleteMap)
+        return;
+
+    int64_t start = -1;
+    bool firstMark = true;
+    frm_dir_map_t::const_iterator it = deleteMap->begin();
+    for (; it != deleteMap->end(); ++it)
+    {
+        auto mark = static_cast<int64_t>(it.key());
+        if (*it == MARK_CUT_START && start < 0)
+        {
+            start = mark;
+        }
+        else if (*it == MARK_CUT_END)
+        {
+            if (start >= 0)
+                m_cuts.push_back(qMakePair(start, mark));
+            else if (firstMark)
+                m_cuts.push_back(qMakePair(int64_t(0), mark));
+            start = -1;
+        }
+        firstMark = false;
+    }
+    if (start >= 0)
+        m_cuts.push_back(qMakePair(start, std::numeric_limits<int64_t>::max()));
+}
+
+bool SmartCutter::InitInput(void)
+{
+    QByteArray ifarray = m_infile.toLocal8Bit();
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Opening %1").arg(m_infile));
+
+    int ret = avformat_open_input(&m_inputFC, ifarray.constData(),
+                                  nullptr, nullptr);
+    if (ret)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open input file, error #%1").arg(ret));
+        return false;
+    }
+
+    ret = avformat_find_stream_info(m_inputFC, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't get stream info, error #%1").arg(ret));
+        return false;
+    }
+
+    m_vidId = av_find_best_stream(m_inputFC, AVMEDIA_TYPE_VIDEO,
+                                  -1, -1, nullptr, 0);
+    if (m_vidId < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "No video stream found");
+        return false;
+    }
+
+    AVStream *st = m_inputFC->streams[m_vidId];
+    m_frameRate = av_guess_frame_rate(m_inputFC, st, nullptr);
+    if (m_frameRate.num > 0 && m_frameRate.den > 0)
+        m_frameDuration = av_rescale_q(1, av_inv_q(m_frameRate), st->time_base);
+    if (m_frameDuration <= 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unknown video frame rate");
+        return false;
+    }
+
+    const AVCodec *codec = avcodec_find_decoder(st->codecpar->codec_id);
+    m_decoder = codec ? avcodec_alloc_context3(codec) : nullptr;
+    if (!m_decoder ||
+        avcodec_parameters_to_context(m_decoder, st->codecpar) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create video decoder");
+        return false;
+    }
+    m_decoder->pkt_timebase = st->time_base;
+    m_decoder->thread_count = 0;
+
+    ret = avcodec_open2(m_decoder, codec, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open video decoder, error #%1").arg(ret));
+        return false;
+    }
+
+    m_frame = av_frame_alloc();
+    return m_frame != nullptr;
+}
+
+bool SmartCutter::InitOutput(void)
+{
+    QByteArray ofarray = m_outfile.toLocal8Bit();
+
+    avformat_alloc_output_context2(&m_outputFC, nullptr, "mpegts",
+                                   ofarray.constData());
+    if (!m_outputFC)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create output context");
+        return false;
+    }
+
+    m_streamMap.fill(-1, m_inputFC->nb_streams);
+    for (uint i = 0; i < m_inputFC->nb_streams; i++)
+    {
+        AVStream *in = m_inputFC->streams[i];
+        AVMediaType type = in->codecpar->codec_type;
+
+        if (static_cast<int>(i) != m_vidId &&
+            type != AVMEDIA_TYPE_AUDIO && type != AVMEDIA_TYPE_SUBTITLE)
+            continue;
+        if (type == AVMEDIA_TYPE_AUDIO && in->codecpar->channels == 0)
+            continue;
+
+        AVStream *out = avformat_new_stream(m_outputFC, nullptr);
+        if (!out || avcodec_parameters_copy(out->codecpar, in->codecpar) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Couldn't create output stream for stream %1").arg(i));
+            return false;
+        }
+        out->codecpar->codec_tag = 0;
+        out->time_base   = in->time_base;
+        out->disposition = in->disposition;
+        av_dict_copy(&out->metadata, in->metadata, 0);
+        m_streamMap[i] = out->index;
+    }
+
+    int ret = avio_open(&m_outputFC->pb, ofarray.constData(), AVIO_FLAG_WRITE);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open output file '%1', error #%2")
+                .arg(m_outfile).arg(ret));
+        return false;
+    }
+
+    ret = avformat_write_header(m_outputFC, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't write output header, error #%1").arg(ret));
+        return false;
+    }
+
+    return true;
+}
+
+/** \brief Opens an encoder for one boundary GOP using the properties
+ *         of its first decoded frame.
+ *
+ *   B-frames are disabled so the re-encoded packets have monotonic
+ *   timestamps and can be spliced between copied GOPs.
+ */
+bool SmartCutter::OpenEncoder(const AVFrame *frame)
+{
+    const AVCodec *codec = avcodec_find_encoder(m_decoder->codec_id);
+    m_encoder = codec ? avcodec_alloc_context3(codec) : nullptr;
+    if (!m_encoder)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create video encoder");
+        return false;
+    }
+
+    m_encoder->width               = frame->width;
+    m_encoder->height              = frame->height;
+    m_encoder->pix_fmt             = static_cast<AVPixelFormat>(frame->format);
+    m_encoder->sample_aspect_ratio = frame->sample_aspect_ratio;
+    m_encoder->color_range         = frame->color_range;
+    m_encoder->color_primaries     = frame->color_primaries;
+    m_encoder->color_trc           = frame->color_trc;
+    m_encoder->colorspace          = frame->colorspace;
+    m_encoder->time_base   = m_inputFC->streams[m_vidId]->time_base;
+    m_encoder->framerate   = m_frameRate;
+    m_encoder->max_b_frames = 0;
+    m_encoder->gop_size    = std::numeric_limits<int16_t>::max();
+    m_encoder->thread_count = 0;
+    if (frame->interlaced_frame)
+    {
+        m_encoder->flags |= AV_CODEC_FLAG_INTERLACED_DCT |
+                            AV_CODEC_FLAG_INTERLACED_ME;
+        m_encoder->field_order = frame->top_field_first ? AV_FIELD_TT
+                                                        : AV_FIELD_BB;
+    }
+    av_opt_set(m_encoder->priv_data, "crf", kEncoderCRF, 0);
+    av_opt_set(m_encoder->priv_data, "preset", kEncoderPreset, 0);
+
+    int ret = avcodec_open2(m_encoder, codec, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open %1 encoder, error #%2")
+                .arg(codec->name).arg(ret));
+        avcodec_free_context(&m_encoder);
+        return false;
+    }
+
+    m_encoderKeyFrame = false;
+    return true;
+}
+
+void SmartCutter::CloseEncoder(void)
+{
+    avcodec_free_context(&m_encoder);
+}
+
+/// Display order frame number of a timestamp, as used by the cutlist.
+int64_t SmartCutter::FrameNumber(int64_t ts, AVRational timebase) const
+{
+    AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+    int64_t offset = av_rescale_q(ts, timebase, vidBase) - m_startPts;
+    if (offset < 0)
+        return 0;
+    return (offset + (m_frameDuration / 2)) / m_frameDuration;
+}
+
+bool SmartCutter::IsKept(int64_t frame) const
+{
+    for (const auto &cut : m_cuts)
+    {
+        if (frame >= cut.first && frame < cut.second)
+            return false;
+    }
+    return true;
+}
+
+/// Number of frames removed by the cuts that end before \a frame.
+int64_t SmartCutter::RemovedBefore(int64_t frame) const
+{
+    int64_t removed = 0;
+    for (const auto &cut : m_cuts)
+    {
+        if (cut.second <= frame)
+            removed += cut.second - cut.first;
+    }
+    return removed;
+}
+
+/// Moves a timestamp of \a frame back by the duration of the earlier cuts.
+int64_t SmartCutter::Shift(int64_t ts, int64_t frame,
+                           AVRational timebase) const
+{
+    if (ts == AV_NOPTS_VALUE)
+        return ts;
+    AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+    return ts - av_rescale_q(RemovedBefore(frame) * m_frameDuration,
+                             vidBase, timebase);
+}
+
+int64_t SmartCutter::PacketTime(const AVPacket *pkt)
+{
+    return (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+}
+
+void SmartCutter::FreePackets(PacketList &packets)
+{
+    for (auto *pkt : packets)
+        av_packet_free(&pkt);
+    packets.clear();
+}
+
+bool SmartCutter::WritePacket(AVPacket *pkt, int inputId, AVRational timebase)
+{
+    int outId = m_streamMap[inputId];
+    AVStream *out = m_outputFC->streams[outId];
+
+    pkt->stream_index = outId;
+    pkt->pos = -1;
+    av_packet_rescale_ts(pkt, timebase, out->time_base);
+
+    int ret = av_interleaved_write_frame(m_outputFC, pkt);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't write packet of stream %1, error #%2")
+                .arg(inputId).arg(ret));
+        return false;
+    }
+    return true;
+}
+
+/** \brief Writes out the buffered GOP.
+ *
+ *   A GOP is dropped when none of its frames are kept and copied when all
+ *   the frames from its keyframe on are kept. Its leading pictures, shown
+ *   before the keyframe in an open GOP, reference the previous GOP. They
+ *   are copied with the GOP when the previous GOP was copied and all of
+ *   them are kept, otherwise the kept ones are re-encoded on their own.
+ *   Any other GOP is re-encoded.
+ */
+bool SmartCutter::ProcessGOP(void)
+{
+    if (m_gop.isEmpty())
+        return true;
+
+    AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+    int64_t keyTime = PacketTime(m_gop.first());
+    int kept = 0;
+    int leading = 0;
+    int keptLeading = 0;
+    for (const auto *pkt : m_gop)
+    {
+        int64_t ts = PacketTime(pkt);
+        bool isKept = IsKept(FrameNumber(ts, vidBase));
+        if (isKept)
+            kept++;
+        if (ts < keyTime)
+        {
+            leading++;
+            if (isKept)
+                keptLeading++;
+        }
+    }
+    bool openGOP = (leading > 0);
+
+    bool ok = true;
+    if (kept == 0)
+    {
+        m_gopsDropped++;
+        m_prevGopCopied = false;
+    }
+    else if (kept - keptLeading == m_gop.size() - leading)
+    {
+        bool copyLeading = m_prevGopCopied && (keptLeading == leading);
+        if (!copyLeading && keptLeading > 0)
+            ok = ReencodeGOP(openGOP, true);
+        ok = ok && CopyGOP(copyLeading);
+        m_prevGopCopied = true;
+    }
+    else
+    {
+        ok = ReencodeGOP(openGOP, false);
+        m_prevGopCopied = false;
+    }
+
+    FreePackets(m_prevGop);
+    m_prevGop = m_gop;
+    m_gop.clear();
+
+    return ok;
+}
+
+/** \brief Copies the buffered GOP.
+ *  \param withLeading Also copy the leading pictures of an open GOP.
+ */
+bool SmartCutter::CopyGOP(bool withLeading)
+{
+    AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+    int64_t keyTime = PacketTime(m_gop.first());
+    int64_t frame = FrameNumber(keyTime, vidBase);
+
+    for (const auto *pkt : m_gop)
+    {
+        if (!withLeading && PacketTime(pkt) < keyTime)
+            continue;
+
+        AVPacket *copy = av_packet_clone(pkt);
+        if (!copy)
+            return false;
+        copy->pts = Shift(copy->pts, frame, vidBase);
+        copy->dts = Shift(copy->dts, frame, vidBase);
+        bool ok = WritePacket(copy, m_vidId, vidBase);
+        av_packet_free(&copy);
+        if (!ok)
+            return false;
+    }
+
+    m_gopsCopied++;
+    return true;
+}
+
+/** \brief Decodes the buffered GOP and re-encodes the frames that are kept.
+ *  \param openGOP     The GOP references the previous one, which is decoded
+ *                     first so that its leading frames are complete.
+ *  \param leadingOnly Only re-encode the leading pictures, the rest of the
+ *                     GOP is copied.
+ */
+bool SmartCutter::ReencodeGOP(bool openGOP, bool leadingOnly)
+{
+    AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+    int64_t keyTime = PacketTime(m_gop.first());
+
+    // Only decode as far as the last frame to be encoded
+    m_gopTimes.clear();
+    int count = 0;
+    for (int i = 0; i < m_gop.size(); ++i)
+    {
+        int64_t ts = PacketTime(m_gop[i]);
+        if (leadingOnly && ts >= keyTime)
+            continue;
+        if (IsKept(FrameNumber(ts, vidBase)))
+        {
+            m_gopTimes.push_back(ts);
+            count = i + 1;
+        }
+    }
+
+    avcodec_flush_buffers(m_decoder);
+
+    bool ok = true;
+    if (openGOP)
+    {
+        for (const auto *pkt : m_prevGop)
+            ok = ok && DecodePacket(pkt);
+    }
+    for (int i = 0; i < count; ++i)
+        ok = ok && DecodePacket(m_gop[i]);
+    ok = ok && DecodePacket(nullptr);
+    avcodec_flush_buffers(m_decoder);
+
+    ok = ok && EncodeFrame(nullptr);
+    CloseEncoder();
+
+    if (!leadingOnly)
+        m_gopsReencoded++;
+    return ok;
+}
+
+/// Sends one packet to the decoder, nullptr drains it, and encodes the
+/// resulting frames that belong to the GOP being re-encoded.
+bool SmartCutter::DecodePacket(const AVPacket *pkt)
+{
+    int ret = avcodec_send_packet(m_decoder, pkt);
+    if (ret < 0 && ret != AVERROR_EOF)
+    {
+        // A damaged packet only costs the frames that depend on it
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Video decode error #%1").arg(ret));
+        return true;
+    }
+
+    while ((ret = avcodec_receive_frame(m_decoder, m_frame)) >= 0)
+    {
+        bool ok = true;
+        if (m_gopTimes.contains(m_frame->best_effort_timestamp))
+            ok = EncodeFrame(m_frame);
+        av_frame_unref(m_frame);
+        if (!ok)
+            return false;
+    }
+
+    return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF;
+}
+
+/// Encodes \a frame and writes the resulting packets, nullptr drains the
+/// encoder.
+bool SmartCutter::EncodeFrame(AVFrame *frame)
+{
+    if (frame)
+    {
+        if (!m_encoder && !OpenEncoder(frame))
+            return false;
+
+        AVRational vidBase = m_inputFC->streams[m_vidId]->time_base;
+        int64_t ts = frame->best_effort_timestamp;
+        frame->pts = Shift(ts, FrameNumber(ts, vidBase), vidBase);
+        frame->pict_type = m_encoderKeyFrame ? AV_PICTURE_TYPE_NONE
+                                             : AV_PICTURE_TYPE_I;
+        m_encoderKeyFrame = true;
+        m_framesReencoded++;
+    }
+    else if (!m_encoder)
+    {
+        return true;
+    }
+
+    int ret = avcodec_send_frame(m_encoder, frame);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Video encode error #%1").arg(ret));
+        return false;
+    }
+
+    AVPacket *pkt = av_packet_alloc();
+    bool ok = true;
+    while (ok && (ret = avcodec_receive_packet(m_encoder, pkt)) >= 0)
+    {
+        // Without B-frames the encoder's decode timestamps equal the
+        // presentation ones, give them the same delay as the copied GOPs
+        // so the two can follow each other.
+        if (pkt->pts != AV_NOPTS_VALUE)
+            pkt->dts = pkt->pts - m_dtsDelay;
+        ok = WritePacket(pkt, m_vidId, m_encoder->time_base);
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+
+    return ok && (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF);
+}
+
+/// Reports progress, returns false if the job has been asked to stop.
+bool SmartCutter::CheckProgress(int64_t pos)
+{
+    if ((!m_showProgress && !m_updateStatus) ||
+        MythDate::current() <= m_statusTime || m_fileSize <= 0 || pos < 0)
+        return true;
+
+    float percent_done = 100.0 * pos / m_fileSize;
+    if (m_updateStatus)
+        m_updateStatus(percent_done);
+    if (m_showProgress)
+        LOG(VB_GENERAL, LOG_INFO, QString("%1% complete")
+                .arg(percent_done, 0, 'f', 1));
+    if (m_checkAbort && m_checkAbort())
+        return false;
+    m_statusTime = MythDate::current().addSecs(m_statusUpdateTime);
+    return true;
+}
+
+int SmartCutter::Start(void)
+{
+    if (!InitInput() || !InitOutput())
+        return REENCODE_ERROR;
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Cutting %1 ranges from %2 video at %3 fps")
+            .arg(m_cuts.size()).arg(m_decoder->codec->name)
+            .arg(av_q2d(m_frameRate), 0, 'f', 2));
+
+    AVPacket *pkt = av_packet_alloc();
+    int result = REENCODE_OK;
+    while (result == REENCODE_OK && av_read_frame(m_inputFC, pkt) >= 0)
+    {
+        int id = pkt->stream_index;
+        int64_t ts = PacketTime(pkt);
+
+        if (!CheckProgress(pkt->pos))
+        {
+            result = REENCODE_STOPPED;
+        }
+        else if (id == m_vidId)
+        {
+            if (pkt->pts != AV_NOPTS_VALUE && pkt->dts != AV_NOPTS_VALUE)
+                m_dtsDelay = std::max(m_dtsDelay, pkt->pts - pkt->dts);
+
+            if (pkt->flags & AV_PKT_FLAG_KEY)
+            {
+                if (m_startPts == AV_NOPTS_VALUE)
+                    m_startPts = ts;
+                if (!ProcessGOP())
+                    result = REENCODE_ERROR;
+            }
+
+            // Nothing before the first keyframe can be decoded
+            if (m_startPts != AV_NOPTS_VALUE && ts != AV_NOPTS_VALUE)
+                m_gop.push_back(av_packet_clone(pkt));
+        }
+        else if (m_streamMap.value(id, -1) >= 0 &&
+                 m_startPts != AV_NOPTS_VALUE && ts != AV_NOPTS_VALUE)
+        {
+            AVRational timebase = m_inputFC->streams[id]->time_base;
+            int64_t frame = FrameNumber(ts, timebase);
+            if (IsKept(frame))
+            {
+                pkt->pts = Shift(pkt->pts, frame, timebase);
+                pkt->dts = Shift(pkt->dts, frame, timebase);
+                if (!WritePacket(pkt, id, timebase))
+                    result = REENCODE_ERROR;
+            }
+        }
+
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+
+    if (result == REENCODE_OK && !ProcessGOP())
+        result = REENCODE_ERROR;
+
+    if (result == REENCODE_OK && av_write_trailer(m_outputFC) < 0)
+        result = REENCODE_ERROR;
+    avio_closep(&m_outputFC->pb);
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Copied %1 GOPs, re-encoded %2 GOPs (%3 frames), "
+                "dropped %4 GOPs")
+            .arg(m_gopsCopied).arg(m_gopsReencoded)
+            .arg(m_framesReencoded).arg(m_gopsDropped));
+
+    return result;
+}
+
+/** \brief Builds the keyframe position and duration maps of the cut file.
+ *
+ *   The positions are read back from the written file as the muxer
+ *   decides where each packet ends up.
+ */
+int SmartCutter::BuildKeyframeIndex(frm_pos_map_t &posMap,
+                                    frm_pos_map_t &durMap)
+{
+    LOG(VB_GENERAL, LOG_INFO, LOC + "Generating Keyframe Index");
+
+    QByteArray ofarray = m_outfile.toLocal8Bit();
+    AVFormatContext *fc = nullptr;
+    if (avformat_open_input(&fc, ofarray.constData(), nullptr, nullptr) != 0)
+        return REENCODE_ERROR;
+    if (avformat_find_stream_info(fc, nullptr) < 0)
+    {
+        avformat_close_input(&fc);
+        return REENCODE_ERROR;
+    }
+
+    int vidId = av_find_best_stream(fc, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    AVPacket *pkt = av_packet_alloc();
+    uint64_t count = 0;
+    uint64_t totalDuration = 0;
+    while (vidId >= 0 && av_read_frame(fc, pkt) >= 0)
+    {
+        if (pkt->stream_index == vidId)
+        {
+            if (pkt->flags & AV_PKT_FLAG_KEY)
+            {
+                posMap[count] = pkt->pos;
+                durMap[count] = totalDuration;
+            }
+            int64_t duration = pkt->duration ? pkt->duration : m_frameDuration;
+            totalDuration +=
+                av_q2d(fc->streams[vidId]->time_base) * duration * 1000; // msec
+            count++;
+        }
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+    avformat_close_input(&fc);
+
+    return (vidId >= 0) ? REENCODE_OK : REENCODE_ERROR;
+}
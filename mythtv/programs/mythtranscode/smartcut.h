@@ -0,0 +1,94 @@
+#ifndef SMARTCUT_H
+#define SMARTCUT_H
+
+#include <cstdint>                      // for int64_t
+
+#include <QDateTime>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include "programtypes.h"               // for frm_dir_map_t
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+}
+
+// SmartCutter removes the cutlist from an H.264 or HEVC MPEG-TS
+// recording without transcoding all of it. Whole GOPs between the
+// cuts are copied as they are; only the GOPs a cut passes through,
+// and the leading pictures of an open GOP following a cut, are
+// decoded and re-encoded, so that each kept section starts and ends
+// on the exact frame the cutlist asks for.
+class SmartCutter
+{
+  public:
+    SmartCutter(QString inf, QString outf, const frm_dir_map_t *deleteMap,
+                bool showprog, void (*update_func)(float) = nullptr,
+                int (*check_func)() = nullptr);
+    ~SmartCutter();
+
+    static bool IsSupported(const QString &inputfile);
+    int Start(void);
+    int BuildKeyframeIndex(frm_pos_map_t &posMap, frm_pos_map_t &durMap);
+
+  private:
+    using PacketList = QList<AVPacket*>;
+
+    bool    InitInput(void);
+    bool    InitOutput(void);
+    bool    OpenEncoder(const AVFrame *frame);
+    void    CloseEncoder(void);
+    void    BuildCutList(const frm_dir_map_t *deleteMap);
+    int64_t FrameNumber(int64_t ts, AVRational timebase) const;
+    bool    IsKept(int64_t frame) const;
+    int64_t RemovedBefore(int64_t frame) const;
+    int64_t Shift(int64_t ts, int64_t frame, AVRational timebase) const;
+    bool    ProcessGOP(void);
+    bool    CopyGOP(bool withLeading);
+    bool    ReencodeGOP(bool openGOP, bool leadingOnly);
+    bool    DecodePacket(const AVPacket *pkt);
+    bool    EncodeFrame(AVFrame *frame);
+    bool    WritePacket(AVPacket *pkt, int inputId, AVRational timebase);
+    bool    CheckProgress(int64_t pos);
+    static int64_t PacketTime(const AVPacket *pkt);
+    static void FreePackets(PacketList &packets);
+
+    QString          m_infile;
+    QString          m_outfile;
+    QVector<QPair<int64_t,int64_t> > m_cuts; ///< removed [start,end) frames
+
+    AVFormatContext *m_inputFC            {nullptr};
+    AVFormatContext *m_outputFC           {nullptr};
+    AVCodecContext  *m_decoder            {nullptr};
+    AVCodecContext  *m_encoder            {nullptr};
+    AVFrame         *m_frame              {nullptr};
+    int              m_vidId              {-1};
+    QVector<int>     m_streamMap;         ///< input stream to output stream
+    AVRational       m_frameRate          {0, 1};
+    int64_t          m_frameDuration      {0}; ///< in video stream timebase
+    int64_t          m_startPts           {AV_NOPTS_VALUE};
+    int64_t          m_dtsDelay           {0}; ///< largest video pts - dts
+
+    PacketList       m_gop;
+    PacketList       m_prevGop;
+    bool             m_prevGopCopied      {true};
+    QList<int64_t>   m_gopTimes;          ///< pts of the GOP being encoded
+    bool             m_encoderKeyFrame    {false};
+
+    uint             m_gopsCopied         {0};
+    uint             m_gopsReencoded      {0};
+    uint             m_gopsDropped        {0};
+    uint             m_framesReencoded    {0};
+
+    bool             m_showProgress       {false};
+    void           (*m_updateStatus)(float) {nullptr};
+    int            (*m_checkAbort)()      {nullptr};
+    int              m_statusUpdateTime   {5};
+    QDateTime        m_statusTime;
+    int64_t          m_fileSize           {0};
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include <fcntl.h>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -34,6 +35,7 @@
 
 #include "videodecodebuffer.h"
 #include "cutter.h"
+#include "smartcut.h"
 #include "audioreencodebuffer.h"
 
 extern "C" {
@@ -147,7 +149,7 @@ void Transcode::SetPlayerContext(PlayerContext *player_ctx)
     m_ctx = player_ctx;
 }
 
-#if CONFIG_LIBMP3LAME
+#if CONFIG_LIBMP3LAME || defined(USING_FFMPEG_THREADS)
 static QString get_str_option(RecordingProfile *profile, const QString &name)
 {
     const StandardSetting *setting = profile->byName(name);
@@ -177,7 +179,36 @@ static int get_int_option(RecordingProfile *profile, const QString &name)
 
     return ret_int;
 }
+#endif
+
+/** \brief Describes how fast each transcoding stage would run on its own.
+ *
+ *   A stage's rate is the number of frames it handled divided by the time
+ *   it was busy, so the slowest stage is the one limiting the overall rate.
+ */
+static QString StageRates(const VideoDecodeBuffer *videoBuffer,
+                          long encodedFrames, qint64 encodeNSecs)
+{
+    long decodedFrames = 0;
+    qint64 decodeMs = 0;
+    qint64 scaleMs = 0;
+    videoBuffer->GetStageTimes(decodedFrames, decodeMs, scaleMs);
+
+    auto rate = [](long frames, qint64 msecs)
+    {
+        return (msecs > 0) ? QString::number(frames * 1000.0 / msecs, 'f', 1)
+                           : QString("-");
+    };
+
+    QString rates = QString("decode %1").arg(rate(decodedFrames, decodeMs));
+    if (scaleMs > 0)
+        rates += QString(", scale %1").arg(rate(decodedFrames, scaleMs));
+    rates += QString(", encode %1 fps")
+        .arg(rate(encodedFrames, encodeNSecs / 1000000));
+    return rates;
+}
 
+#if CONFIG_LIBMP3LAME
 static bool get_bool_option(RecordingProfile *profile, const QString &name)
 {
     return get_int_option(profile, name) != 0;
@@ -211,7 +242,7 @@ int Transcode::TranscodeFile(const QString &inputname,
     int hlsSegmentSize = 0;
     int hlsSegmentFrames = 0;
 
-#if !CONFIG_LIBMP3LAME
+#if !CONFIG_LIBMP3LAME && !defined(USING_FFMPEG_THREADS)
     (void)profileName;
 #endif
 
@@ -544,11 +575,24 @@ int Transcode::TranscodeFile(const QString &inputname,
         }
 
         int threads    = gCoreContext->GetNumSetting("HTTPLiveStreamThreads", 2);
+#ifdef USING_FFMPEG_THREADS
+        // Outside of HLS an explicitly chosen transcoder profile decides
+        // how many threads the encoder may use.
+        if (!m_hlsMode && profileName != "autodetect" &&
+            GetProfile(profileName, encodingType, video_height,
+                       (int)round(video_frame_rate)))
+        {
+            int profileThreads =
+                get_int_option(m_recProfile, "encodingthreadcount");
+            if (profileThreads > 0)
+                threads = profileThreads;
+        }
+#endif
         QString preset = gCoreContext->GetSetting("HTTPLiveStreamPreset", "veryfast");
         QString tune   = gCoreContext->GetSetting("HTTPLiveStreamTune", "film");
 
         LOG(VB_GENERAL, LOG_NOTICE,
-            QString("x264 HLS using: %1 threads, '%2' profile and '%3' tune")
+            QString("x264 using: %1 threads, '%2' profile and '%3' tune")
                 .arg(threads).arg(preset).arg(tune));
 
         avfw->SetThreadCount(threads);
@@ -643,6 +687,15 @@ int Transcode::TranscodeFile(const QString &inputname,
             return REENCODE_MPEG2TRANS;
         }
 
+        if ((encodingType == "H.264" || encodingType == "HEVC") &&
+            honorCutList && get_bool_option(m_recProfile, "transcodelossless") &&
+            SmartCutter::IsSupported(inputname))
+        {
+            LOG(VB_GENERAL, LOG_NOTICE, "Switching to smart cutter.");
+            SetPlayerContext(nullptr);
+            return REENCODE_SMARTCUT;
+        }
+
         // Recorder setup
         if (get_bool_option(m_recProfile, "transcodelossless"))
         {
@@ -1065,13 +1118,40 @@ int Transcode::TranscodeFile(const QString &inputname,
     else
         LOG(VB_GENERAL, LOG_INFO, "Transcoding Video and Audio");
 
+    // Decoding (and scaling, unless writing to fifos) runs on its own
+    // thread, a bounded queue of frames hands them to the encoder here.
+    int queueFrames = std::max(2,
+        gCoreContext->GetNumSetting("TranscodeFrameQueueSize", 5));
     auto *videoBuffer =
-        new VideoDecodeBuffer(GetPlayer(), videoOutput, honorCutList);
+        new VideoDecodeBuffer(GetPlayer(), videoOutput, honorCutList,
+                              queueFrames);
+    if (rescale && !m_fifow && !videoBuffer->SetScaledFormat(frame))
+    {
+        LOG(VB_GENERAL, LOG_WARNING,
+            "Unable to allocate scaling buffers, scaling with the encoder");
+    }
     MThreadPool::globalInstance()->start(videoBuffer, "VideoDecodeBuffer");
 
     QElapsedTimer flagTime;
     flagTime.start();
 
+    // Time spent handing frames to the encoder, excluding queue waits
+    QElapsedTimer encodeTimer;
+    qint64 encodeNSecs = 0;
+    VideoFrame *scaledFrame = nullptr;
+
+    // The frame to encode, on the decode thread's copy when it scaled it
+    auto encodeFrame = [&](VideoFrame *decoded)
+    {
+        if (!rescale)
+            return decoded;
+        if (!scaledFrame)
+            return &frame;
+        scaledFrame->timecode    = frame.timecode;
+        scaledFrame->frameNumber = frame.frameNumber;
+        return scaledFrame;
+    };
+
     if (cutter)
         cutter->Activate(vidFrameTime * rateTimeConv, total_frame_count);
 
@@ -1085,8 +1165,10 @@ int Transcode::TranscodeFile(const QString &inputname,
     }
 
     while ((!stopSignalled) &&
-           (lastDecode = videoBuffer->GetFrame(did_ff, is_key)))
+           (lastDecode = videoBuffer->GetFrame(did_ff, is_key, &scaledFrame)))
     {
+        encodeTimer.start();
+
         if (first_loop)
         {
             copyaudio = GetPlayer()->GetRawAudioState();
@@ -1314,7 +1396,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                   writekeyframe = true;
                 }
 
-                if (rescale)
+                if (rescale && !scaledFrame)
                 {
                     AVPictureFill(&imageIn, lastDecode);
                     AVPictureFill(&imageOut, &frame);
@@ -1330,7 +1412,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                               imageOut.data, imageOut.linesize);
                 }
 
-                m_nvr->WriteVideo(rescale ? &frame : lastDecode, true, writekeyframe);
+                m_nvr->WriteVideo(encodeFrame(lastDecode), true, writekeyframe);
             }
             GetPlayer()->GetCC608Reader()->FlushTxtBuffers();
 #else
@@ -1372,7 +1454,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                         .arg(newWidth).arg(newHeight));
             }
 
-            if (rescale)
+            if (rescale && !scaledFrame)
             {
                 AVPictureFill(&imageIn, lastDecode);
                 AVPictureFill(&imageOut, &frame);
@@ -1482,7 +1564,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                         hlsSegmentFrames = 0;
                     }
 
-                    if (avfw->WriteVideoFrame(rescale ? &frame : lastDecode) > 0)
+                    if (avfw->WriteVideoFrame(encodeFrame(lastDecode)) > 0)
                     {
                         lastWrittenTime = frame.timecode + timecodeOffset;
                         if (hls)
@@ -1495,21 +1577,25 @@ int Transcode::TranscodeFile(const QString &inputname,
             else
             {
                 if (forceKeyFrames)
-                    m_nvr->WriteVideo(rescale ? &frame : lastDecode, true, true);
+                    m_nvr->WriteVideo(encodeFrame(lastDecode), true, true);
                 else
-                    m_nvr->WriteVideo(rescale ? &frame : lastDecode);
+                    m_nvr->WriteVideo(encodeFrame(lastDecode));
                 lastWrittenTime = frame.timecode + timecodeOffset;
             }
 #endif
         }
+        encodeNSecs += encodeTimer.nsecsElapsed();
+
         if (MythDate::current() > statustime)
         {
             if (m_showProgress)
             {
                 LOG(VB_GENERAL, LOG_INFO,
-                    QString("Processed: %1 of %2 frames(%3 seconds)").
+                    QString("Processed: %1 of %2 frames(%3 seconds), %4").
                         arg(curFrameNum).arg((long)total_frame_count).
-                        arg((long)(curFrameNum / video_frame_rate)));
+                        arg((long)(curFrameNum / video_frame_rate)).
+                        arg(StageRates(videoBuffer, curFrameNum,
+                                       encodeNSecs)));
             }
 
             if (hls && hls->CheckStop())
@@ -1574,17 +1660,20 @@ int Transcode::TranscodeFile(const QString &inputname,
                 if (hls)
                     hls->UpdatePercentComplete(percentage);
 
+                QString rates = StageRates(videoBuffer, curFrameNum,
+                                           encodeNSecs);
                 if (jobID >= 0)
                 {
                     JobQueue::ChangeJobComment(jobID,
-                              QObject::tr("%1% Completed @ %2 fps.")
-                                          .arg(percentage).arg(flagFPS));
+                              QObject::tr("%1% Completed @ %2 fps (%3).")
+                                          .arg(percentage).arg(flagFPS)
+                                          .arg(rates));
                 }
                 else
                 {
                     LOG(VB_GENERAL, LOG_INFO,
-                        QString("mythtranscode: %1% Completed @ %2 fps.")
-                            .arg(percentage).arg(flagFPS));
+                        QString("mythtranscode: %1% Completed @ %2 fps (%3).")
+                            .arg(percentage).arg(flagFPS).arg(rates));
                 }
 
             }
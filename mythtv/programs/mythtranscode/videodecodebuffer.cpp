@@ -2,9 +2,16 @@
 
 #include "mythplayer.h"
 
+extern "C" {
+#include "libswscale/swscale.h"
+}
+#include "mythavutil.h"
+
 #include <chrono> // for milliseconds
 #include <thread> // for sleep_for
 
+#include <QElapsedTimer>
+
 VideoDecodeBuffer::~VideoDecodeBuffer()
 {
     m_runThread = false;
@@ -12,6 +19,10 @@ VideoDecodeBuffer::~VideoDecodeBuffer()
 
     while (m_isRunning)
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (auto & scaled : m_scaledFrames)
+        av_freep(&scaled.buf);
+    sws_freeContext(m_scaleContext);
 }
 
 void VideoDecodeBuffer::stop(void)
@@ -23,9 +34,61 @@ void VideoDecodeBuffer::stop(void)
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
 }
 
+/** \brief Scale every decoded frame into a copy of \a format on the decode
+ *         thread, so the scaling stage runs in parallel with encoding.
+ *
+ *   Must be called before the buffer is started. Scaled frames are taken
+ *   from a ring that is big enough for a full queue, the frame being
+ *   encoded and the frame being scaled.
+ */
+bool VideoDecodeBuffer::SetScaledFormat(const VideoFrame &format)
+{
+    // The copies must not share the buffer of format, or a failure
+    // below would free it for each of them
+    VideoFrame blank = format;
+    blank.buf = nullptr;
+    m_scaledFrames.resize(m_maxFrames + 2, blank);
+    for (auto & scaled : m_scaledFrames)
+    {
+        scaled.buf = GetAlignedBuffer(format.size);
+        if (!scaled.buf)
+        {
+            for (auto & frame : m_scaledFrames)
+                av_freep(&frame.buf);
+            m_scaledFrames.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+VideoFrame *VideoDecodeBuffer::Scale(const VideoFrame *decoded)
+{
+    VideoFrame *scaled = &m_scaledFrames[m_nextScaled];
+    m_nextScaled = (m_nextScaled + 1) % m_scaledFrames.size();
+
+    AVFrame imageIn;
+    AVFrame imageOut;
+    AVPictureFill(&imageIn, decoded);
+    AVPictureFill(&imageOut, scaled);
+
+    int bottomBand = (decoded->height == 1088) ? 8 : 0;
+    m_scaleContext = sws_getCachedContext(m_scaleContext,
+                   decoded->width, decoded->height, FrameTypeToPixelFormat(decoded->codec),
+                   scaled->width, scaled->height, FrameTypeToPixelFormat(scaled->codec),
+                   SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+
+    sws_scale(m_scaleContext, imageIn.data, imageIn.linesize, 0,
+              decoded->height - bottomBand,
+              imageOut.data, imageOut.linesize);
+
+    return scaled;
+}
+
 void VideoDecodeBuffer::run()
 {
     m_isRunning = true;
+    QElapsedTimer stageTimer;
     while (m_runThread)
     {
         QMutexLocker locker(&m_queueLock);
@@ -36,16 +99,30 @@ void VideoDecodeBuffer::run()
 
             DecodedFrameInfo tfInfo {};
             tfInfo.frame = nullptr;
+            tfInfo.scaled = nullptr;
             tfInfo.didFF = 0;
             tfInfo.isKey = false;
 
+            stageTimer.start();
             if (m_player->TranscodeGetNextFrame(tfInfo.didFF,
                 tfInfo.isKey, m_honorCutlist))
             {
                 tfInfo.frame = m_videoOutput->GetLastDecodedFrame();
+                qint64 decodeNSecs = stageTimer.nsecsElapsed();
+
+                qint64 scaleNSecs = 0;
+                if (tfInfo.frame && !m_scaledFrames.empty())
+                {
+                    stageTimer.start();
+                    tfInfo.scaled = Scale(tfInfo.frame);
+                    scaleNSecs = stageTimer.nsecsElapsed();
+                }
 
                 locker.relock();
                 m_frameList.append(tfInfo);
+                m_framesDecoded++;
+                m_decodeNSecs += decodeNSecs;
+                m_scaleNSecs += scaleNSecs;
             }
             else if (m_player->GetEof() != kEofStateNone)
             {
@@ -65,7 +142,13 @@ void VideoDecodeBuffer::run()
     m_isRunning = false;
 }
 
-VideoFrame *VideoDecodeBuffer::GetFrame(int &didFF, bool &isKey)
+/** \brief Takes the next decoded frame off the queue, waiting for one if
+ *         necessary.
+ *  \param scaled Set to the copy made by the scaling stage, or nullptr
+ *                if SetScaledFormat() was not called.
+ */
+VideoFrame *VideoDecodeBuffer::GetFrame(int &didFF, bool &isKey,
+                                        VideoFrame **scaled)
 {
     QMutexLocker locker(&m_queueLock);
 
@@ -86,9 +169,20 @@ VideoFrame *VideoDecodeBuffer::GetFrame(int &didFF, bool &isKey)
 
     didFF = tfInfo.didFF;
     isKey = tfInfo.isKey;
+    if (scaled)
+        *scaled = tfInfo.scaled;
 
     return tfInfo.frame;
 }
 
-/* vim: set expandtab tabstop=4 shiftwidth=4: */
+/// Frames decoded so far and the time the decode and scale stages were busy.
+void VideoDecodeBuffer::GetStageTimes(long &frames, qint64 &decodeMs,
+                                      qint64 &scaleMs) const
+{
+    QMutexLocker locker(&m_queueLock);
+    frames   = m_framesDecoded;
+    decodeMs = m_decodeNSecs / 1000000;
+    scaleMs  = m_scaleNSecs / 1000000;
+}
 
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -6,10 +6,13 @@
 #include <QMutex>
 #include <QRunnable>
 
+#include <vector>
+
 #include "mythvideoout.h"
 
 class MythPlayer;
 class MythVideoOutput;
+struct SwsContext;
 
 class VideoDecodeBuffer : public QRunnable
 {
@@ -22,28 +25,40 @@ class VideoDecodeBuffer : public QRunnable
 
     void          stop(void);
     void run() override; // QRunnable
-    VideoFrame *GetFrame(int &didFF, bool &isKey);
+    bool SetScaledFormat(const VideoFrame &format);
+    VideoFrame *GetFrame(int &didFF, bool &isKey,
+                         VideoFrame **scaled = nullptr);
+    void GetStageTimes(long &frames, qint64 &decodeMs, qint64 &scaleMs) const;
 
   private:
     struct DecodedFrameInfo
     {
         VideoFrame *frame;
+        VideoFrame *scaled;
         int         didFF;
         bool        isKey;
     };
 
+    VideoFrame *Scale(const VideoFrame *decoded);
+
     MythPlayer * const      m_player      {nullptr};
     MythVideoOutput * const m_videoOutput {nullptr};
     bool const              m_honorCutlist;
     int const               m_maxFrames;
     bool volatile           m_runThread   {true};
     bool volatile           m_isRunning   {false};
+    // Only touched by the decode thread once it is running
+    std::vector<VideoFrame> m_scaledFrames;
+    size_t                  m_nextScaled  {0};
+    SwsContext             *m_scaleContext {nullptr};
     QMutex mutable          m_queueLock; // Guards the following...
     bool                    m_eof         {false};
     QList<DecodedFrameInfo> m_frameList;
     QWaitCondition          m_frameWaitCond;
+    long                    m_framesDecoded {0};
+    qint64                  m_decodeNSecs   {0};
+    qint64                  m_scaleNSecs    {0};
 };
 
 #endif
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
-
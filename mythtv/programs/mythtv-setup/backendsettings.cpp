@@ -342,6 +342,35 @@ static HostCheckBoxSetting *DisableFirewireReset()
     return hc;
 }
 
+static HostCheckBoxSetting *FastChannelChange()
+{
+    auto *hc = new HostCheckBoxSetting("FastChannelChange");
+    hc->setLabel(QObject::tr("Fast channel change"));
+    hc->setHelpText(
+        QObject::tr(
+            "If enabled, the program tables of each digital channel "
+            "are remembered when it is tuned, so the next change to "
+            "that channel can start recording as soon as the tuner "
+            "locks. Disable this if channel changes sometimes result "
+            "in missing audio or video."));
+    hc->setValue(false);
+    return hc;
+}
+
+static HostCheckBoxSetting *RecordingCaptions()
+{
+    auto *hc = new HostCheckBoxSetting("RecordingCaptions");
+    hc->setLabel(QObject::tr("Extract subtitles while recording"));
+    hc->setHelpText(
+        QObject::tr(
+            "If enabled, DVB teletext subtitles are decoded while a "
+            "recording is made on this backend. They are written to a "
+            "subtitle file next to the recording and their text is "
+            "indexed so recordings can be searched by what was said."));
+    hc->setValue(false);
+    return hc;
+}
+
 static HostTextEditSetting *MiscStatusScript()
 {
     auto *he = new HostTextEditSetting("MiscStatusScript");
@@ -580,12 +609,64 @@ static HostSpinBoxSetting *JobQueueCheckFrequency()
 {
     auto *gc = new HostSpinBoxSetting("JobQueueCheckFrequency", 5, 300, 5);
     gc->setLabel(QObject::tr("Job Queue check frequency (secs)"));
-    gc->setHelpText(QObject::tr("When looking for new jobs to process, the "
-                    "Job Queue will wait this many seconds between checks."));
+    gc->setHelpText(QObject::tr("Newly queued jobs are picked up right "
+                    "away. Deferred and scheduled jobs are looked at again "
+                    "after this many seconds."));
     gc->setValue(60);
     return gc;
 };
 
+static HostSpinBoxSetting *JobQueueMaxTranscodeJobs()
+{
+    auto *gc = new HostSpinBoxSetting("JobQueueMaxTranscodeJobs", 0, 10, 1);
+    gc->setLabel(QObject::tr("Maximum simultaneous transcodes"));
+    gc->setHelpText(QObject::tr("Limit the number of transcoding jobs "
+                    "running at the same time on this backend. "
+                    "0 means no limit other than the maximum number "
+                    "of simultaneous jobs."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostSpinBoxSetting *JobQueueMaxCommFlagJobs()
+{
+    auto *gc = new HostSpinBoxSetting("JobQueueMaxCommFlagJobs", 0, 10, 1);
+    gc->setLabel(QObject::tr("Maximum simultaneous commercial detections"));
+    gc->setHelpText(QObject::tr("Limit the number of commercial detection "
+                    "jobs running at the same time on this backend. "
+                    "0 means no limit other than the maximum number "
+                    "of simultaneous jobs."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostSpinBoxSetting *JobQueueMaxRecordings()
+{
+    auto *gc = new HostSpinBoxSetting("JobQueueMaxRecordings", 0, 32, 1);
+    gc->setLabel(QObject::tr("Defer jobs while recording"));
+    gc->setHelpText(QObject::tr("Jobs other than metadata lookups and "
+                    "preview generation will not be started while this "
+                    "many or more recordings are in progress on this "
+                    "backend. Jobs already running are not affected. "
+                    "0 disables this check."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostSpinBoxSetting *JobQueueMaxLoad()
+{
+    auto *gc = new HostSpinBoxSetting("JobQueueMaxLoad", 0, 400, 10);
+    gc->setLabel(QObject::tr("Maximum system load for new jobs (%)"));
+    gc->setHelpText(QObject::tr("Jobs other than metadata lookups and "
+                    "preview generation will not be started while the "
+                    "system load average is above this percentage of the "
+                    "number of CPUs. For example "
+                    "100 on a four core system defers jobs while the load "
+                    "is 4 or more. 0 disables this check."));
+    gc->setValue(0);
+    return gc;
+};
+
 static HostComboBoxSetting *JobQueueCPU()
 {
     auto *gc = new HostComboBoxSetting("JobQueueCPU");
@@ -620,6 +701,22 @@ static HostTimeBoxSetting *JobQueueWindowEnd()
     return gc;
 };
 
+static GlobalCheckBoxSetting *JobQueueWorkStealing()
+{
+    auto *gc = new GlobalCheckBoxSetting("JobQueueWorkStealing");
+    gc->setLabel(QObject::tr("Share jobs between backends"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, a backend with a free job slot "
+                                "will take over jobs queued for a backend "
+                                "which is already running its maximum number "
+                                "of jobs, or which has not started them for "
+                                "half an hour. Commercial detection reads "
+                                "the recording from the other backend, other "
+                                "jobs are only taken over when the recording "
+                                "is available locally."));
+    return gc;
+};
+
 static GlobalCheckBoxSetting *JobsRunOnRecordHost()
 {
     auto *gc = new GlobalCheckBoxSetting("JobsRunOnRecordHost");
@@ -938,6 +1035,8 @@ BackendSettings::BackendSettings()
     group2->addChild(MiscStatusScript());
     group2->addChild(DisableAutomaticBackup());
     group2->addChild(DisableFirewireReset());
+    group2->addChild(FastChannelChange());
+    group2->addChild(RecordingCaptions());
     addChild(group2);
 
     auto* group2a1 = new GroupSetting();
@@ -985,6 +1084,10 @@ BackendSettings::BackendSettings()
     auto* group5 = new GroupSetting();
     group5->setLabel(QObject::tr("Job Queue (Backend-Specific)"));
     group5->addChild(JobQueueMaxSimultaneousJobs());
+    group5->addChild(JobQueueMaxTranscodeJobs());
+    group5->addChild(JobQueueMaxCommFlagJobs());
+    group5->addChild(JobQueueMaxRecordings());
+    group5->addChild(JobQueueMaxLoad());
     group5->addChild(JobQueueCheckFrequency());
     group5->addChild(JobQueueWindowStart());
     group5->addChild(JobQueueWindowEnd());
@@ -1002,6 +1105,7 @@ BackendSettings::BackendSettings()
     auto* group6 = new GroupSetting();
     group6->setLabel(QObject::tr("Job Queue (Global)"));
     group6->addChild(JobsRunOnRecordHost());
+    group6->addChild(JobQueueWorkStealing());
     group6->addChild(AutoCommflagWhileRecording());
     group6->addChild(JobQueueCommFlagCommand());
     group6->addChild(JobQueueTranscodeCommand());
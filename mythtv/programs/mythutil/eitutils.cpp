@@ -129,6 +129,31 @@ static int ClearEIT(const MythUtilCommandLineParser &cmdline)
             MythDB::DBError("Delete program genre entries from EIT", query);
             result = GENERIC_EXIT_NOT_OK;
         }
+
+        // delete search terms for all channels that use EIT on sources that use EIT
+        sql = "DELETE FROM programterm WHERE chanid IN ("
+              "SELECT chanid FROM channel "
+              "WHERE deleted IS NULL AND "
+              "      useonairguide = 1 AND "
+              "      sourceid IN ("
+              "SELECT sourceid FROM videosource WHERE useeit=1";
+        if (-1 != sourceid)
+        {
+            sql += " AND sourceid = :SOURCEID";
+        }
+        sql += "));";
+        query.prepare(sql);
+        if (-1 != sourceid)
+        {
+            query.bindValue(":SOURCEID", sourceid);
+        }
+        LOG(VB_GENERAL, LOG_DEBUG,
+            QString("Deleting program search terms from EIT."));
+        if (!query.exec())
+        {
+            MythDB::DBError("Delete program search terms from EIT", query);
+            result = GENERIC_EXIT_NOT_OK;
+        }
     }
 
     return result;
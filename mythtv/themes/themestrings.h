@@ -1996,6 +1996,7 @@ void strings_null() {
     ThemeUI::tr("Types");
     ThemeUI::tr("Unable to connect to Database.");
     ThemeUI::tr("Unable to connect to master backend.");
+    ThemeUI::tr("Underruns :");
     ThemeUI::tr("Unique Player Command:");
     ThemeUI::tr("Unique Player:");
     ThemeUI::tr("Unknown");